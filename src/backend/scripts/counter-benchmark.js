@@ -0,0 +1,138 @@
+const { submitTransaction, evaluateTransaction, closeAll } = require("../src/services/fabric-gateway");
+
+// Committed counter increments per second under concurrent submitters.
+//
+//   node scripts/counter-benchmark.js --mode delta --submitters 16 --duration 60
+//
+// Modes:
+//   rmw    ReadMobility then UpdateMobility(Attempts + 1): one read-modify-write
+//          of the record per increment, as IncrementAttempts did before deltas
+//   delta  IncrementAttempts: one delta key per increment
+//
+// Every submitter targets the same few records (--records), so rmw transactions
+// collide and fail MVCC validation while delta transactions do not. Run from
+// src/backend so the wallet and connection profile are found.
+
+// Constants
+const DEFAULTS = {
+    mode: "delta",
+    contract: process.env.MOBILITY_CHAINCODE || "mobilitycc",
+    submitters: 16,
+    duration: 60,  // Seconds
+    records: 1,    // Hot records shared by all submitters
+    compact: true, // Run CompactCounters after a delta run
+};
+const MVCC_CONFLICT = /MVCC_READ_CONFLICT|PHANTOM_READ_CONFLICT/;
+
+const parseArgs = (argv) => {
+    const options = { ...DEFAULTS };
+    for (let i = 0; i < argv.length; i++) {
+        const value = argv[i + 1];
+        switch (argv[i]) {
+            case "--mode": options.mode = value; i++; break;
+            case "--contract": options.contract = value; i++; break;
+            case "--submitters": options.submitters = Number(value); i++; break;
+            case "--duration": options.duration = Number(value); i++; break;
+            case "--records": options.records = Number(value); i++; break;
+            case "--no-compact": options.compact = false; break;
+            default: throw new Error(`Unknown argument ${argv[i]}`);
+        }
+    }
+    if (!["rmw", "delta"].includes(options.mode)) {
+        throw new Error("--mode must be rmw or delta");
+    }
+    return options;
+};
+
+// Helper: Create the benchmark records if they do not exist yet
+const ensureRecords = async (options) => {
+    const rids = Array.from({ length: options.records }, (_, i) => `bench-${i}`);
+    for (const rid of rids) {
+        try {
+            await evaluateTransaction(options.contract, "ReadMobility", [rid]);
+        } catch (err) {
+            await submitTransaction(options.contract, "CreateMobility", [rid, "Bench Zone", "Allowed", "0", "0"]);
+        }
+    }
+    return rids;
+};
+
+const readAttempts = async (options, rid) =>
+    JSON.parse(await evaluateTransaction(options.contract, "ReadMobility", [rid])).Attempts;
+
+// Helper: One increment in the selected mode
+const increment = async (options, rid) => {
+    if (options.mode === "delta") {
+        await submitTransaction(options.contract, "IncrementAttempts", [rid]);
+        return;
+    }
+    const record = JSON.parse(await evaluateTransaction(options.contract, "ReadMobility", [rid]));
+    await submitTransaction(options.contract, "UpdateMobility", [
+        rid, record.Location, record.GeoFence, String(record.Attempts + 1), String(record.SecurityIncidents),
+    ]);
+};
+
+const main = async () => {
+    const options = parseArgs(process.argv.slice(2));
+    const rids = await ensureRecords(options);
+    const before = await Promise.all(rids.map((rid) => readAttempts(options, rid)));
+    const counts = { committed: 0, conflicts: 0, errors: 0 };
+    const deadline = Date.now() + options.duration * 1000;
+
+    console.log(`Running ${options.mode} with ${options.submitters} submitter(s) on ${rids.length} record(s) ` +
+        `for ${options.duration} s`);
+    const started = Date.now();
+
+    const submitter = async (index) => {
+        for (let n = index; Date.now() < deadline; n++) {
+            try {
+                await increment(options, rids[n % rids.length]);
+                counts.committed++;
+            } catch (err) {
+                if (MVCC_CONFLICT.test(err.message)) {
+                    counts.conflicts++;
+                } else {
+                    counts.errors++;
+                    console.error(`Increment failed: ${err.message}`);
+                }
+            }
+        }
+    };
+    await Promise.all(Array.from({ length: options.submitters }, (_, i) => submitter(i)));
+    const elapsed = (Date.now() - started) / 1000;
+
+    if (options.mode === "delta" && options.compact) {
+        for (const rid of rids) {
+            console.log(`Compacted ${rid}: ${await submitTransaction(options.contract, "CompactCounters", [rid])}`);
+        }
+    }
+
+    // The ledger must agree with the count of committed increments
+    const after = await Promise.all(rids.map((rid) => readAttempts(options, rid)));
+    const onLedger = after.reduce((sum, value, i) => sum + value - before[i], 0);
+    const attempted = counts.committed + counts.conflicts + counts.errors;
+
+    console.log(JSON.stringify({
+        mode: options.mode,
+        submitters: options.submitters,
+        records: rids.length,
+        seconds: Number(elapsed.toFixed(1)),
+        committed: counts.committed,
+        committedPerSecond: Number((counts.committed / elapsed).toFixed(2)),
+        conflictRate: attempted ? Number((counts.conflicts / attempted).toFixed(3)) : 0,
+        conflicts: counts.conflicts,
+        errors: counts.errors,
+        onLedger,
+    }));
+    if (onLedger !== counts.committed) {
+        console.error(`Ledger shows ${onLedger} increments but ${counts.committed} were committed`);
+        process.exitCode = 1;
+    }
+};
+
+main()
+    .catch((err) => {
+        console.error(`Benchmark failed: ${err.message}`);
+        process.exitCode = 1;
+    })
+    .finally(closeAll);
@@ -3,6 +3,7 @@ const dotenv = require("dotenv");
 const cors = require("cors");
 const bodyParser = require("body-parser");
 const apiRoutes = require("./routes/api.routes");
+const { closeAll: closeFabricConnections } = require("./services/fabric-gateway");
 const errorMiddleware = require("./middlewares/error.middleware");
 const loggerMiddleware = require("./middlewares/logger.middleware");
 
@@ -60,6 +61,7 @@ function setupGracefulShutdown(server) {
     const gracefulShutdown = (signal) => {
         console.log(`Received ${signal}. Shutting down server...`);
         server.close(() => {
+            closeFabricConnections();
             console.log("Server closed.");
             process.exit(0);
         });
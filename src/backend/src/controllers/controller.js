@@ -1,8 +1,6 @@
 const dotenv = require("dotenv");
 const fetch = require("node-fetch");
-const path = require("path");
-const { Gateway, Wallets } = require("fabric-network");
-const fs = require("fs");
+const { submitTransaction, evaluateTransaction, submitMany } = require("../services/fabric-gateway");
 
 // Load environment variables
 dotenv.config({ path: "./config.env" });
@@ -18,8 +16,6 @@ const API_KEYS = {
     network: process.env.API_KEY_NETWORK,
 };
 const API_URI = process.env.API_URI || "http://localhost:3000/api/assets";
-const WALLET_PATH = path.join(process.cwd(), "wallet");
-const CCP_PATH = path.resolve(__dirname, "..", "fabric-config", "connection.json");
 
 // Helper: Validate required fields in the request
 const validateRequiredFields = (obj, requiredFields) => {
@@ -30,28 +26,6 @@ const validateRequiredFields = (obj, requiredFields) => {
     return null;
 };
 
-// Helper function to connect to the blockchain, submit transactions, and disconnect
-const submitTransaction = async (contractName, methodName, args, identity = "admin") => {
-    const ccp = JSON.parse(fs.readFileSync(CCP_PATH, "utf8"));
-    const wallet = await Wallets.newFileSystemWallet(WALLET_PATH);
-    const gateway = new Gateway();
-
-    await gateway.connect(ccp, {
-        wallet,
-        identity, // Identity as a parameter for flexibility
-        discovery: { enabled: true, asLocalhost: true },
-    });
-
-    try {
-        const network = await gateway.getNetwork("mychannel"); // Replace 'mychannel' with your channel name
-        const contract = network.getContract(contractName);
-        const result = await contract.submitTransaction(methodName, ...args);
-        return result.toString();
-    } finally {
-        gateway.disconnect();
-    }
-};
-
 // Reusable function for API interactions
 const handleRequest = async (orgKey, req, res) => {
     if (!API_KEYS[orgKey]) {
@@ -120,7 +94,7 @@ exports.handleIntegrityRead = async (req, res) => {
     if (!RID) return res.status(400).json({ error: "Missing RID parameter" });
 
     try {
-        const result = await submitTransaction("IntegrityContract", "ReadIntegrityRecord", [RID]);
+        const result = await evaluateTransaction("IntegrityContract", "ReadIntegrityRecord", [RID]);
         res.status(200).json(JSON.parse(result));
     } catch (err) {
         console.error("Error reading integrity record:", err);
@@ -149,7 +123,7 @@ exports.handleIntegrityIncrementTampering = async (req, res) => {
 
 exports.handleIntegrityGetAll = async (req, res) => {
     try {
-        const result = await submitTransaction("IntegrityContract", "GetAllIntegrityRecords", []);
+        const result = await evaluateTransaction("IntegrityContract", "GetAllIntegrityRecords", []);
         res.status(200).json(JSON.parse(result));
     } catch (err) {
         console.error("Error retrieving all integrity records:", err);
@@ -164,12 +138,39 @@ exports.handleNetworkCreate = (req, res) =>
         ({ RID, Latency, PacketLoss, Bandwidth }) => [RID, Latency.toString(), PacketLoss.toString(), Bandwidth.toString()]
     );
 
+// Create many records in one request; endorsements run concurrently over the shared connection
+exports.handleNetworkCreateMany = async (req, res) => {
+    const records = req.body && req.body.records;
+    if (!Array.isArray(records) || records.length === 0) {
+        return res.status(400).json({ error: "Missing records array" });
+    }
+
+    for (const [index, record] of records.entries()) {
+        const validationError = validateRequiredFields(record, ["RID", "Latency", "PacketLoss", "Bandwidth"]);
+        if (validationError) {
+            return res.status(400).json({ error: `Record ${index}: ${validationError}` });
+        }
+    }
+
+    try {
+        const results = await submitMany("NetworkContract", records.map(({ RID, Latency, PacketLoss, Bandwidth }) => ({
+            method: "CreateNetworkRecord",
+            args: [RID, Latency.toString(), PacketLoss.toString(), Bandwidth.toString()],
+        })));
+        const failed = results.filter((result) => result.status === "rejected").length;
+        res.status(failed === 0 ? 200 : 207).json({ message: `${records.length - failed} of ${records.length} records created`, results });
+    } catch (err) {
+        console.error("Error creating network records:", err);
+        res.status(500).json({ error: "Failed to create network records", details: err.message });
+    }
+};
+
 exports.handleNetworkRead = async (req, res) => {
     const { RID } = req.params;
     if (!RID) return res.status(400).json({ error: "Missing RID parameter" });
 
     try {
-        const result = await submitTransaction("NetworkContract", "ReadNetworkRecord", [RID]);
+        const result = await evaluateTransaction("NetworkContract", "ReadNetworkRecord", [RID]);
         res.status(200).json(JSON.parse(result));
     } catch (err) {
         console.error("Error reading network record:", err);
@@ -198,7 +199,7 @@ exports.handleNetworkDelete = async (req, res) => {
 
 exports.handleNetworkGetAll = async (req, res) => {
     try {
-        const result = await submitTransaction("NetworkContract", "GetAllNetworkRecords", []);
+        const result = await evaluateTransaction("NetworkContract", "GetAllNetworkRecords", []);
         res.status(200).json(JSON.parse(result));
     } catch (err) {
         console.error("Error retrieving network records:", err);
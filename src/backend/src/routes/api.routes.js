@@ -16,11 +16,13 @@ const {
   handleTransactions,
   handleSimulationData,
   handleNetworkCreate,
+  handleNetworkCreateMany,
   handleNetworkRead,
   handleNetworkUpdate,
   handleNetworkDelete,
   handleNetworkGetAll,
 } = require("../controllers/controller");
+const { gatewayHealth } = require("../services/fabric-gateway");
 
 // Define constants for component handlers
 const AVAILABLE_COMPONENTS = [getComp1, getComp2, getComp3, getComp4, getComp5];
@@ -82,6 +84,9 @@ router.post("/simulation", handleSimulationData);
 router.post("/network/create", (req, res) => {
   handleRequest(handleNetworkCreate, req, res, "Error creating network record.");
 });
+router.post("/network/createMany", (req, res) => {
+  handleRequest(handleNetworkCreateMany, req, res, "Error creating network records.");
+});
 router.get("/network/read/:RID", (req, res) => {
   handleRequest(
       handleNetworkRead,
@@ -110,6 +115,7 @@ router.get("/api/health", (req, res) => {
   const componentEndpoints = AVAILABLE_COMPONENTS.map((_, index) => `/components/comp${index + 1}`);
   const networkEndpoints = [
     "/network/create",
+    "/network/createMany",
     "/network/read/:RID",
     "/network/update",
     "/network/delete/:RID",
@@ -137,6 +143,7 @@ router.get("/api/health", (req, res) => {
     status: "success",
     message: "API is up and running!",
     timestamp: new Date().toISOString(),
+    fabric: gatewayHealth(),
     availableEndpoints,
   });
 });
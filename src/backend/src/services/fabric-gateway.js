@@ -0,0 +1,250 @@
+const fs = require("fs/promises");
+const path = require("path");
+const { Gateway, Wallets } = require("fabric-network");
+
+// Long-lived Fabric connections for the controllers.
+//
+// One Gateway is opened per identity and kept for the life of the process;
+// networks and contracts are cached per channel. A periodic health check
+// evaluates each cached contract's metadata, and a connection that fails is
+// closed and reopened with exponential backoff. Queries that fail with a
+// connection error are retried once on a fresh gateway. Submits are retried
+// only when the error shows the transaction never reached the orderer: a
+// timeout can arrive after the orderer accepted it, and a retry would apply
+// IncrementAttempts or a create twice.
+
+// Constants
+const WALLET_PATH = path.join(process.cwd(), "wallet");
+const CCP_PATH = path.resolve(__dirname, "..", "fabric-config", "connection.json");
+const DEFAULT_CHANNEL = process.env.FABRIC_CHANNEL || "mychannel";
+const DEFAULT_IDENTITY = "admin";
+const HEALTH_CHECK_INTERVAL_MS = 30000;
+const RECONNECT_BASE_MS = 1000;
+const RECONNECT_MAX_MS = 30000;
+const SUBMIT_MANY_CONCURRENCY = 16; // Endorsements in flight per submitMany call
+
+// Errors that mean the gateway itself is unusable, not that the chaincode refused
+const CONNECTION_ERRORS = /UNAVAILABLE|DEADLINE_EXCEEDED|failed to connect|No valid responses from any peers|Gateway is not connected|DiscoveryService/i;
+// Connection errors raised before a submit was endorsed, so nothing was ordered
+const UNSENT_ERRORS = /failed to connect|No valid responses from any peers|Gateway is not connected|DiscoveryService/i;
+
+let connectionProfile = null; // Parsed connection.json, read once
+let wallet = null;
+const connections = new Map(); // identity -> connection state
+let healthTimer = null;
+let checking = false;
+
+// Helper: Load the connection profile and wallet once, without blocking the event loop
+const loadConfig = async () => {
+    if (!connectionProfile) {
+        connectionProfile = JSON.parse(await fs.readFile(CCP_PATH, "utf8"));
+    }
+    if (!wallet) {
+        wallet = await Wallets.newFileSystemWallet(WALLET_PATH);
+    }
+};
+
+const isConnectionError = (err) => CONNECTION_ERRORS.test(err && err.message);
+
+const isRetryable = (kind, err) => kind === "evaluateTransaction" || UNSENT_ERRORS.test(err.message);
+
+// Helper: Open a gateway for one identity
+const connect = async (identity) => {
+    await loadConfig();
+    const gateway = new Gateway();
+    await gateway.connect(connectionProfile, {
+        wallet,
+        identity,
+        discovery: { enabled: true, asLocalhost: true },
+    });
+    return gateway;
+};
+
+// Helper: Connection state for an identity, opening the gateway on first use
+const getConnection = (identity) => {
+    let state = connections.get(identity);
+    if (!state) {
+        state = {
+            identity,
+            gateway: null,
+            ready: null,          // Promise of the connected gateway
+            contracts: new Map(), // "channel/contract" -> Contract
+            reconnects: 0,
+            retryDelay: RECONNECT_BASE_MS,
+            lastError: null,
+            lastCheck: null,
+        };
+        connections.set(identity, state);
+        startHealthChecks();
+    }
+    if (!state.ready) {
+        state.ready = connect(identity).then((gateway) => {
+            state.gateway = gateway;
+            state.retryDelay = RECONNECT_BASE_MS;
+            state.lastError = null;
+            return gateway;
+        }).catch((err) => {
+            state.ready = null;
+            state.lastError = err.message;
+            throw err;
+        });
+    }
+    return state;
+};
+
+// Helper: Drop a broken gateway; the next call or health check reconnects.
+// gateway is the one the failed call used: when calls that failed together
+// report it, only the first resets, and a gateway reopened since is kept.
+const resetConnection = (state, err, gateway) => {
+    if (!gateway || state.gateway !== gateway) {
+        return;
+    }
+    gateway.disconnect();
+    state.gateway = null;
+    state.ready = null;
+    state.contracts.clear();
+    state.lastError = err.message;
+    state.reconnects++;
+    console.error(`[Fabric] Connection for ${state.identity} reset: ${err.message}`);
+};
+
+// Helper: Cached contract with its connection state and gateway, connecting if needed
+const openContract = async (contractName, { identity = DEFAULT_IDENTITY, channel = DEFAULT_CHANNEL } = {}) => {
+    const state = getConnection(identity);
+    const gateway = await state.ready;
+    const key = `${channel}/${contractName}`;
+
+    if (state.gateway !== gateway || !state.contracts.has(key)) {
+        const network = await gateway.getNetwork(channel);
+        const contract = network.getContract(contractName);
+        if (state.gateway === gateway) {
+            state.contracts.set(key, contract);
+        }
+        return { state, gateway, contract };
+    }
+    return { state, gateway, contract: state.contracts.get(key) };
+};
+
+// Get a cached contract, connecting if needed
+const getContract = async (contractName, options) => (await openContract(contractName, options)).contract;
+
+// Helper: Run one transaction. After a connection error the gateway is reset,
+// and the transaction is retried once on a fresh one if that cannot apply it twice.
+const run = async (kind, contractName, methodName, args, options = {}) => {
+    for (let attempt = 1; ; attempt++) {
+        const { state, gateway, contract } = await openContract(contractName, options);
+        try {
+            const result = await contract[kind](methodName, ...args);
+            return result.toString();
+        } catch (err) {
+            if (!isConnectionError(err)) {
+                throw err;
+            }
+            resetConnection(state, err, gateway);
+            if (attempt > 1 || !isRetryable(kind, err)) {
+                throw err;
+            }
+        }
+    }
+};
+
+// Submit a transaction for endorsement and ordering
+const submitTransaction = (contractName, methodName, args, options) =>
+    run("submitTransaction", contractName, methodName, args, options);
+
+// Query a peer without ordering
+const evaluateTransaction = (contractName, methodName, args, options) =>
+    run("evaluateTransaction", contractName, methodName, args, options);
+
+// Submit many transactions over one connection, several endorsements at a time.
+// Resolves to one { status, result | error } entry per call, in order.
+const submitMany = async (contractName, calls, options = {}) => {
+    const concurrency = options.concurrency || SUBMIT_MANY_CONCURRENCY;
+    const results = new Array(calls.length);
+    let next = 0;
+
+    const worker = async () => {
+        while (next < calls.length) {
+            const index = next++;
+            const { method, args } = calls[index];
+            try {
+                results[index] = { status: "fulfilled", result: await submitTransaction(contractName, method, args, options) };
+            } catch (err) {
+                results[index] = { status: "rejected", error: err.message };
+            }
+        }
+    };
+
+    await Promise.all(Array.from({ length: Math.min(concurrency, calls.length) }, worker));
+    return results;
+};
+
+// Helper: Check every connection, reconnecting broken ones with backoff
+const checkHealth = async () => {
+    for (const state of connections.values()) {
+        let gateway = null;
+        state.lastCheck = new Date().toISOString();
+        try {
+            if (!state.ready) {
+                await new Promise((resolve) => setTimeout(resolve, state.retryDelay));
+                state.retryDelay = Math.min(state.retryDelay * 2, RECONNECT_MAX_MS);
+                getConnection(state.identity);
+            }
+            gateway = await state.ready;
+            const [contract] = state.contracts.values();
+            if (contract) {
+                await contract.evaluateTransaction("org.hyperledger.fabric:GetMetadata");
+            }
+        } catch (err) {
+            if (state.ready && isConnectionError(err)) {
+                resetConnection(state, err, gateway);
+            } else {
+                state.lastError = err.message;
+            }
+        }
+    }
+};
+
+const startHealthChecks = () => {
+    if (!healthTimer) {
+        healthTimer = setInterval(() => {
+            if (!checking) {
+                checking = true;
+                checkHealth().finally(() => { checking = false; });
+            }
+        }, HEALTH_CHECK_INTERVAL_MS);
+        healthTimer.unref();
+    }
+};
+
+// Connection summary for the health endpoint
+const gatewayHealth = () =>
+    Array.from(connections.values()).map((state) => ({
+        identity: state.identity,
+        connected: Boolean(state.gateway),
+        contracts: Array.from(state.contracts.keys()),
+        reconnects: state.reconnects,
+        lastCheck: state.lastCheck,
+        lastError: state.lastError,
+    }));
+
+// Disconnect everything, e.g. on shutdown
+const closeAll = () => {
+    clearInterval(healthTimer);
+    healthTimer = null;
+    for (const state of connections.values()) {
+        if (state.gateway) {
+            state.gateway.disconnect();
+        }
+    }
+    connections.clear();
+};
+
+module.exports = {
+    getContract,
+    submitTransaction,
+    evaluateTransaction,
+    submitMany,
+    gatewayHealth,
+    closeAll,
+};
@@ -0,0 +1,63 @@
+import { useEffect, useState } from "react";
+
+/**
+ * Live sensor view from the REST gateway (server-sent events).
+ * The gateway follows block events and pushes only what changed, so open
+ * dashboards no longer query the peers on a timer.
+ */
+const STREAM_URL = process.env.REACT_APP_SENSOR_STREAM_URL || "http://localhost:3000/api/sensors/stream";
+const API_KEY = process.env.REACT_APP_API_KEY || "";
+
+/**
+ * Merge one block's changes for a sensor into the view
+ * @param {object} view - { [sensor]: { records, readings } }
+ * @param {object} delta - { sensor, upserts, deletes, readings }
+ * @returns {object} - The updated view
+ */
+const applyDelta = (view, { sensor, upserts, deletes, readings }) => {
+    const current = view[sensor] || { records: {}, readings: [] };
+    const records = { ...current.records, ...upserts };
+    deletes.forEach((key) => delete records[key]);
+    return {
+        ...view,
+        [sensor]: { records, readings: current.readings.concat(readings).slice(-500) },
+    };
+};
+
+/**
+ * Subscribe to the sensor stream
+ * @param {string[]} sensors - Sensor types to follow (all when omitted)
+ * @returns {{view: object, status: string}} - view is { [sensor]: { records, readings } };
+ *          status is "connecting", "open" or "reconnecting"
+ */
+export const useSensorStream = (sensors) => {
+    const [view, setView] = useState(null);
+    const [status, setStatus] = useState("connecting");
+    const sensorList = sensors ? sensors.join(",") : "";
+
+    useEffect(() => {
+        const params = new URLSearchParams({ apiKey: API_KEY });
+        if (sensorList) {
+            params.set("sensors", sensorList);
+        }
+
+        // EventSource reconnects by itself; every connection starts with a fresh snapshot
+        const source = new EventSource(`${STREAM_URL}?${params}`);
+        source.onopen = () => setStatus("open");
+        source.onerror = () => setStatus("reconnecting");
+        source.addEventListener("snapshot", (event) => setView(JSON.parse(event.data).sensors));
+        source.addEventListener("delta", (event) => {
+            const delta = JSON.parse(event.data);
+            setView((previous) => applyDelta(previous || {}, delta));
+        });
+
+        return () => source.close();
+    }, [sensorList]);
+
+    return { view, status };
+};
+
+/**
+ * Records of one sensor type as an array
+ */
+export const sensorRecords = (view, sensor) => Object.values(view?.[sensor]?.records || {});
@@ -1,9 +1,9 @@
-import React, { useState, useEffect, memo } from "react";
+import React, { memo } from "react";
 import PropTypes from "prop-types";
 import BarChart from "../components/Charts/BarChart";
 import LineChart from "../components/Charts/LineChart";
 import ScatterChart from "../components/Charts/ScatterChart";
-import { fetchSensorData } from "../api/api"; // Centralized API utilities
+import { useSensorStream, sensorRecords } from "../api/sensorStream"; // Live view pushed by the gateway
 
 // Define the 5 sensors and their respective configurations
 const SENSOR_ENDPOINTS = [
@@ -22,33 +22,10 @@ const ChartComponents = {
 };
 
 const Dashboard = () => {
-  const [sensorData, setSensorData] = useState({});
-  const [loading, setLoading] = useState(true);
-  const [error, setError] = useState(null);
-
-  // Fetch all 5 sensors' data from the backend
-  useEffect(() => {
-    const fetchAllSensorData = async () => {
-      try {
-        setLoading(true);
-        const fetchedData = {};
-        await Promise.all(
-            SENSOR_ENDPOINTS.map(async ({ key, endpoint }) => {
-              const data = await fetchSensorData(endpoint);
-              fetchedData[key] = data; // Store data using the key (e.g., 'integrity')
-            })
-        );
-        setSensorData(fetchedData); // Save the data for rendering
-      } catch (err) {
-        console.error("Failed to load sensor data:", err.message);
-        setError("Failed to load sensor data. Please check your backend or connection.");
-      } finally {
-        setLoading(false);
-      }
-    };
-
-    fetchAllSensorData();
-  }, []);
+  // One stream for all 5 sensors instead of one request per endpoint
+  const { view, status } = useSensorStream();
+  const loading = !view && status !== "reconnecting";
+  const error = !view && status === "reconnecting" ? "Failed to load sensor data. Please check your backend or connection." : null;
 
   // If loading or error, display appropriate messages
   if (loading) return <div>Loading sensor data...</div>;
@@ -63,7 +40,7 @@ const Dashboard = () => {
             return (
                 <div key={index} className="chart-container">
                   <h2>{title}</h2>
-                  <ChartComponent data={sensorData[key]} />
+                  <ChartComponent data={sensorRecords(view, key)} />
                 </div>
             );
           })}
@@ -19,6 +19,8 @@ async function main() {
     const app = await initializeRestServer();
     const network = await initializeBlockchainConnection();
     await initializeContracts(network, app);
+    await initializeSensorView(network, app);
+    await initializeReadCache(network, app);
     await initializeJobQueue(app);
     startServer(app);
   } catch (error) {
@@ -83,15 +85,36 @@ async function initializeContracts(network: any, app: any) {
   }
 }
 
+async function initializeSensorView(network: any, app: any) {
+  try {
+    logger.info('Loading sensor view and subscribing to block events');
+    app.locals.sensorView = await createSensorView(network, app.locals);
+  } catch (error) {
+    logger.error('Failed to initialize sensor view', {error});
+    throw error;
+  }
+}
+
+async function initializeReadCache(network: any, app: any) {
+  try {
+    logger.info('Initializing block-invalidated read cache');
+    app.locals.readCache = await createReadCache(network);
+  } catch (error) {
+    logger.error('Failed to initialize read cache', {error});
+    throw error;
+  }
+}
+
 async function initializeJobQueue(app: any) {
   try {
-    logger.info('Initializing job queue');
-    app.locals.jobq = initJobQueue();
+    logger.info('Initializing job queues, one fresh and one retry queue per chaincode');
+    jobQueue = initJobQueue(chaincodes);
+    app.locals.jobq = jobQueue;
     jobQueueWorker = initJobQueueWorker(app);
 
     if (config.submitJobQueueScheduler) {
-      logger.info('Initializing job queue scheduler');
-      jobQueueScheduler = initJobQueueScheduler();
+      logger.info('Initializing job queue schedulers');
+      jobQueueScheduler = initJobQueueScheduler(jobQueue);
     }
   } catch (error) {
     logger.error('Failed to initialize job queue system', {error});
@@ -108,16 +131,16 @@ function startServer(app: any) {
 
 async function cleanUp() {
   if (jobQueueScheduler) {
-    logger.debug('Closing job queue scheduler');
-    await jobQueueScheduler.close();
+    logger.debug('Closing job queue schedulers');
+    await Promise.all(jobQueueScheduler.map((scheduler) => scheduler.close()));
   }
   if (jobQueueWorker) {
-    logger.debug('Closing job queue worker');
-    await jobQueueWorker.close();
+    logger.debug('Closing job queue workers');
+    await Promise.all(jobQueueWorker.map((worker) => worker.close()));
   }
   if (jobQueue) {
-    logger.debug('Closing job queue');
-    await jobQueue.close();
+    logger.debug('Closing job queues');
+    await Promise.all([...jobQueue.values()].flatMap(({fresh, retry}) => [fresh.close(), retry.close()]));
   }
 }
 
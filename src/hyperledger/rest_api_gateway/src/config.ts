@@ -103,4 +103,60 @@ export const privateKeySensorsOrg = env.get('HLF_PRIVATE_KEY_SENSORS_ORG').requi
 export const redisHost = env.get('REDIS_HOST').default('localhost').asString();
 export const redisPort = env.get('REDIS_PORT').default('6379').asPortNumber();
 export const redisUsername = env.get('REDIS_USERNAME').asString();
-export const redisPassword = env.get('REDIS_PASSWORD').asString();
\ No newline at end of file
+export const redisPassword = env.get('REDIS_PASSWORD').asString();
+/**
+ * Maximum number of query results kept by the block-invalidated read cache
+ */
+export const readCacheMaxEntries = env.get('READ_CACHE_MAX_ENTRIES').default('5000').asIntPositive();
+
+/**
+ * Seconds a cached query result is served before it is read again from a peer,
+ * even if no block has invalidated it; 0 keeps results until a block does
+ */
+export const readCacheTtl = env.get('READ_CACHE_TTL').default('300').asInt();
+
+// Submit Job Queues
+/**
+ * Number of times a submit job is attempted, including the first, before it fails
+ */
+export const submissionJobAttempts = env.get('SUBMIT_JOB_ATTEMPTS').default('5').asIntPositive();
+
+/**
+ * Backoff strategy between submit job retries
+ */
+export const submissionJobBackoffType = env
+    .get('SUBMIT_JOB_BACKOFF_TYPE')
+    .default('fixed')
+    .asEnum(['fixed', 'exponential']);
+
+/**
+ * Backoff delay in milliseconds between submit job retries
+ */
+export const submissionJobBackoffDelay = env.get('SUBMIT_JOB_BACKOFF_DELAY').default('3000').asIntPositive();
+
+/**
+ * Number of completed and failed submit jobs kept in Redis, per queue
+ */
+export const maxCompletedSubmitJobs = env.get('MAX_COMPLETED_SUBMIT_JOBS').default('1000').asIntPositive();
+export const maxFailedSubmitJobs = env.get('MAX_FAILED_SUBMIT_JOBS').default('1000').asIntPositive();
+
+/**
+ * Concurrent submissions per chaincode worker pool. SUBMIT_JOB_CONCURRENCY_<CHAINCODE>
+ * (e.g. SUBMIT_JOB_CONCURRENCY_SECURITYCC) overrides it for one chaincode.
+ */
+export const submissionJobConcurrency = env.get('SUBMIT_JOB_CONCURRENCY').default('4').asIntPositive();
+
+export const submissionJobConcurrencyFor = (chaincode: string): number => env
+    .get(`SUBMIT_JOB_CONCURRENCY_${chaincode.toUpperCase()}`)
+    .default(String(submissionJobConcurrency))
+    .asIntPositive();
+
+/**
+ * Concurrent retries per chaincode; retries run in their own pool so they never hold fresh work back
+ */
+export const retryJobConcurrency = env.get('SUBMIT_RETRY_JOB_CONCURRENCY').default('1').asIntPositive();
+
+/**
+ * Whether to run the queue schedulers that move delayed and stalled jobs back into their queues
+ */
+export const submitJobQueueScheduler = env.get('SUBMIT_JOB_QUEUE_SCHEDULER').default('true').asBoolStrict();
@@ -8,8 +8,8 @@ import { getReasonPhrase, StatusCodes } from 'http-status-codes';
 import { getBlockHeight } from './fabric';
 import { logger } from './logger';
 import * as config from './config';
-import { Queue } from 'bullmq';
-import { getJobCounts } from './jobs';
+import { getJobCounts, getLatencyHistograms, SubmitQueues } from './jobs';
+import { ReadCache } from './read-cache.service';
 
 const { SERVICE_UNAVAILABLE, OK } = StatusCodes;
 
@@ -32,7 +32,7 @@ healthRouter.get('/live', async (req: Request, res: Response) => {
   logger.debug(req.body, 'Liveness request received');
 
   try {
-    const submitQueue = req.app.locals.jobq as Queue;
+    const submitQueues = req.app.locals.jobq as SubmitQueues;
 
     // Fetch contracts from all organizations
     const qsccContracts: Contract[] = [
@@ -47,7 +47,7 @@ healthRouter.get('/live', async (req: Request, res: Response) => {
     // Run checks for all organizations
     await Promise.all([
       ...qsccContracts.map((contract) => getBlockHeight(contract)),
-      getJobCounts(submitQueue),
+      getJobCounts(submitQueues),
     ]);
   } catch (err) {
     logger.error({ err }, 'Error processing liveness request');
@@ -62,4 +62,28 @@ healthRouter.get('/live', async (req: Request, res: Response) => {
     status: getReasonPhrase(OK),
     timestamp: new Date().toISOString(),
   });
-});
\ No newline at end of file
+});
+
+/*
+ * Metrics - Read cache hit and miss counts, submit queue depths per
+ * chaincode, and queue wait and submit latency histograms per lane.
+ */
+healthRouter.get('/metrics', async (req: Request, res: Response) => {
+  const readCache = req.app.locals.readCache as ReadCache | undefined;
+  const submitQueues = req.app.locals.jobq as SubmitQueues | undefined;
+
+  try {
+    res.status(OK).json({
+      readCache: readCache ? readCache.stats() : null,
+      submitQueues: submitQueues ? await getJobCounts(submitQueues) : null,
+      submitLatency: getLatencyHistograms(),
+      timestamp: new Date().toISOString(),
+    });
+  } catch (err) {
+    logger.error({ err }, 'Error processing metrics request');
+    res.status(SERVICE_UNAVAILABLE).json({
+      status: getReasonPhrase(SERVICE_UNAVAILABLE),
+      timestamp: new Date().toISOString(),
+    });
+  }
+});
@@ -0,0 +1,459 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Transaction submissions are queued in Redis with BullMQ and processed by
+ * one worker pool per chaincode, so a backlog on one chaincode does not delay
+ * the others and each pool's concurrency can be tuned on its own.
+ *
+ * Within a chaincode's queue, jobs are ordered by lane (BullMQ priority):
+ * breach and threat flags go first, bulk telemetry goes last. A job that
+ * fails with a retryable error is moved to the chaincode's retry queue, which
+ * has its own small worker pool and BullMQ's backoff. A retry waiting for a
+ * commit timeout therefore never takes a slot from fresh work. The job ID
+ * stays the same, so its summary can be looked up in either queue.
+ */
+
+import { randomUUID } from 'crypto';
+import { ConnectionOptions, Job, Queue, QueueScheduler, Worker } from 'bullmq';
+import { Application } from 'express';
+import { Contract, Transaction } from 'fabric-network';
+import * as config from './config';
+import { getRetryAction, RetryAction } from './errors';
+import { submitTransaction } from './fabric';
+import { logger } from './logger';
+
+/**
+ * Submission lanes, used as BullMQ job priorities (lower runs first).
+ */
+export enum Lane {
+  Urgent = 1,
+  Normal = 2,
+  Bulk = 3,
+}
+
+export type JobData = {
+  contract: string; // app.locals contract name
+  transactionName: string;
+  transactionArgs: string[];
+  transactionState?: Buffer;
+  transactionIds: string[];
+  lane: Lane;
+  enqueuedAt: number;
+};
+
+export type JobResult = {
+  transactionPayload?: Buffer;
+  transactionError?: string;
+  retried?: boolean; // Handed over to the retry queue
+};
+
+export type JobSummary = {
+  jobId: string;
+  transactionIds: string[];
+  transactionPayload?: string;
+  transactionError?: string;
+};
+
+export class JobNotFoundError extends Error {
+  jobId: string;
+
+  constructor(message: string, jobId: string) {
+    super(message);
+    Object.setPrototypeOf(this, JobNotFoundError.prototype);
+
+    this.name = 'JobNotFoundError';
+    this.jobId = jobId;
+  }
+}
+
+/**
+ * The fresh and retry queues of one chaincode.
+ */
+export type ChaincodeQueues = {
+  chaincode: string;
+  contract: string;
+  fresh: Queue<JobData, JobResult>;
+  retry: Queue<JobData, JobResult>;
+};
+
+export type SubmitQueues = Map<string, ChaincodeQueues>;
+
+const connection: ConnectionOptions = {
+  port: config.redisPort,
+  host: config.redisHost,
+  username: config.redisUsername,
+  password: config.redisPassword,
+};
+
+const queueNames = (chaincode: string) => ({
+  fresh: `${config.JOB_QUEUE_NAME}-${chaincode}`,
+  retry: `${config.JOB_QUEUE_NAME}-${chaincode}-retry`,
+});
+
+/**
+ * Create the fresh and retry queues of every chaincode.
+ */
+export const initJobQueue = (chaincodes: { contract: string; name: string }[]): SubmitQueues => {
+  const queues: SubmitQueues = new Map();
+  const removeOptions = {
+    removeOnComplete: config.maxCompletedSubmitJobs,
+    removeOnFail: config.maxFailedSubmitJobs,
+  };
+
+  for (const { contract: chaincode, name } of chaincodes) {
+    const names = queueNames(chaincode);
+    queues.set(chaincode, {
+      chaincode,
+      contract: name,
+      // Fresh jobs get one attempt; retryable failures move to the retry queue
+      fresh: new Queue(names.fresh, { connection, defaultJobOptions: { attempts: 1, ...removeOptions } }),
+      retry: new Queue(names.retry, {
+        connection,
+        defaultJobOptions: {
+          attempts: Math.max(config.submissionJobAttempts - 1, 1),
+          backoff: { type: config.submissionJobBackoffType, delay: config.submissionJobBackoffDelay },
+          ...removeOptions,
+        },
+      }),
+    });
+  }
+
+  return queues;
+};
+
+/**
+ * Start a fresh and a retry worker pool for every chaincode.
+ */
+export const initJobQueueWorker = (app: Application): Worker[] => {
+  const queues = app.locals.jobq as SubmitQueues;
+  const workers: Worker[] = [];
+
+  for (const queue of queues.values()) {
+    const names = queueNames(queue.chaincode);
+    workers.push(
+        createWorker(names.fresh, config.submissionJobConcurrencyFor(queue.chaincode),
+            (job) => processSubmitTransactionJob(app, queue, job)),
+        createWorker(names.retry, config.retryJobConcurrency,
+            (job) => processSubmitTransactionJob(app, queue, job))
+    );
+    logger.info(
+        { chaincode: queue.chaincode, concurrency: config.submissionJobConcurrencyFor(queue.chaincode) },
+        'Submit worker pool started'
+    );
+  }
+
+  return workers;
+};
+
+const createWorker = (
+    name: string,
+    concurrency: number,
+    processor: (job: Job<JobData, JobResult>) => Promise<JobResult>
+): Worker => {
+  const worker = new Worker<JobData, JobResult>(name, processor, { connection, concurrency });
+
+  worker.on('failed', (job) => {
+    logger.warn({ job }, 'Job failed');
+  });
+
+  // Important: need to handle this error otherwise worker may stop
+  // processing jobs
+  worker.on('error', (err) => {
+    logger.error({ err }, 'Worker error');
+  });
+
+  if (logger.isLevelEnabled('debug')) {
+    worker.on('completed', (job) => {
+      logger.debug({ job }, 'Job completed');
+    });
+  }
+
+  return worker;
+};
+
+/**
+ * Run the queue schedulers that promote delayed retries and recover stalled jobs.
+ */
+export const initJobQueueScheduler = (queues: SubmitQueues): QueueScheduler[] => {
+  const schedulers: QueueScheduler[] = [];
+
+  for (const { chaincode } of queues.values()) {
+    for (const name of Object.values(queueNames(chaincode))) {
+      const queueScheduler = new QueueScheduler(name, { connection });
+      queueScheduler.on('failed', (jobId, failedReason) => {
+        logger.error({ jobId, failedReason }, 'Queue scheduler failure');
+      });
+      schedulers.push(queueScheduler);
+    }
+  }
+
+  return schedulers;
+};
+
+export const processSubmitTransactionJob = async (
+    app: Application,
+    queue: ChaincodeQueues,
+    job: Job<JobData, JobResult>
+): Promise<JobResult> => {
+  logger.debug({ jobId: job.id, jobName: job.name }, 'Processing job');
+  const isRetry = job.queueName !== queueNames(queue.chaincode).fresh;
+  const startedAt = Date.now();
+  recordLatency(submitWaits, queue.chaincode, job.data.lane, startedAt - job.timestamp - (job.opts.delay ?? 0));
+
+  const contract = app.locals[job.data.contract]?.assetContract as Contract;
+  if (contract === undefined) {
+    logger.error(
+        { jobId: job.id, jobName: job.name },
+        'Contract %s not found',
+        job.data.contract
+    );
+
+    // Retrying will never work without a contract, so give up with an
+    // empty job result
+    return {
+      transactionError: undefined,
+      transactionPayload: undefined,
+    };
+  }
+
+  let transaction: Transaction;
+  if (job.data.transactionState) {
+    logger.debug({ jobId: job.id, jobName: job.name }, 'Reusing previously saved transaction state');
+    transaction = contract.deserializeTransaction(job.data.transactionState);
+  } else {
+    transaction = contract.createTransaction(job.data.transactionName);
+    await updateJobData(job, transaction);
+  }
+
+  try {
+    const payload = await submitTransaction(transaction, ...job.data.transactionArgs);
+    const committedAt = Date.now();
+    recordLatency(submitLatencies, queue.chaincode, job.data.lane, committedAt - job.data.enqueuedAt);
+    recordReadingStages(job.data.transactionArgs, startedAt, committedAt);
+
+    return {
+      transactionError: undefined,
+      transactionPayload: payload,
+    };
+  } catch (err) {
+    const retryAction = getRetryAction(err);
+
+    if (retryAction === RetryAction.None) {
+      logger.error({ jobId: job.id, jobName: job.name, err }, 'Fatal transaction error occurred');
+
+      // Not retriable so return a job result with the error details
+      return {
+        transactionError: `${err}`,
+        transactionPayload: undefined,
+      };
+    }
+
+    logger.warn({ jobId: job.id, jobName: job.name, err }, 'Retryable transaction error occurred');
+
+    if (retryAction === RetryAction.WithNewTransactionId) {
+      await updateJobData(job, undefined);
+    }
+
+    if (isRetry) {
+      // Rethrow the error so the retry queue backs off and tries again
+      throw err;
+    }
+
+    await queue.retry.add(job.name, job.data, {
+      jobId: job.id,
+      priority: job.data.lane,
+      delay: config.submissionJobBackoffDelay,
+    });
+    return { retried: true };
+  }
+};
+
+/**
+ * Pick the lane of a transaction: security breach and threat flags are
+ * urgent, availability samples and other batched telemetry are bulk.
+ */
+export const laneFor = (chaincode: string, transactionName: string, transactionArgs: string[]): Lane => {
+  if (transactionName === 'IncrementSecurityIncidents') {
+    return Lane.Urgent;
+  }
+  if (chaincode === 'securitycc' && transactionArgs.some(hasBreachFlag)) {
+    return Lane.Urgent;
+  }
+  if (chaincode === 'availabilitycc' || transactionName === 'PutReadingsBatch') {
+    return Lane.Bulk;
+  }
+  return Lane.Normal;
+};
+
+const BREACH_FLAGS = ['breach_flag', 'threat_flag'];
+
+const hasBreachFlag = (arg: string): boolean => {
+  if (!BREACH_FLAGS.some((flag) => arg.includes(flag))) {
+    return false;
+  }
+  try {
+    const parsed = JSON.parse(arg);
+    const readings: Record<string, unknown>[] = Array.isArray(parsed) ? parsed : [parsed];
+    return readings.some((reading) => BREACH_FLAGS.some((flag) => Number(reading?.[flag]) > 0 || reading?.[flag] === true));
+  } catch (err) {
+    return false;
+  }
+};
+
+export const addSubmitTransactionJob = async (
+    queues: SubmitQueues,
+    chaincode: string,
+    transactionName: string,
+    transactionArgs: string[],
+    lane: Lane = laneFor(chaincode, transactionName, transactionArgs)
+): Promise<string> => {
+  const queue = queues.get(chaincode);
+  if (!queue) {
+    throw new Error(`No submit queue for chaincode ${chaincode}`);
+  }
+
+  // The chaincode prefix tells getJobSummary which queues to look in
+  const jobId = `${chaincode}-${randomUUID()}`;
+  const jobName = `submit ${transactionName} transaction`;
+  const job = await queue.fresh.add(jobName, {
+    contract: queue.contract,
+    transactionName,
+    transactionArgs,
+    transactionIds: [],
+    lane,
+    enqueuedAt: Date.now(),
+  }, { jobId, priority: lane });
+
+  if (job?.id === undefined) {
+    throw new Error('Submit transaction job ID not available');
+  }
+
+  return job.id;
+};
+
+export const getJobSummary = async (queues: SubmitQueues, jobId: string): Promise<JobSummary> => {
+  const queue = queues.get(jobId.slice(0, -37)); // Strip '-<uuid>'
+  // A job moved to the retry queue carries the current state there
+  const job: Job<JobData, JobResult> | undefined = queue
+    ? (await queue.retry.getJob(jobId)) ?? (await queue.fresh.getJob(jobId))
+    : undefined;
+  logger.debug({ job }, 'Got job');
+
+  if (!(job && job.id != undefined)) {
+    throw new JobNotFoundError(`Job ${jobId} not found`, jobId);
+  }
+
+  let transactionError;
+  let transactionPayload;
+  const returnValue = job.returnvalue;
+  if (returnValue && !returnValue.retried) {
+    transactionError = returnValue.transactionError;
+    transactionPayload = returnValue.transactionPayload && returnValue.transactionPayload.length > 0
+      ? Buffer.from(returnValue.transactionPayload).toString()
+      : '';
+  }
+
+  return {
+    jobId: job.id,
+    transactionIds: job.data?.transactionIds ?? [],
+    transactionError,
+    transactionPayload,
+  };
+};
+
+export const updateJobData = async (
+    job: Job<JobData, JobResult>,
+    transaction: Transaction | undefined
+): Promise<void> => {
+  const newData = { ...job.data };
+
+  if (transaction != undefined) {
+    newData.transactionIds = ([] as string[]).concat(newData.transactionIds, transaction.getTransactionId());
+    newData.transactionState = transaction.serialize();
+  } else {
+    newData.transactionState = undefined;
+  }
+
+  await job.update(newData);
+};
+
+/**
+ * Job counts of every chaincode's fresh and retry queues.
+ */
+export const getJobCounts = async (
+    queues: SubmitQueues
+): Promise<Record<string, Record<string, number>>> => {
+  const jobCounts: Record<string, Record<string, number>> = {};
+  for (const { fresh, retry } of queues.values()) {
+    for (const queue of [fresh, retry]) {
+      jobCounts[queue.name] = await queue.getJobCounts('active', 'completed', 'delayed', 'failed', 'waiting');
+    }
+  }
+  logger.debug({ jobCounts }, 'Current job counts');
+
+  return jobCounts;
+};
+
+// Latency histograms per chaincode and lane, in power-of-two millisecond buckets
+const HISTOGRAM_BUCKETS_MS = Array.from({ length: 18 }, (_, i) => 2 ** i); // 1 ms .. ~131 s
+const submitWaits = new Map<string, number[]>(); // Enqueue (or retry due) to start
+const submitLatencies = new Map<string, number[]>(); // Enqueue to commit, retries included
+
+const stageLatencies = new Map<string, number[]>(); // Per-reading stages, see recordReadingStages
+
+const recordLatency = (histograms: Map<string, number[]>, chaincode: string, lane: Lane, ms: number) => {
+  recordBucket(histograms, `${chaincode}/${Lane[lane] ?? lane}`, ms);
+};
+
+const recordBucket = (histograms: Map<string, number[]>, key: string, ms: number) => {
+  if (!Number.isFinite(ms)) {
+    return;
+  }
+  if (!histograms.has(key)) {
+    histograms.set(key, new Array(HISTOGRAM_BUCKETS_MS.length + 1).fill(0));
+  }
+  const bucket = HISTOGRAM_BUCKETS_MS.findIndex((bound) => ms <= bound);
+  (histograms.get(key) as number[])[bucket === -1 ? HISTOGRAM_BUCKETS_MS.length : bucket]++;
+};
+
+/**
+ * The ingest drivers stamp readings with sampled_ms (sampling time, mapped
+ * to wall time) and submitted_ms (POST to the gateway). Once a transaction
+ * commits, each reading it carried adds to the gateway_wait (POST to job
+ * start), commit (job start to commit event) and end_to_end (sample to
+ * commit) stages. Stages before the POST are kept by the drivers.
+ */
+const recordReadingStages = (transactionArgs: string[], startedAt: number, committedAt: number) => {
+  for (const arg of transactionArgs) {
+    if (!arg.includes('submitted_ms') && !arg.includes('sampled_ms')) {
+      continue;
+    }
+    let readings: Record<string, unknown>[];
+    try {
+      const parsed = JSON.parse(arg);
+      readings = Array.isArray(parsed) ? parsed : [parsed];
+    } catch (err) {
+      continue;
+    }
+    for (const reading of readings) {
+      if (typeof reading?.submitted_ms === 'number') {
+        recordBucket(stageLatencies, 'gateway_wait', startedAt - reading.submitted_ms);
+      }
+      recordBucket(stageLatencies, 'commit', committedAt - startedAt);
+      if (typeof reading?.sampled_ms === 'number') {
+        recordBucket(stageLatencies, 'end_to_end', committedAt - reading.sampled_ms);
+      }
+    }
+  }
+};
+
+/**
+ * Queue wait, submit latency and per-reading stage histograms; counts[i] is
+ * the number at or below bucketsMs[i], and the last count is everything above.
+ */
+export const getLatencyHistograms = () => ({
+  bucketsMs: HISTOGRAM_BUCKETS_MS,
+  wait: Object.fromEntries(submitWaits),
+  latency: Object.fromEntries(submitLatencies),
+  stages: Object.fromEntries(stageLatencies),
+});
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import express, { Request, Response } from 'express';
+import { Contract } from 'fabric-network';
+import { authenticateApiKey } from './auth';
+import { StatusCodes, getReasonPhrase } from 'http-status-codes';
+
+const { OK, CREATED, BAD_REQUEST, NOT_FOUND, CONFLICT, INTERNAL_SERVER_ERROR } = StatusCodes;
+
+export const anchorsRouter = express.Router();
+
+// app.locals contract of each sensor type, as named by the ingest daemon's segments.
+// The monitor role has no chaincode of its own; the mobility contract keeps its readings.
+const SENSOR_CONTRACTS: Record<string, string> = {
+  availability: 'AvailabilitySensor',
+  integrity: 'IntegritySensor',
+  mobility: 'MobilitySensor',
+  monitor: 'MobilitySensor',
+  network: 'NetworkMobilitySensor',
+  security: 'SecuritySensor',
+};
+
+const getSensorContract = (req: Request, sensor: string): Contract | undefined => {
+  const name = SENSOR_CONTRACTS[sensor];
+  return name ? (req.app.locals[name]?.assetContract as Contract) : undefined;
+};
+
+const sendError = (res: Response, status: number, message: string) =>
+  res.status(status).json({ error: getReasonPhrase(status), message });
+
+// Anchor the Merkle root of one closed segment window
+anchorsRouter.post('/', authenticateApiKey, async (req: Request, res: Response) => {
+  const { sensor, windowId, root, count, start, end, segment } = req.body;
+  const contract = getSensorContract(req, sensor);
+  if (!contract) {
+    return sendError(res, BAD_REQUEST, `Unknown sensor type ${sensor}`);
+  }
+
+  try {
+    const result = await contract.submitTransaction(
+      'AnchorWindow', JSON.stringify({ windowId, root, count, start, end, segment }));
+    res.status(CREATED).json({ data: JSON.parse(result.toString()) });
+  } catch (err) {
+    // A retried window that already made it on-chain is reported, not treated as a failure
+    const status = /already anchored/.test(err.message) ? CONFLICT : INTERNAL_SERVER_ERROR;
+    sendError(res, status, err.message);
+  }
+});
+
+// Read the anchor of one window
+anchorsRouter.get('/:sensor/:windowId', authenticateApiKey, async (req: Request, res: Response) => {
+  const contract = getSensorContract(req, req.params.sensor);
+  if (!contract) {
+    return sendError(res, BAD_REQUEST, `Unknown sensor type ${req.params.sensor}`);
+  }
+
+  try {
+    const result = await contract.evaluateTransaction('ReadAnchor', req.params.windowId);
+    res.status(OK).json({ data: JSON.parse(result.toString()) });
+  } catch (err) {
+    sendError(res, /not anchored/.test(err.message) ? NOT_FOUND : INTERNAL_SERVER_ERROR, err.message);
+  }
+});
+
+// Verify a reading from the daemon's proof server against the anchored root.
+// Body: { windowId, line, proof } as returned by GET /segments/<sensor>/<windowId>/readings/<index>
+anchorsRouter.post('/:sensor/verify', authenticateApiKey, async (req: Request, res: Response) => {
+  const contract = getSensorContract(req, req.params.sensor);
+  const { windowId, line, proof } = req.body;
+  if (!contract) {
+    return sendError(res, BAD_REQUEST, `Unknown sensor type ${req.params.sensor}`);
+  }
+  if (typeof line !== 'string' || !Array.isArray(proof)) {
+    return sendError(res, BAD_REQUEST, 'line must be the stored JSON line and proof an array');
+  }
+
+  try {
+    const result = await contract.evaluateTransaction('VerifyReading', String(windowId), line, JSON.stringify(proof));
+    res.status(OK).json({ data: JSON.parse(result.toString()) });
+  } catch (err) {
+    sendError(res, /not anchored/.test(err.message) ? NOT_FOUND : INTERNAL_SERVER_ERROR, err.message);
+  }
+});
@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import express, { Request, Response } from 'express';
+import { authenticateApiKey } from './auth';
+import { addSubmitTransactionJob, SubmitQueues } from './jobs';
+import { logger } from './logger';
+import { StatusCodes, getReasonPhrase } from 'http-status-codes';
+
+const { ACCEPTED, BAD_REQUEST, INTERNAL_SERVER_ERROR } = StatusCodes;
+
+export const readingsRouter = express.Router();
+
+// Chaincode of each sensor type, as the ingest drivers name it in reading.sensor.
+// The monitor role has no chaincode of its own; the mobility contract keeps its readings.
+const SENSOR_CHAINCODES: Record<string, string> = {
+  availability: 'availabilitycc',
+  integrity: 'integritycc',
+  mobility: 'mobilitycc',
+  monitor: 'mobilitycc',
+  network: 'networkcc',
+  security: 'securitycc',
+};
+
+const MAX_BATCH_READINGS = 1000; // The chaincodes' PutReadingsBatch limit
+
+const sendError = (res: Response, status: number, message: string) =>
+  res.status(status).json({ error: getReasonPhrase(status), message });
+
+/*
+ * Submit a driver batch ({ readings: [...] }, the ingest daemon's
+ * HYPERLEDGER_BATCH_ENDPOINT) as one PutReadingsBatch job per chaincode.
+ * Readings of an unknown sensor type are reported in rejected and the rest
+ * are still queued. The chaincode validates each reading when the job runs;
+ * GET /api/jobs/<jobId> returns its per-reading result.
+ */
+readingsRouter.post('/batch', authenticateApiKey, async (req: Request, res: Response) => {
+  const { readings } = req.body ?? {};
+  if (!Array.isArray(readings) || readings.length === 0) {
+    return sendError(res, BAD_REQUEST, 'readings must be a non-empty array');
+  }
+  if (readings.length > MAX_BATCH_READINGS) {
+    return sendError(res, BAD_REQUEST, `A batch holds at most ${MAX_BATCH_READINGS} readings, got ${readings.length}`);
+  }
+
+  const groups = new Map<string, Record<string, unknown>[]>();
+  const rejected: { index: number; error: string }[] = [];
+  readings.forEach((reading, index) => {
+    const chaincode = SENSOR_CHAINCODES[reading?.sensor];
+    if (!chaincode) {
+      rejected.push({ index, error: `Unknown sensor type ${reading?.sensor}` });
+      return;
+    }
+    if (!groups.has(chaincode)) {
+      groups.set(chaincode, []);
+    }
+    groups.get(chaincode)?.push(reading);
+  });
+
+  if (groups.size === 0) {
+    return res.status(BAD_REQUEST).json({ error: getReasonPhrase(BAD_REQUEST), rejected });
+  }
+
+  try {
+    const queues = req.app.locals.jobq as SubmitQueues;
+    const jobs: Record<string, string> = {};
+    for (const [chaincode, group] of groups) {
+      jobs[chaincode] = await addSubmitTransactionJob(queues, chaincode, 'PutReadingsBatch', [JSON.stringify(group)]);
+    }
+
+    res.status(ACCEPTED).json({
+      status: getReasonPhrase(ACCEPTED),
+      jobs,
+      rejected,
+      timestamp: new Date().toISOString(),
+    });
+  } catch (err) {
+    logger.error({ err }, 'Error queuing readings batch');
+    sendError(res, INTERNAL_SERVER_ERROR, err.message);
+  }
+});
@@ -5,53 +5,97 @@
 import express, { Request, Response } from 'express';
 import { Contract } from 'fabric-network';
 import { authenticateApiKey } from './auth';
+import { pageTags, ReadCache } from './read-cache.service';
 import { StatusCodes, getReasonPhrase } from 'http-status-codes';
 
 const { OK, INTERNAL_SERVER_ERROR } = StatusCodes;
 
 export const sensorsRouter = express.Router();
 
-// Fetch network mobility data
-sensorsRouter.get('/network-mobility', authenticateApiKey, async (req: Request, res: Response) => {
+// Paginated transactions of each sensor chaincode, keyed by app.locals contract name
+interface SensorQueries {
+  locals: string;
+  chaincode: string;
+  allPage: string;
+  byDevice: string;
+}
+
+/*
+ * Every route accepts the same query parameters:
+ *   pageSize  records per page (chaincode default 50, max 500)
+ *   bookmark  bookmark returned with the previous page, omitted for the first
+ *   device    only this device's records, read through the device index
+ *   bucket    with device, only records from one hour ("YYYY-MM-DDTHH")
+ *
+ * Pages are served from the read cache until a block writes one of their
+ * records, or for full scans any record, or for device pages that device's index.
+ */
+const fetchSensorPage = (queries: SensorQueries) => async (req: Request, res: Response) => {
   try {
-    const mobilityContract = req.app.locals.SensorsOrg?.assetContract as Contract;
-    const result = await mobilityContract.evaluateTransaction('QueryAllMobilityData');
+    const contract = req.app.locals[queries.locals]?.assetContract as Contract;
+    const pageSize = String(req.query.pageSize ?? '');
+    const bookmark = String(req.query.bookmark ?? '');
+    const device = req.query.device as string | undefined;
+
+    const cache = req.app.locals.readCache as ReadCache;
+    const result = device
+      ? await cache.evaluate(contract, queries.chaincode, queries.byDevice,
+          [device, String(req.query.bucket ?? ''), pageSize, bookmark],
+          (value) => pageTags(value, `device:${device}`))
+      : await cache.evaluate(contract, queries.chaincode, queries.allPage,
+          [pageSize, bookmark],
+          (value) => pageTags(value, 'records'));
+    const page = JSON.parse(result.toString());
 
-    res.status(OK).json({ data: JSON.parse(result.toString()) });
+    res.status(OK).json({
+      data: page.records,
+      fetchedRecordsCount: page.fetchedRecordsCount,
+      bookmark: page.bookmark,
+    });
   } catch (err) {
     res.status(INTERNAL_SERVER_ERROR).json({
       error: getReasonPhrase(INTERNAL_SERVER_ERROR),
       message: err.message,
     });
   }
-});
+};
 
-// Fetch security data
-sensorsRouter.get('/security', authenticateApiKey, async (req: Request, res: Response) => {
-  try {
-    const securityContract = req.app.locals.SensorsOrg?.assetContract as Contract;
-    const result = await securityContract.evaluateTransaction('QueryAllSecurityData');
+// Fetch network mobility data
+sensorsRouter.get('/network-mobility', authenticateApiKey, fetchSensorPage({
+  locals: 'NetworkMobilitySensor',
+  chaincode: 'networkcc',
+  allPage: 'GetAllNetworkRecordsPage',
+  byDevice: 'GetNetworkRecordsByDevice',
+}));
 
-    res.status(OK).json({ data: JSON.parse(result.toString()) });
-  } catch (err) {
-    res.status(INTERNAL_SERVER_ERROR).json({
-      error: getReasonPhrase(INTERNAL_SERVER_ERROR),
-      message: err.message,
-    });
-  }
-});
+// Fetch security data
+sensorsRouter.get('/security', authenticateApiKey, fetchSensorPage({
+  locals: 'SecuritySensor',
+  chaincode: 'securitycc',
+  allPage: 'GetAllSecurityRecordsPage',
+  byDevice: 'GetSecurityRecordsByDevice',
+}));
 
 // Fetch availability data
-sensorsRouter.get('/availability', authenticateApiKey, async (req: Request, res: Response) => {
-  try {
-    const availabilityContract = req.app.locals.SensorsOrg?.assetContract as Contract;
-    const result = await availabilityContract.evaluateTransaction('QueryAllAvailabilityData');
+sensorsRouter.get('/availability', authenticateApiKey, fetchSensorPage({
+  locals: 'AvailabilitySensor',
+  chaincode: 'availabilitycc',
+  allPage: 'GetAllAvailabilityRecordsPage',
+  byDevice: 'GetAvailabilityRecordsByDevice',
+}));
 
-    res.status(OK).json({ data: JSON.parse(result.toString()) });
-  } catch (err) {
-    res.status(INTERNAL_SERVER_ERROR).json({
-      error: getReasonPhrase(INTERNAL_SERVER_ERROR),
-      message: err.message,
-    });
-  }
-});
\ No newline at end of file
+// Fetch mobility data
+sensorsRouter.get('/mobility', authenticateApiKey, fetchSensorPage({
+  locals: 'MobilitySensor',
+  chaincode: 'mobilitycc',
+  allPage: 'GetAllMobilityPage',
+  byDevice: 'GetMobilityByDevice',
+}));
+
+// Fetch integrity data
+sensorsRouter.get('/integrity', authenticateApiKey, fetchSensorPage({
+  locals: 'IntegritySensor',
+  chaincode: 'integritycc',
+  allPage: 'GetAllIntegrityRecordsPage',
+  byDevice: 'GetIntegrityRecordsByDevice',
+}));
@@ -0,0 +1,60 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import express, { NextFunction, Request, Response } from 'express';
+import { SENSORS, SensorDelta, SensorView } from './sensor-view.service';
+
+export const streamRouter = express.Router();
+
+const HEARTBEAT_INTERVAL_MS = 15000;
+const MAX_BUFFERED_BYTES = 1024 * 1024; // A client this far behind is disconnected
+
+// EventSource cannot send headers, so the stream also accepts ?apiKey=
+export const apiKeyFromQuery = (req: Request, _res: Response, next: NextFunction) => {
+  if (!req.headers['x-api-key'] && typeof req.query.apiKey === 'string') {
+    req.headers['x-api-key'] = req.query.apiKey;
+  }
+  next();
+};
+
+/*
+ * Server-sent events: one 'snapshot' event with the current view, then one
+ * 'delta' event per sensor for every block that changes it. The event id is
+ * the block number. ?sensors=integrity,network limits the stream.
+ */
+streamRouter.get('/', (req: Request, res: Response) => {
+  const view = req.app.locals.sensorView as SensorView;
+  const known = SENSORS.map(({ sensor }) => sensor);
+  const sensors = typeof req.query.sensors === 'string'
+    ? req.query.sensors.split(',').filter((sensor) => known.includes(sensor))
+    : known;
+
+  res.writeHead(200, {
+    'Content-Type': 'text/event-stream',
+    'Cache-Control': 'no-cache',
+    Connection: 'keep-alive',
+    'X-Accel-Buffering': 'no', // Do not let a proxy hold events back
+  });
+
+  const send = (event: string, data: unknown, id: string) => {
+    res.write(`event: ${event}\nid: ${id}\ndata: ${JSON.stringify(data)}\n\n`);
+    if (res.writableLength > MAX_BUFFERED_BYTES) {
+      res.end(); // The client reconnects and starts again from a snapshot
+    }
+  };
+
+  const onDelta = (delta: SensorDelta) => {
+    if (sensors.includes(delta.sensor)) {
+      send('delta', delta, delta.block);
+    }
+  };
+  const heartbeat = setInterval(() => res.write(': keep-alive\n\n'), HEARTBEAT_INTERVAL_MS);
+
+  send('snapshot', view.snapshot(sensors), view.blockNumber);
+  view.on('delta', onDelta);
+  req.on('close', () => {
+    clearInterval(heartbeat);
+    view.off('delta', onDelta);
+  });
+});
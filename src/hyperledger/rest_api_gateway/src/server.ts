@@ -13,6 +13,9 @@ import { healthRouter } from './health.router';
 import { jobsRouter } from './jobs.router';
 import { transactionsRouter } from './transactions.router';
 import { sensorsRouter } from './sensors.router'; // Updated to use SensorsOrg router
+import { anchorsRouter } from './anchors.router';
+import { readingsRouter } from './readings.router';
+import { apiKeyFromQuery, streamRouter } from './stream.router';
 import cors from 'cors';
 
 const { BAD_REQUEST, INTERNAL_SERVER_ERROR, NOT_FOUND } = StatusCodes;
@@ -65,9 +68,18 @@ export const createServer = async (): Promise<Application> => {
   app.use('/api/jobs', authenticateApiKey, jobsRouter);
   app.use('/api/transactions', authenticateApiKey, transactionsRouter);
 
+  // Live sensor view over server-sent events, ahead of the query routes
+  app.use('/api/sensors/stream', apiKeyFromQuery, authenticateApiKey, streamRouter);
+
   // SensorsOrg unified router
   app.use('/api/sensors', authenticateApiKey, sensorsRouter);
 
+  // Driver reading batches, one PutReadingsBatch job per chaincode
+  app.use('/api/readings', authenticateApiKey, readingsRouter);
+
+  // Merkle-root anchors of off-chain segments
+  app.use('/api/anchors', authenticateApiKey, anchorsRouter);
+
   // For everything else (404 Handler)
   app.use((_req, res) =>
       res.status(NOT_FOUND).json({
@@ -3,6 +3,7 @@
  */
 
 import {
+  BlockEvent,
   Contract,
   DefaultEventHandlerStrategies,
   DefaultQueryHandlerStrategies,
@@ -181,4 +182,36 @@ export const getBlockHeight = async (qscc: Contract): Promise<number | Long> =>
 
   logger.debug('Current block height: %d', blockHeight);
   return blockHeight;
-};
\ No newline at end of file
+};
+/**
+ * A key written by a valid transaction, as read from a full block event.
+ */
+export interface StateWrite {
+  namespace: string;
+  key: string;
+  isDelete: boolean;
+  value: unknown;
+}
+
+/**
+ * Get the state writes of every valid transaction in a full block event.
+ */
+export const getBlockWrites = (event: BlockEvent): StateWrite[] => {
+  const writes: StateWrite[] = [];
+  for (const transaction of event.getTransactionEvents()) {
+    if (!transaction.isValid) {
+      continue;
+    }
+    // eslint-disable-next-line @typescript-eslint/no-explicit-any
+    const actions: any[] = (transaction.transactionData as any)?.actions ?? [];
+    for (const action of actions) {
+      const nsRwsets = action.payload?.action?.proposal_response_payload?.extension?.results?.ns_rwset ?? [];
+      for (const { namespace, rwset } of nsRwsets) {
+        for (const write of rwset?.writes ?? []) {
+          writes.push({ namespace, key: write.key, isDelete: Boolean(write.is_delete), value: write.value });
+        }
+      }
+    }
+  }
+  return writes;
+};
@@ -0,0 +1,201 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Read-through cache for evaluateTransaction results, invalidated by blocks.
+ *
+ * World state only changes when a block commits, so a query result stays
+ * valid until a block writes a key it depends on. Every entry is stored with
+ * the dependency tags the caller derives from the result, and a full-block
+ * listener turns each write into the tags it can affect:
+ *
+ *   records         any plain key written (a record created, updated or deleted)
+ *   record:<key>    that record, or a mobility counter delta for it
+ *   device:<id>     a device index entry or batched reading of that device
+ *   window:<id>     an anchored window
+ *   *               a composite key of an unknown index, which drops everything
+ *
+ * Tags are scoped to the chaincode namespace. A read that is in flight while
+ * a block touches its chaincode is returned but not stored, so a result
+ * loaded before the block cannot outlive it. A peer may commit a block a
+ * little after the gateway's event peer; the TTL bounds how long such a
+ * result is served.
+ */
+
+import { BlockEvent, BlockListener, Contract, Network } from 'fabric-network';
+import * as config from './config';
+import { getBlockWrites } from './fabric';
+import { logger } from './logger';
+
+const ALL = '*';
+
+interface CacheEntry {
+  value: Buffer;
+  tags: string[];
+  expires: number;
+}
+
+export class ReadCache {
+  private readonly entries = new Map<string, CacheEntry>(); // Insertion order is LRU order
+  private readonly byTag = new Map<string, Set<string>>();
+  private readonly inFlight = new Map<string, Promise<Buffer>>();
+  private readonly generations = new Map<string, number>(); // Blocks seen that wrote each chaincode
+  private readonly counters = { hits: 0, misses: 0, coalesced: 0, invalidations: 0, evictions: 0, expirations: 0, blocks: 0 };
+  private blockNumber = '';
+
+  constructor(
+      private readonly maxEntries = config.readCacheMaxEntries,
+      private readonly ttlMs = config.readCacheTtl * 1000
+  ) {}
+
+  /**
+   * Evaluate a transaction, or answer it from the cache. tagsFor lists the
+   * tags the result depends on; the chaincode-wide '*' tag is always added.
+   */
+  async evaluate(
+      contract: Contract,
+      chaincode: string,
+      transactionName: string,
+      args: string[],
+      tagsFor: (result: Buffer) => string[]
+  ): Promise<Buffer> {
+    const key = [chaincode, transactionName, ...args].join('\u0000');
+    const entry = this.entries.get(key);
+    if (entry && (this.ttlMs <= 0 || entry.expires > Date.now())) {
+      this.counters.hits++;
+      this.entries.delete(key); // Move to the most recently used end
+      this.entries.set(key, entry);
+      return entry.value;
+    }
+    if (entry) {
+      this.counters.expirations++;
+      this.remove(key);
+    }
+
+    // Identical misses share one peer round-trip
+    const pending = this.inFlight.get(key);
+    if (pending) {
+      this.counters.coalesced++;
+      return pending;
+    }
+
+    this.counters.misses++;
+    const generation = this.generations.get(chaincode) ?? 0;
+    const read = contract.evaluateTransaction(transactionName, ...args).then((value) => {
+      if ((this.generations.get(chaincode) ?? 0) === generation) {
+        const tags = [ALL, ...tagsFor(value)].map((tag) => `${chaincode}/${tag}`);
+        this.store(key, { value, tags, expires: Date.now() + this.ttlMs });
+      }
+      return value;
+    });
+    this.inFlight.set(key, read);
+    try {
+      return await read;
+    } finally {
+      this.inFlight.delete(key);
+    }
+  }
+
+  /**
+   * Drop the entries that depend on what one block wrote.
+   */
+  readonly onBlock: BlockListener = async (event: BlockEvent) => {
+    this.blockNumber = event.blockNumber.toString();
+    this.counters.blocks++;
+
+    const written = new Set<string>();
+    for (const { namespace, key } of getBlockWrites(event)) {
+      this.generations.set(namespace, (this.generations.get(namespace) ?? 0) + 1);
+      for (const tag of writeTags(key)) {
+        written.add(`${namespace}/${tag}`);
+      }
+    }
+    for (const tag of written) {
+      for (const key of this.byTag.get(tag) ?? []) {
+        this.counters.invalidations++;
+        this.remove(key);
+      }
+    }
+  };
+
+  stats() {
+    const lookups = this.counters.hits + this.counters.misses + this.counters.coalesced;
+    return {
+      ...this.counters,
+      entries: this.entries.size,
+      maxEntries: this.maxEntries,
+      hitRatio: lookups > 0 ? this.counters.hits / lookups : 0,
+      lastBlock: this.blockNumber,
+    };
+  }
+
+  private store(key: string, entry: CacheEntry): void {
+    this.remove(key);
+    this.entries.set(key, entry);
+    for (const tag of entry.tags) {
+      if (!this.byTag.has(tag)) {
+        this.byTag.set(tag, new Set());
+      }
+      (this.byTag.get(tag) as Set<string>).add(key);
+    }
+    while (this.entries.size > this.maxEntries) {
+      this.counters.evictions++;
+      this.remove(this.entries.keys().next().value as string);
+    }
+  }
+
+  private remove(key: string): void {
+    const entry = this.entries.get(key);
+    if (!entry) {
+      return;
+    }
+    this.entries.delete(key);
+    for (const tag of entry.tags) {
+      const keys = this.byTag.get(tag);
+      keys?.delete(key);
+      if (keys?.size === 0) {
+        this.byTag.delete(tag);
+      }
+    }
+  }
+}
+
+// Tags a written key can affect, from the chaincodes' key layouts
+const writeTags = (key: string): string[] => {
+  if (!key.startsWith('\u0000')) {
+    return ['records', `record:${key}`];
+  }
+
+  // Composite keys: \u0000objectType\u0000attr\u0000...\u0000
+  const [objectType, ...attributes] = key.split('\u0000').slice(1, -1);
+  switch (objectType) {
+    case 'docType~device~bucket~rid': // Device index
+    case 'docType~device~time~seq': // Batched readings
+      return [`device:${attributes[1]}`];
+    case 'rid~counter~txid': // Mobility counter deltas
+      return [`record:${attributes[0]}`];
+    case 'docType~rid': // Index back references, written with their record
+      return [`record:${attributes[1]}`];
+    case 'docType~window': // Anchors
+      return [`window:${attributes[1]}`];
+    default:
+      return [ALL];
+  }
+};
+
+/**
+ * Tags of a page of records: each record, plus any new record for full scans.
+ */
+export const pageTags = (result: Buffer, scope: string): string[] => {
+  const page = JSON.parse(result.toString());
+  return [scope, ...page.records.map((record: Record<string, unknown>) => `record:${record.RID ?? record.ID}`)];
+};
+
+/**
+ * Build the cache and subscribe it to block events.
+ */
+export const createReadCache = async (network: Network): Promise<ReadCache> => {
+  const cache = new ReadCache();
+  await network.addBlockListener(cache.onBlock, { type: 'full' });
+  logger.info({ maxEntries: config.readCacheMaxEntries, ttl: config.readCacheTtl }, 'Read cache subscribed to block events');
+  return cache;
+};
@@ -0,0 +1,187 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * In-memory view of the sensor chaincodes' world state, kept current from
+ * block events so that dashboards do not query the peers.
+ *
+ * The view is loaded once with the paginated GetAll*Page transactions, then
+ * a single block listener applies the write sets of every valid transaction:
+ * plain keys are records (upserted or deleted), mobility counter deltas add
+ * to their record, and batched readings are kept in a short per-sensor
+ * history. Each block's changes are emitted as one 'delta' event per sensor,
+ * which the SSE route forwards to every connected client.
+ */
+
+import { EventEmitter } from 'events';
+import { BlockEvent, BlockListener, Contract, Network } from 'fabric-network';
+import { getBlockWrites, StateWrite } from './fabric';
+import { logger } from './logger';
+
+// Sensor types, their chaincodes and the app.locals contract names
+export const SENSORS = [
+  { sensor: 'availability', chaincode: 'availabilitycc', locals: 'AvailabilitySensor', allPage: 'GetAllAvailabilityRecordsPage' },
+  { sensor: 'integrity', chaincode: 'integritycc', locals: 'IntegritySensor', allPage: 'GetAllIntegrityRecordsPage' },
+  { sensor: 'mobility', chaincode: 'mobilitycc', locals: 'MobilitySensor', allPage: 'GetAllMobilityPage' },
+  { sensor: 'network', chaincode: 'networkcc', locals: 'NetworkMobilitySensor', allPage: 'GetAllNetworkRecordsPage' },
+  { sensor: 'security', chaincode: 'securitycc', locals: 'SecuritySensor', allPage: 'GetAllSecurityRecordsPage' },
+];
+
+const SNAPSHOT_PAGE_SIZE = '500';
+const MAX_READINGS_PER_SENSOR = 500; // Recent batched readings kept for new clients
+const READING_INDEX = 'docType~device~time~seq';
+const COUNTER_INDEX = 'rid~counter~txid';
+
+type SensorRecord = Record<string, unknown>;
+
+export interface SensorDelta {
+  block: string;
+  sensor: string;
+  upserts: Record<string, SensorRecord>; // Record key -> new value
+  deletes: string[];
+  readings: SensorRecord[];
+}
+
+// Records are keyed by RID, except security records which use ID
+const recordKey = (record: SensorRecord): string => String(record.RID ?? record.ID);
+
+const writeValue = (value: unknown): string =>
+  Buffer.isBuffer(value) ? value.toString('utf8') : String(value ?? '');
+
+export class SensorView extends EventEmitter {
+  blockNumber = '';
+  private readonly records = new Map<string, Map<string, SensorRecord>>();
+  private readonly readings = new Map<string, SensorRecord[]>();
+  private readonly sensorByChaincode = new Map(SENSORS.map(({ sensor, chaincode }) => [chaincode, sensor]));
+
+  constructor() {
+    super();
+    this.setMaxListeners(0); // One listener per connected client
+    for (const { sensor } of SENSORS) {
+      this.records.set(sensor, new Map());
+      this.readings.set(sensor, []);
+    }
+  }
+
+  /**
+   * Load every record of one sensor chaincode, one page at a time.
+   */
+  async load(sensor: string, contract: Contract, allPage: string): Promise<void> {
+    const records = this.records.get(sensor) as Map<string, SensorRecord>;
+    let bookmark = '';
+    do {
+      const page = JSON.parse((await contract.evaluateTransaction(allPage, SNAPSHOT_PAGE_SIZE, bookmark)).toString());
+      for (const record of page.records) {
+        records.set(recordKey(record), record);
+      }
+      bookmark = page.fetchedRecordsCount > 0 ? page.bookmark : '';
+    } while (bookmark);
+  }
+
+  /**
+   * Current view of the given sensors, as sent to a client when it connects.
+   */
+  snapshot(sensors: string[] = SENSORS.map(({ sensor }) => sensor)) {
+    const view: Record<string, { records: Record<string, SensorRecord>; readings: SensorRecord[] }> = {};
+    for (const sensor of sensors) {
+      view[sensor] = {
+        records: Object.fromEntries(this.records.get(sensor) ?? []),
+        readings: this.readings.get(sensor) ?? [],
+      };
+    }
+    return { block: this.blockNumber, sensors: view };
+  }
+
+  /**
+   * Apply the write sets of one block and emit its changes.
+   */
+  readonly onBlock: BlockListener = async (event: BlockEvent) => {
+    this.blockNumber = event.blockNumber.toString();
+    const deltas = new Map<string, SensorDelta>();
+    const deltaFor = (sensor: string): SensorDelta => {
+      if (!deltas.has(sensor)) {
+        deltas.set(sensor, { block: this.blockNumber, sensor, upserts: {}, deletes: [], readings: [] });
+      }
+      return deltas.get(sensor) as SensorDelta;
+    };
+
+    for (const write of getBlockWrites(event)) {
+      const sensor = this.sensorByChaincode.get(write.namespace);
+      if (sensor) {
+        this.applyWrite(sensor, write, deltaFor);
+      }
+    }
+
+    for (const delta of deltas.values()) {
+      this.emit('delta', delta);
+    }
+  };
+
+  private applyWrite(sensor: string, write: StateWrite, deltaFor: (sensor: string) => SensorDelta): void {
+    const records = this.records.get(sensor) as Map<string, SensorRecord>;
+    const key: string = write.key;
+
+    if (!key.startsWith('\u0000')) {
+      if (write.isDelete) {
+        records.delete(key);
+        deltaFor(sensor).deletes.push(key);
+        return;
+      }
+      try {
+        const record = JSON.parse(writeValue(write.value));
+        records.set(key, record);
+        deltaFor(sensor).upserts[key] = record;
+      } catch (err) {
+        logger.debug({ key, sensor }, 'Skipping non-JSON state write');
+      }
+      return;
+    }
+
+    // Composite keys: \u0000objectType\u0000attr\u0000...\u0000
+    const [objectType, ...attributes] = key.split('\u0000').slice(1, -1);
+    if (write.isDelete) {
+      return; // Compaction and updates rewrite the record itself
+    }
+    if (objectType === COUNTER_INDEX) {
+      const [rid, counter] = attributes;
+      const record = records.get(rid);
+      if (record) {
+        record[counter] = Number(record[counter] ?? 0) + Number(writeValue(write.value));
+        deltaFor(sensor).upserts[rid] = record;
+      }
+    } else if (objectType === READING_INDEX) {
+      const reading = JSON.parse(writeValue(write.value));
+      const history = this.readings.get(sensor) as SensorRecord[];
+      history.push(reading);
+      history.splice(0, Math.max(0, history.length - MAX_READINGS_PER_SENSOR));
+      deltaFor(sensor).readings.push(reading);
+    }
+  }
+}
+
+/**
+ * Build the view and subscribe it to block events.
+ *
+ * The listener is registered before the snapshot is read, so no block is
+ * missed. A block that commits while the snapshot loads is applied twice:
+ * harmless for records, but it may over-count a mobility increment until
+ * that record is next rewritten.
+ */
+export const createSensorView = async (
+    network: Network,
+    contracts: Record<string, { assetContract: Contract } | undefined>
+): Promise<SensorView> => {
+  const view = new SensorView();
+  await network.addBlockListener(view.onBlock, { type: 'full' });
+
+  await Promise.all(SENSORS.map(async ({ sensor, locals, allPage }) => {
+    const contract = contracts[locals]?.assetContract;
+    if (!contract) {
+      logger.warn({ sensor }, 'No contract for sensor view');
+      return;
+    }
+    await view.load(sensor, contract, allPage);
+    logger.info({ sensor }, 'Sensor view loaded');
+  }));
+
+  return view;
+};
@@ -1,6 +1,13 @@
 'use strict';
 
 const { Contract } = require('fabric-contract-api');
+const { getRangePage, getDevicePage, getQueryPage, putIndexEntry, deleteIndexEntry } = require('./pagination');
+const { putReadingsBatch, getReadingsPage } = require('./readings');
+const { putAnchor, readAnchor, verifyReading } = require('./anchors');
+
+const DOC_TYPE = 'availability';
+// Fields a batched reading must carry besides device_id
+const REQUIRED_READING_FIELDS = [];
 
 class Availability extends Contract {
     /**
@@ -10,8 +17,8 @@ class Availability extends Contract {
     async InitLedger(ctx) {
         console.info('Ledger initialized with default Availability records');
         const defaultSensors = [
-            { RID: '101', Attempts: 0, SecurityIncidents: 0 },
-            { RID: '102', Attempts: 5, SecurityIncidents: 2 },
+            { RID: '101', Attempts: 0, SecurityIncidents: 0, docType: DOC_TYPE },
+            { RID: '102', Attempts: 5, SecurityIncidents: 2, docType: DOC_TYPE },
         ];
 
         for (const sensor of defaultSensors) {
@@ -28,8 +35,9 @@ class Availability extends Contract {
      * @param {String} rid - Sensor ID (unique identifier)
      * @param {Number} attempts - Number of completed attempts
      * @param {Number} securityIncidents - Number of security issues
+     * @param {String} deviceId - Reporting device for the device index (optional, defaults to the RID)
      */
-    async CreateAvailabilityRecord(ctx, rid, attempts, securityIncidents) {
+    async CreateAvailabilityRecord(ctx, rid, attempts, securityIncidents, deviceId) {
         if (await this.assetExists(ctx, rid)) {
             throw new Error(`Availability record ${rid} already exists`);
         }
@@ -42,9 +50,11 @@ class Availability extends Contract {
             RID: rid,
             Attempts: parseInt(attempts) || 0,
             SecurityIncidents: parseInt(securityIncidents) || 0,
+            docType: DOC_TYPE,
         };
 
         await ctx.stub.putState(rid, Buffer.from(JSON.stringify(newSensor)));
+        await putIndexEntry(ctx, DOC_TYPE, deviceId, rid);
 
         return JSON.stringify(newSensor);
     }
@@ -111,6 +121,7 @@ class Availability extends Contract {
         }
 
         await ctx.stub.deleteState(rid);
+        await deleteIndexEntry(ctx, DOC_TYPE, rid);
         return `Availability record ${rid} has been successfully deleted`;
     }
 
@@ -129,6 +140,92 @@ class Availability extends Contract {
         return JSON.stringify(results);
     }
 
+    /**
+     * Get one page of availability records, in key order
+     * @param {*} ctx - Transaction context
+     * @param {String} pageSize - Records per page (default 50, at most 500)
+     * @param {String} bookmark - Bookmark returned with the previous page, empty for the first
+     */
+    async GetAllAvailabilityRecordsPage(ctx, pageSize, bookmark) {
+        return getRangePage(ctx, pageSize, bookmark);
+    }
+
+    /**
+     * Get one page of a device's availability records through the composite key index
+     * @param {*} ctx - Transaction context
+     * @param {String} deviceId - Reporting device
+     * @param {String} bucket - Hour bucket ("YYYY-MM-DDTHH"), empty for every hour
+     * @param {String} pageSize - Records per page
+     * @param {String} bookmark - Bookmark returned with the previous page
+     */
+    async GetAvailabilityRecordsByDevice(ctx, deviceId, bucket, pageSize, bookmark) {
+        return getDevicePage(ctx, DOC_TYPE, deviceId, bucket, pageSize, bookmark);
+    }
+
+    /**
+     * Get one page of a CouchDB rich query over availability records
+     * @param {*} ctx - Transaction context
+     * @param {String} selectorJSON - Extra selector fields as JSON, empty for all records
+     * @param {String} pageSize - Records per page
+     * @param {String} bookmark - Bookmark returned with the previous page
+     */
+    async QueryAvailabilityRecordsPage(ctx, selectorJSON, pageSize, bookmark) {
+        return getQueryPage(ctx, DOC_TYPE, selectorJSON, pageSize, bookmark);
+    }
+
+    /**
+     * Store a batch of readings in one transaction; invalid readings are reported, not fatal
+     * @param {*} ctx - Transaction context
+     * @param {String} readingsJSON - JSON array of driver readings, each with a device_id
+     */
+    async PutReadingsBatch(ctx, readingsJSON) {
+        return putReadingsBatch(ctx, DOC_TYPE, readingsJSON, REQUIRED_READING_FIELDS);
+    }
+
+    /**
+     * Get one page of a device's batched readings, oldest first
+     * @param {*} ctx - Transaction context
+     * @param {String} deviceId - Reporting device
+     * @param {String} pageSize - Readings per page
+     * @param {String} bookmark - Bookmark returned with the previous page
+     */
+    async GetReadingsByDevice(ctx, deviceId, pageSize, bookmark) {
+        return getReadingsPage(ctx, DOC_TYPE, deviceId, pageSize, bookmark);
+    }
+
+    /**
+     * Anchor the Merkle root of one window of off-chain readings (write-once)
+     * @param {*} ctx - Transaction context
+     * @param {String} anchorJSON - { windowId, root, count, start, end, segment }
+     */
+    async AnchorWindow(ctx, anchorJSON) {
+        return putAnchor(ctx, DOC_TYPE, anchorJSON);
+    }
+
+    /**
+     * Read the anchor of one window
+     * @param {*} ctx - Transaction context
+     * @param {String} windowId - Window start in epoch milliseconds
+     */
+    async ReadAnchor(ctx, windowId) {
+        const anchor = await readAnchor(ctx, DOC_TYPE, windowId);
+        if (!anchor) {
+            throw new Error(`Window ${windowId} is not anchored`);
+        }
+        return JSON.stringify(anchor);
+    }
+
+    /**
+     * Check an off-chain reading and its inclusion proof against the anchored root
+     * @param {*} ctx - Transaction context
+     * @param {String} windowId - Window the reading was stored in
+     * @param {String} line - The reading's JSON line exactly as stored
+     * @param {String} proofJSON - Sibling hashes from the leaf up
+     */
+    async VerifyReading(ctx, windowId, line, proofJSON) {
+        return verifyReading(ctx, DOC_TYPE, windowId, line, proofJSON);
+    }
+
     // Utility: Check if an asset exists
     async assetExists(ctx, rid) {
         const recordBytes = await ctx.stub.getState(rid);
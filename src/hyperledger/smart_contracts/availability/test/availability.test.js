@@ -13,6 +13,22 @@ const Availability = require('../lib/availability.js');
 let assert = sinon.assert;
 chai.use(sinonChai);
 
+// Page through sorted keys the way the peer does: the bookmark is the first key of the next page
+function paginate(states, keys, pageSize, bookmark) {
+    const sorted = keys.sort();
+    const start = bookmark ? sorted.indexOf(bookmark) : 0;
+    const page = sorted.slice(start, start + pageSize);
+    const results = page.map((key) => ({ key, value: states[key] }));
+    let i = 0;
+    return {
+        iterator: {
+            next: async () => (i < results.length ? { value: results[i++], done: false } : { done: true }),
+            close: async () => {},
+        },
+        metadata: { fetchedRecordsCount: page.length, bookmark: sorted[start + pageSize] || '' },
+    };
+}
+
 describe('Availability Smart Contract Tests', () => {
     let transactionContext, chaincodeStub;
 
@@ -39,12 +55,32 @@ describe('Availability Smart Contract Tests', () => {
             function* internalGetStateByRange() {
                 if (chaincodeStub.states) {
                     for (let key in chaincodeStub.states) {
+                        if (key.startsWith('\u0000')) continue; // Composite keys are not in range scans
                         yield { value: chaincodeStub.states[key] };
                     }
                 }
             }
             return Promise.resolve(internalGetStateByRange());
         });
+
+        // Composite keys, transaction time and paginated iterators as the peer provides them
+        chaincodeStub.getTxTimestamp.returns({ seconds: 1700000000, nanos: 0 }); // 2023-11-14T22:13:20Z
+        chaincodeStub.getTxID.returns('tx1');
+        chaincodeStub.createCompositeKey.callsFake((objectType, attributes) =>
+            `\u0000${objectType}\u0000${attributes.map((attribute) => `${attribute}\u0000`).join('')}`);
+        chaincodeStub.splitCompositeKey.callsFake((key) => {
+            const [objectType, ...attributes] = key.split('\u0000').slice(1, -1);
+            return { objectType, attributes };
+        });
+        chaincodeStub.getStateByRangeWithPagination.callsFake(async (startKey, endKey, pageSize, bookmark) => {
+            const keys = Object.keys(chaincodeStub.states || {}).filter((key) => !key.startsWith('\u0000'));
+            return paginate(chaincodeStub.states || {}, keys, pageSize, bookmark);
+        });
+        chaincodeStub.getStateByPartialCompositeKeyWithPagination.callsFake(async (objectType, attributes, pageSize, bookmark) => {
+            const prefix = chaincodeStub.createCompositeKey(objectType, attributes);
+            const keys = Object.keys(chaincodeStub.states || {}).filter((key) => key.startsWith(prefix));
+            return paginate(chaincodeStub.states || {}, keys, pageSize, bookmark);
+        });
     });
 
     it('CreateAvailabilityRecord: should create a new availability record', async () => {
@@ -115,4 +151,60 @@ describe('Availability Smart Contract Tests', () => {
 
         expect(record).to.be.undefined;
     });
-});
\ No newline at end of file
+
+    // Pagination, batches and anchors are tested in smart_contracts/common; these check this contract's wiring
+    describe('Shared query, batch and anchor modules', () => {
+        it('should index and query records under the availability docType', async () => {
+            const contract = new Availability();
+            await contract.CreateAvailabilityRecord(transactionContext, 'R1', 3, 1, 'A1');
+            await contract.CreateAvailabilityRecord(transactionContext, 'R2', 3, 1, 'B2');
+
+            const all = JSON.parse(await contract.GetAllAvailabilityRecordsPage(transactionContext, '', ''));
+            expect(all.records.map((record) => record.RID)).to.eql(['R1', 'R2']);
+            const device = JSON.parse(await contract.GetAvailabilityRecordsByDevice(transactionContext, 'A1', '', '', ''));
+            expect(device.records.map((record) => record.RID)).to.eql(['R1']);
+
+            chaincodeStub.getQueryResultWithPagination.callsFake(async () => paginate({}, [], 50, ''));
+            await contract.QueryAvailabilityRecordsPage(transactionContext, '', '', '');
+            expect(JSON.parse(chaincodeStub.getQueryResultWithPagination.firstCall.args[0]).selector).to.eql({ docType: 'availability' });
+        });
+
+        it('should remove a deleted record from the device index', async () => {
+            const contract = new Availability();
+            await contract.CreateAvailabilityRecord(transactionContext, 'R1', 3, 1, 'A1');
+            await contract.DeleteAvailabilityRecord(transactionContext, 'R1');
+
+            const device = JSON.parse(await contract.GetAvailabilityRecordsByDevice(transactionContext, 'A1', '', '', ''));
+            expect(device.fetchedRecordsCount).to.equal(0);
+        });
+
+        it('should batch readings under the availability docType', async () => {
+            const contract = new Availability();
+            const reading = { rid: '1700000000000', device_id: '0A', seq: 1, availability: 'UP' };
+
+            const result = JSON.parse(await contract.PutReadingsBatch(transactionContext, JSON.stringify([reading])));
+            expect(result.results[0].key).to.equal('\u0000docType~device~time~seq\u0000availability\u00000A\u00002023-11-14T22:13:20.000Z\u00001\u0000');
+            const page = JSON.parse(await contract.GetReadingsByDevice(transactionContext, '0A', '', ''));
+            expect(page.records.map((stored) => stored.docType)).to.eql(['availabilityReading']);
+        });
+
+        it('should anchor windows under the availability docType', async () => {
+            const contract = new Availability();
+            const anchor = {
+                windowId: '1700000000000', root: 'ab'.repeat(32), count: 1,
+                start: '2023-11-14T22:13:20.000Z', end: '2023-11-14T22:14:20.000Z',
+            };
+
+            await contract.AnchorWindow(transactionContext, JSON.stringify(anchor));
+            expect(JSON.parse(await contract.ReadAnchor(transactionContext, '1700000000000')).docType).to.equal('availabilityAnchor');
+            const verified = JSON.parse(await contract.VerifyReading(transactionContext, '1700000000000', '{}', '[]'));
+            expect(verified.valid).to.equal(false);
+            try {
+                await contract.ReadAnchor(transactionContext, '1700000060000');
+                chai.assert.fail('Expected error not thrown');
+            } catch (err) {
+                expect(err.message).to.equal('Window 1700000060000 is not anchored');
+            }
+        });
+    });
+});
@@ -0,0 +1,117 @@
+'use strict';
+
+/*
+ * Merkle-root anchors for readings kept off-chain.
+ *
+ * In anchoring mode the ingest daemon keeps raw readings in local segment
+ * files and commits one anchor per sensor type and time window: the Merkle
+ * root over the window's readings plus its count and time span. Anchors are
+ * write-once under docType~window. VerifyReading recomputes the root from a
+ * reading and its inclusion proof and compares it with the anchored one.
+ * Hashing matches src/simulation/drivers/merkle.js: leaves are
+ * SHA-256(0x00 || line), inner nodes SHA-256(0x01 || left || right).
+ */
+
+const crypto = require('crypto');
+
+const ANCHOR_INDEX = 'docType~window';
+const ROOT_PATTERN = /^[0-9a-f]{64}$/;
+const WINDOW_PATTERN = /^\d+$/;
+
+function sha256(...parts) {
+    const hash = crypto.createHash('sha256');
+    parts.forEach((part) => hash.update(part));
+    return hash.digest();
+}
+
+/**
+ * Root implied by a reading line and its proof
+ * @param {String} line - The reading's JSON line exactly as stored in the segment
+ * @param {Object[]} proof - Sibling hashes from the leaf up, as { position, hash }
+ */
+function rootFromProof(line, proof) {
+    let hash = sha256(Buffer.from([0x00]), Buffer.from(line, 'utf8'));
+    for (const step of proof) {
+        if (!step || !ROOT_PATTERN.test(step.hash) || !['left', 'right'].includes(step.position)) {
+            throw new Error('Proof steps must be { position: "left"|"right", hash: <64 hex> }');
+        }
+        const sibling = Buffer.from(step.hash, 'hex');
+        hash = step.position === 'left'
+            ? sha256(Buffer.from([0x01]), sibling, hash)
+            : sha256(Buffer.from([0x01]), hash, sibling);
+    }
+    return hash.toString('hex');
+}
+
+async function readAnchor(ctx, docType, windowId) {
+    const anchorBytes = await ctx.stub.getState(ctx.stub.createCompositeKey(ANCHOR_INDEX, [docType, windowId]));
+    if (!anchorBytes || anchorBytes.length === 0) {
+        return null;
+    }
+    return JSON.parse(anchorBytes.toString());
+}
+
+/**
+ * Commit the Merkle root of one window of off-chain readings
+ * @param {Context} ctx - The transaction context
+ * @param {String} docType - Record type of the contract
+ * @param {String} anchorJSON - { windowId, root, count, start, end, segment }
+ */
+async function putAnchor(ctx, docType, anchorJSON) {
+    const { windowId, root, count, start, end, segment } = JSON.parse(anchorJSON);
+
+    if (!WINDOW_PATTERN.test(String(windowId))) {
+        throw new Error('windowId must be the window start in epoch milliseconds');
+    }
+    if (!ROOT_PATTERN.test(root)) {
+        throw new Error('root must be a hex SHA-256 digest');
+    }
+    if (!Number.isSafeInteger(count) || count < 1) {
+        throw new Error('count must be a positive integer');
+    }
+    if (!(Date.parse(start) < Date.parse(end))) {
+        throw new Error('start and end must be ISO timestamps with start before end');
+    }
+    if (await readAnchor(ctx, docType, String(windowId))) {
+        throw new Error(`Window ${windowId} is already anchored`);
+    }
+
+    const anchor = {
+        docType: `${docType}Anchor`,
+        windowId: String(windowId),
+        root,
+        count,
+        start,
+        end,
+        segment: segment || '',
+        txId: ctx.stub.getTxID(),
+    };
+    await ctx.stub.putState(ctx.stub.createCompositeKey(ANCHOR_INDEX, [docType, anchor.windowId]),
+        Buffer.from(JSON.stringify(anchor)));
+    return JSON.stringify(anchor);
+}
+
+/**
+ * Check a reading's inclusion proof against the anchored root of its window
+ * @param {Context} ctx - The transaction context
+ * @param {String} docType - Record type of the contract
+ * @param {String} windowId - Window the reading was stored in
+ * @param {String} line - The reading's JSON line exactly as stored
+ * @param {String} proofJSON - JSON array of proof steps
+ */
+async function verifyReading(ctx, docType, windowId, line, proofJSON) {
+    const anchor = await readAnchor(ctx, docType, windowId);
+    if (!anchor) {
+        throw new Error(`Window ${windowId} is not anchored`);
+    }
+    const root = rootFromProof(line, JSON.parse(proofJSON));
+    return JSON.stringify({ valid: root === anchor.root, root, anchor });
+}
+
+module.exports = {
+    ANCHOR_INDEX,
+    rootFromProof,
+    readAnchor,
+    putAnchor,
+    verifyReading,
+};
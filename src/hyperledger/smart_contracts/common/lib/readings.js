@@ -0,0 +1,142 @@
+'use strict';
+
+/*
+ * Batched sensor readings shared by the sensor contracts.
+ *
+ * PutReadingsBatch takes a JSON array of driver readings and writes each one
+ * under the composite key docType~device~time~seq, so a whole batch costs one
+ * endorse/order/commit cycle and a device's readings come back in time order.
+ * A reading that fails validation is reported in the result instead of
+ * aborting the batch. The time is the reading's rid (sampling time in epoch
+ * milliseconds, as the drivers set it), or the transaction time without one;
+ * seq is the reading's seq, or txId.index without one. Readings that carry a
+ * seq are idempotent: resubmitting one reports a duplicate.
+ */
+
+const { toPageSize } = require('./pagination');
+
+const READING_INDEX = 'docType~device~time~seq';
+const MAX_BATCH_READINGS = 1000;
+const MAX_READING_FIELDS = 32;
+
+/**
+ * Sampling time of a reading as an ISO string, so keys sort chronologically
+ * @param {Context} ctx - The transaction context
+ * @param {Object} reading - Driver reading
+ */
+function readingTime(ctx, reading) {
+    const millis = Number(reading.rid);
+    if (Number.isSafeInteger(millis) && millis > 0) {
+        return new Date(millis).toISOString();
+    }
+    const timestamp = ctx.stub.getTxTimestamp();
+    const seconds = typeof timestamp.seconds === 'object' ? timestamp.seconds.toNumber() : Number(timestamp.seconds);
+    return new Date(seconds * 1000).toISOString();
+}
+
+/**
+ * Why a reading cannot be stored, or null when it can
+ * @param {Object} reading - Driver reading
+ * @param {String[]} requiredFields - Fields this sensor type must report
+ */
+function readingError(reading, requiredFields) {
+    if (!reading || typeof reading !== 'object' || Array.isArray(reading)) {
+        return 'Reading must be an object';
+    }
+    if (typeof reading.device_id !== 'string' || reading.device_id.trim() === '') {
+        return 'device_id must be a non-empty string';
+    }
+
+    const fields = Object.keys(reading);
+    if (fields.length > MAX_READING_FIELDS) {
+        return `Reading has more than ${MAX_READING_FIELDS} fields`;
+    }
+    for (const field of fields) {
+        const value = reading[field];
+        if (typeof value === 'number' ? !Number.isFinite(value) : !['string', 'boolean'].includes(typeof value)) {
+            return `Field ${field} must be a finite number, string or boolean`;
+        }
+    }
+
+    const missing = requiredFields.filter((field) => !(field in reading));
+    return missing.length > 0 ? `Missing field(s): ${missing.join(', ')}` : null;
+}
+
+/**
+ * Validate and store a batch of readings in one transaction
+ * @param {Context} ctx - The transaction context
+ * @param {String} docType - Record type of the contract
+ * @param {String} readingsJSON - JSON array of readings
+ * @param {String[]} requiredFields - Fields this sensor type must report besides device_id
+ */
+async function putReadingsBatch(ctx, docType, readingsJSON, requiredFields = []) {
+    let readings;
+    try {
+        readings = JSON.parse(readingsJSON);
+    } catch (err) {
+        throw new Error(`Readings must be a JSON array: ${err.message}`);
+    }
+    if (!Array.isArray(readings)) {
+        throw new Error('Readings must be a JSON array');
+    }
+    if (readings.length > MAX_BATCH_READINGS) {
+        throw new Error(`A batch holds at most ${MAX_BATCH_READINGS} readings, got ${readings.length}`);
+    }
+
+    const txId = ctx.stub.getTxID();
+    const written = new Set();
+    const results = [];
+
+    for (const [index, reading] of readings.entries()) {
+        const error = readingError(reading, requiredFields);
+        if (error) {
+            results.push({ index, error });
+            continue;
+        }
+
+        const seq = reading.seq !== undefined ? String(reading.seq) : `${txId}.${index}`;
+        const key = ctx.stub.createCompositeKey(READING_INDEX, [docType, reading.device_id, readingTime(ctx, reading), seq]);
+        // getState does not see this transaction's own writes, hence the set
+        const existing = written.has(key) || await ctx.stub.getState(key);
+        if (existing && existing.length !== 0) {
+            results.push({ index, error: 'Duplicate reading' });
+            continue;
+        }
+
+        await ctx.stub.putState(key, Buffer.from(JSON.stringify({ ...reading, docType: `${docType}Reading` })));
+        written.add(key);
+        results.push({ index, key });
+    }
+
+    return JSON.stringify({ accepted: written.size, rejected: results.length - written.size, results });
+}
+
+/**
+ * One page of a device's batched readings, oldest first
+ * @param {Context} ctx - The transaction context
+ * @param {String} docType - Record type of the contract
+ * @param {String} deviceId - Reporting device
+ * @param {String} pageSize - Readings per page
+ * @param {String} bookmark - Bookmark from the previous page, empty for the first
+ */
+async function getReadingsPage(ctx, docType, deviceId, pageSize, bookmark) {
+    const { iterator, metadata } = await ctx.stub.getStateByPartialCompositeKeyWithPagination(
+        READING_INDEX, [docType, deviceId], toPageSize(pageSize), bookmark || '');
+
+    const records = [];
+    let result = await iterator.next();
+    while (!result.done) {
+        records.push(JSON.parse(Buffer.from(result.value.value).toString('utf8')));
+        result = await iterator.next();
+    }
+    await iterator.close();
+
+    return JSON.stringify({ records, fetchedRecordsCount: metadata.fetchedRecordsCount, bookmark: metadata.bookmark });
+}
+
+module.exports = {
+    READING_INDEX,
+    MAX_BATCH_READINGS,
+    putReadingsBatch,
+    getReadingsPage,
+};
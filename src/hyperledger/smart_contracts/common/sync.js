@@ -0,0 +1,52 @@
+'use strict';
+
+/*
+ * Copy the shared contract modules into every sensor chaincode package.
+ *
+ * Each chaincode is packaged and deployed from its own directory, so it has
+ * to carry the modules it requires. common/lib is their only source: edit it
+ * and run `npm run sync` here. `node sync.js --check` (run by `npm test`)
+ * fails when a package's copy differs from the source.
+ */
+
+const fs = require('fs');
+const path = require('path');
+
+const MODULES = ['pagination.js', 'readings.js', 'anchors.js'];
+const PACKAGES = ['availability', 'integrity', 'mobility', 'network', 'security'];
+
+function generated(module) {
+    const source = fs.readFileSync(path.join(__dirname, 'lib', module), 'utf8');
+    return `// Generated from smart_contracts/common/lib/${module} by common/sync.js; edit that file, not this copy.\n${source}`;
+}
+
+function sync(check) {
+    const stale = [];
+    for (const pkg of PACKAGES) {
+        for (const module of MODULES) {
+            const target = path.join(__dirname, '..', pkg, 'lib', module);
+            const content = generated(module);
+            const current = fs.existsSync(target) ? fs.readFileSync(target, 'utf8') : null;
+            if (current === content) {
+                continue;
+            }
+            stale.push(path.relative(path.join(__dirname, '..'), target));
+            if (!check) {
+                fs.writeFileSync(target, content);
+            }
+        }
+    }
+    return stale;
+}
+
+if (require.main === module) {
+    const check = process.argv.includes('--check');
+    const stale = sync(check);
+    if (check && stale.length > 0) {
+        console.error(`Out of date, run npm run sync in common/: ${stale.join(', ')}`);
+        process.exit(1);
+    }
+    stale.forEach((file) => console.info(`${check ? 'Out of date' : 'Updated'}: ${file}`));
+}
+
+module.exports = { MODULES, PACKAGES, sync };
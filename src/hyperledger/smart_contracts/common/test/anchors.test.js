@@ -0,0 +1,78 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+'use strict';
+
+const chai = require('chai');
+const expect = chai.expect;
+const crypto = require('crypto');
+
+const { createContext } = require('./stub');
+const { putAnchor, readAnchor, verifyReading, rootFromProof } = require('../lib/anchors');
+
+describe('Shared anchoring', () => {
+    let transactionContext;
+
+    // Three readings: the third leaf is promoted unchanged to the second level
+    const sha256 = (...parts) => crypto.createHash('sha256').update(Buffer.concat(parts)).digest();
+    const lines = ['{"device_id":"0A","seq":1}', '{"device_id":"0A","seq":2}', '{"device_id":"0B","seq":1}'];
+    const leaves = lines.map((line) => sha256(Buffer.from([0]), Buffer.from(line)));
+    const left = sha256(Buffer.from([1]), leaves[0], leaves[1]);
+    const root = sha256(Buffer.from([1]), left, leaves[2]).toString('hex');
+    const anchor = {
+        windowId: '1700000000000', root, count: 3,
+        start: '2023-11-14T22:13:20.000Z', end: '2023-11-14T22:14:20.000Z', segment: '1700000000000.jsonl',
+    };
+
+    const refused = async (promise) => {
+        try {
+            await promise;
+        } catch (err) {
+            return err.message;
+        }
+        chai.assert.fail('Expected error not thrown');
+    };
+
+    beforeEach(() => {
+        ({ transactionContext } = createContext());
+    });
+
+    it('should anchor a window once', async () => {
+        await putAnchor(transactionContext, 'test', JSON.stringify(anchor));
+
+        const stored = await readAnchor(transactionContext, 'test', '1700000000000');
+        expect(stored.docType).to.equal('testAnchor');
+        expect(stored.root).to.equal(root);
+        expect(stored.count).to.equal(3);
+        expect(await readAnchor(transactionContext, 'other', '1700000000000')).to.equal(null);
+        expect(await refused(putAnchor(transactionContext, 'test', JSON.stringify(anchor))))
+            .to.equal('Window 1700000000000 is already anchored');
+    });
+
+    it('should verify readings against the anchored root', async () => {
+        await putAnchor(transactionContext, 'test', JSON.stringify({ ...anchor, segment: undefined }));
+
+        const proofFirst = [{ position: 'right', hash: leaves[1].toString('hex') }, { position: 'right', hash: leaves[2].toString('hex') }];
+        const proofLast = [{ position: 'left', hash: left.toString('hex') }];
+        const verify = async (line, proof) =>
+            JSON.parse(await verifyReading(transactionContext, 'test', '1700000000000', line, JSON.stringify(proof))).valid;
+
+        expect(await verify(lines[0], proofFirst)).to.equal(true);
+        expect(await verify(lines[2], proofLast)).to.equal(true);
+        expect(await verify('{"device_id":"0A","seq":9}', proofFirst)).to.equal(false);
+        expect(await refused(verifyReading(transactionContext, 'test', '1700000060000', lines[0], '[]')))
+            .to.equal('Window 1700000060000 is not anchored');
+    });
+
+    it('should reject malformed anchors and proofs', async () => {
+        const malformed = (fields) => refused(putAnchor(transactionContext, 'test', JSON.stringify({ ...anchor, ...fields })));
+
+        expect(await malformed({ windowId: 'now' })).to.equal('windowId must be the window start in epoch milliseconds');
+        expect(await malformed({ root: 'abc' })).to.equal('root must be a hex SHA-256 digest');
+        expect(await malformed({ count: 0 })).to.equal('count must be a positive integer');
+        expect(await malformed({ end: anchor.start })).to.equal('start and end must be ISO timestamps with start before end');
+        expect(() => rootFromProof(lines[0], [{ position: 'up', hash: root }]))
+            .to.throw('Proof steps must be { position: "left"|"right", hash: <64 hex> }');
+    });
+});
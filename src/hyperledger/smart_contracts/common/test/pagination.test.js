@@ -0,0 +1,121 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+'use strict';
+
+const chai = require('chai');
+const expect = chai.expect;
+
+const { createContext, paginate } = require('./stub');
+const { toPageSize, putIndexEntry, deleteIndexEntry, getRangePage, getDevicePage, getQueryPage } = require('../lib/pagination');
+
+describe('Shared pagination', () => {
+    let transactionContext, chaincodeStub;
+
+    // A record keyed by RID plus its device index entry, as the contracts' Create* transactions write them
+    const createRecord = async (rid, deviceId) => {
+        await chaincodeStub.putState(rid, Buffer.from(JSON.stringify({ RID: rid, docType: 'test' })));
+        await putIndexEntry(transactionContext, 'test', deviceId, rid);
+    };
+
+    beforeEach(() => {
+        ({ transactionContext, chaincodeStub } = createContext());
+    });
+
+    it('should clamp page sizes', () => {
+        expect(toPageSize('')).to.equal(50);
+        expect(toPageSize('0')).to.equal(50);
+        expect(toPageSize('-5')).to.equal(50);
+        expect(toPageSize('20')).to.equal(20);
+        expect(toPageSize('5000')).to.equal(500);
+    });
+
+    it('should page through records and skip device index entries', async () => {
+        await createRecord('R1', 'A1');
+        await createRecord('R2', 'A1');
+        await createRecord('R3', 'B2');
+
+        const first = JSON.parse(await getRangePage(transactionContext, '2', ''));
+        expect(first.records.map((record) => record.RID)).to.eql(['R1', 'R2']);
+        expect(first.bookmark).to.equal('R3');
+
+        const second = JSON.parse(await getRangePage(transactionContext, '2', first.bookmark));
+        expect(second.records.map((record) => record.RID)).to.eql(['R3']);
+        expect(second.bookmark).to.equal('');
+    });
+
+    it('should find a device\'s records through the composite key index', async () => {
+        await createRecord('R1', 'A1');
+        await createRecord('R2', 'A1');
+        await createRecord('R3', 'B2');
+
+        const page = JSON.parse(await getDevicePage(transactionContext, 'test', 'A1', '', '10', ''));
+        expect(page.records.map((record) => record.RID)).to.eql(['R1', 'R2']);
+
+        const hour = JSON.parse(await getDevicePage(transactionContext, 'test', 'A1', '2023-11-14T22', '10', ''));
+        expect(hour.records).to.have.lengthOf(2);
+
+        const otherHour = JSON.parse(await getDevicePage(transactionContext, 'test', 'A1', '2023-11-14T23', '10', ''));
+        expect(otherHour.records).to.have.lengthOf(0);
+    });
+
+    it('should bucket by a Long transaction timestamp', async () => {
+        chaincodeStub.getTxTimestamp.returns({ seconds: { toNumber: () => 1700003600 }, nanos: 0 });
+        await createRecord('R1', 'A1');
+
+        const hour = JSON.parse(await getDevicePage(transactionContext, 'test', 'A1', '2023-11-14T23', '10', ''));
+        expect(hour.records.map((record) => record.RID)).to.eql(['R1']);
+    });
+
+    it('should index a record without a device under its RID', async () => {
+        await createRecord('R1', '');
+
+        const page = JSON.parse(await getDevicePage(transactionContext, 'test', 'R1', '', '10', ''));
+        expect(page.records.map((record) => record.RID)).to.eql(['R1']);
+    });
+
+    it('should delete a record\'s index entry with the record', async () => {
+        await createRecord('R1', 'A1');
+        await createRecord('R2', 'A1');
+        await chaincodeStub.deleteState('R1');
+        await deleteIndexEntry(transactionContext, 'test', 'R1');
+
+        const page = JSON.parse(await getDevicePage(transactionContext, 'test', 'A1', '', '10', ''));
+        expect(page.records.map((record) => record.RID)).to.eql(['R2']);
+        expect(page.fetchedRecordsCount).to.equal(1);
+        expect(Object.keys(chaincodeStub.states).filter((key) => key.includes('R1'))).to.eql([]);
+    });
+
+    it('should skip entries left behind by records deleted before the back reference', async () => {
+        await createRecord('R1', 'A1');
+        await chaincodeStub.deleteState('R1');
+        await chaincodeStub.deleteState(chaincodeStub.createCompositeKey('docType~rid', ['test', 'R1']));
+        await deleteIndexEntry(transactionContext, 'test', 'R1');
+
+        const page = JSON.parse(await getDevicePage(transactionContext, 'test', 'A1', '', '10', ''));
+        expect(page.records).to.eql([]);
+        expect(page.fetchedRecordsCount).to.equal(1);
+    });
+
+    it('should skip state that is not JSON', async () => {
+        await chaincodeStub.putState('R1', Buffer.from('not json'));
+        await createRecord('R2', 'A1');
+
+        const page = JSON.parse(await getRangePage(transactionContext, '', ''));
+        expect(page.records.map((record) => record.RID)).to.eql(['R2']);
+    });
+
+    it('should restrict rich queries to the docType index', async () => {
+        chaincodeStub.getQueryResultWithPagination.callsFake(async () => paginate({}, [], 50, ''));
+
+        await getQueryPage(transactionContext, 'test', '{"RID":"R1"}', '', '');
+        const [query, pageSize] = chaincodeStub.getQueryResultWithPagination.firstCall.args;
+        expect(JSON.parse(query).selector).to.eql({ RID: 'R1', docType: 'test' });
+        expect(JSON.parse(query).use_index).to.eql(['indexDocTypeDoc', 'indexDocType']);
+        expect(pageSize).to.equal(50);
+
+        await getQueryPage(transactionContext, 'test', '', '10', '');
+        expect(JSON.parse(chaincodeStub.getQueryResultWithPagination.secondCall.args[0]).selector).to.eql({ docType: 'test' });
+    });
+});
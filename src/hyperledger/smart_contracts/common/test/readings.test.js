@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+'use strict';
+
+const chai = require('chai');
+const expect = chai.expect;
+
+const { createContext } = require('./stub');
+const { putReadingsBatch, getReadingsPage, MAX_BATCH_READINGS } = require('../lib/readings');
+
+describe('Shared readings batch', () => {
+    let transactionContext;
+
+    beforeEach(() => {
+        ({ transactionContext } = createContext());
+    });
+
+    it('should store valid readings and report invalid ones without aborting', async () => {
+        const readings = [
+            { rid: '1700000000000', device_id: '0A', seq: 1, value: 3 },
+            { rid: '1700000000000', seq: 2, value: 3 },
+            { rid: '1700000005000', device_id: '0A', value: 3 },
+            { device_id: '0A', nested: { value: 1 } },
+            { device_id: '0A', value: 3 },
+            'not a reading',
+        ];
+
+        const result = JSON.parse(await putReadingsBatch(transactionContext, 'test', JSON.stringify(readings)));
+        expect(result.accepted).to.equal(3);
+        expect(result.rejected).to.equal(3);
+        expect(result.results[0].key).to.equal('\u0000docType~device~time~seq\u0000test\u00000A\u00002023-11-14T22:13:20.000Z\u00001\u0000');
+        expect(result.results[1].error).to.equal('device_id must be a non-empty string');
+        expect(result.results[2].key).to.match(/\u0000tx1\.2\u0000$/); // No seq: transaction id and batch index
+        expect(result.results[3].error).to.equal('Field nested must be a finite number, string or boolean');
+        expect(result.results[4].key).to.include('\u00002023-11-14T22:13:20.000Z\u0000'); // No rid: transaction time
+        expect(result.results[5].error).to.equal('Reading must be an object');
+
+        const page = JSON.parse(await getReadingsPage(transactionContext, 'test', '0A', '', ''));
+        expect(page.records.map((reading) => reading.docType)).to.eql(['testReading', 'testReading', 'testReading']);
+    });
+
+    it('should reject duplicate readings within and across batches', async () => {
+        const reading = { rid: '1700000000000', device_id: '0A', seq: 7, value: 3 };
+
+        const first = JSON.parse(await putReadingsBatch(transactionContext, 'test', JSON.stringify([reading, reading])));
+        expect(first.results.map((entry) => entry.error)).to.eql([undefined, 'Duplicate reading']);
+        const retry = JSON.parse(await putReadingsBatch(transactionContext, 'test', JSON.stringify([reading])));
+        expect(retry.accepted).to.equal(0);
+    });
+
+    it('should fall back to a Long transaction timestamp', async () => {
+        transactionContext.stub.getTxTimestamp.returns({ seconds: { toNumber: () => 1700003600 }, nanos: 0 });
+
+        const result = JSON.parse(await putReadingsBatch(transactionContext, 'test', JSON.stringify([{ device_id: '0A', seq: 1 }])));
+        expect(result.results[0].key).to.include('\u00002023-11-14T23:13:20.000Z\u0000');
+    });
+
+    it('should require the contract\'s fields', async () => {
+        const readings = [{ device_id: '0A', value: 3 }, { device_id: '0A' }];
+
+        const result = JSON.parse(await putReadingsBatch(transactionContext, 'test', JSON.stringify(readings), ['value']));
+        expect(result.results[1].error).to.equal('Missing field(s): value');
+    });
+
+    it('should reject readings with too many fields', async () => {
+        const reading = { device_id: '0A' };
+        for (let i = 0; i < 32; i++) {
+            reading[`f${i}`] = i;
+        }
+
+        const result = JSON.parse(await putReadingsBatch(transactionContext, 'test', JSON.stringify([reading])));
+        expect(result.results[0].error).to.equal('Reading has more than 32 fields');
+    });
+
+    it('should refuse payloads that are not an array of at most MAX_BATCH_READINGS', async () => {
+        const refused = async (payload) => {
+            try {
+                await putReadingsBatch(transactionContext, 'test', payload);
+            } catch (err) {
+                return err.message;
+            }
+            chai.assert.fail('Expected error not thrown');
+        };
+
+        expect(await refused('{"device_id":"0A"}')).to.equal('Readings must be a JSON array');
+        expect(await refused('[')).to.match(/^Readings must be a JSON array: /);
+        expect(await refused(JSON.stringify(new Array(MAX_BATCH_READINGS + 1).fill({}))))
+            .to.equal(`A batch holds at most ${MAX_BATCH_READINGS} readings, got ${MAX_BATCH_READINGS + 1}`);
+    });
+});
@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+'use strict';
+
+/*
+ * Transaction context over an in-memory world state, with composite keys,
+ * transaction time and paginated iterators as the peer provides them. Used
+ * by the shared module tests here and by every sensor contract's tests.
+ */
+
+const sinon = require('sinon');
+const {Context} = require('fabric-contract-api');
+const {ChaincodeStub} = require('fabric-shim');
+
+// Page through sorted keys the way the peer does: the bookmark is the first key of the next page
+function paginate(states, keys, pageSize, bookmark) {
+    const sorted = keys.sort();
+    const start = bookmark ? sorted.indexOf(bookmark) : 0;
+    const page = sorted.slice(start, start + pageSize);
+    const results = page.map((key) => ({ key, value: states[key] }));
+    let i = 0;
+    return {
+        iterator: {
+            next: async () => (i < results.length ? { value: results[i++], done: false } : { done: true }),
+            close: async () => {},
+        },
+        metadata: { fetchedRecordsCount: page.length, bookmark: sorted[start + pageSize] || '' },
+    };
+}
+
+/**
+ * A fresh context; its stub keeps the world state in stub.states
+ * @returns {{ transactionContext: Context, chaincodeStub: ChaincodeStub }}
+ */
+function createContext() {
+    const transactionContext = new Context();
+    const chaincodeStub = sinon.createStubInstance(ChaincodeStub);
+    transactionContext.setChaincodeStub(chaincodeStub);
+    const states = {};
+    chaincodeStub.states = states;
+
+    chaincodeStub.putState.callsFake(async (key, value) => {
+        states[key] = value;
+    });
+    chaincodeStub.getState.callsFake(async (key) => states[key]);
+    chaincodeStub.deleteState.callsFake(async (key) => {
+        delete states[key];
+    });
+
+    // Composite keys are not part of range scans
+    const plainKeys = () => Object.keys(states).filter((key) => !key.startsWith('\u0000')).sort();
+    chaincodeStub.getStateByRange.callsFake(async () => {
+        async function* internalGetStateByRange() {
+            for (const key of plainKeys()) {
+                yield { key, value: states[key] };
+            }
+        }
+        return internalGetStateByRange();
+    });
+
+    chaincodeStub.getTxTimestamp.returns({ seconds: 1700000000, nanos: 0 }); // 2023-11-14T22:13:20Z
+    chaincodeStub.getTxID.returns('tx1');
+    chaincodeStub.createCompositeKey.callsFake((objectType, attributes) =>
+        `\u0000${objectType}\u0000${attributes.map((attribute) => `${attribute}\u0000`).join('')}`);
+    chaincodeStub.splitCompositeKey.callsFake((key) => {
+        const [objectType, ...attributes] = key.split('\u0000').slice(1, -1);
+        return { objectType, attributes };
+    });
+    chaincodeStub.getStateByRangeWithPagination.callsFake(async (startKey, endKey, pageSize, bookmark) =>
+        paginate(states, plainKeys(), pageSize, bookmark));
+    chaincodeStub.getStateByPartialCompositeKey.callsFake(async (objectType, attributes) => {
+        const prefix = chaincodeStub.createCompositeKey(objectType, attributes);
+        async function* internalGetStateByPartialCompositeKey() {
+            for (const key of Object.keys(states).filter((k) => k.startsWith(prefix)).sort()) {
+                yield { key, value: states[key] };
+            }
+        }
+        return internalGetStateByPartialCompositeKey();
+    });
+    chaincodeStub.getStateByPartialCompositeKeyWithPagination.callsFake(async (objectType, attributes, pageSize, bookmark) => {
+        const prefix = chaincodeStub.createCompositeKey(objectType, attributes);
+        return paginate(states, Object.keys(states).filter((key) => key.startsWith(prefix)), pageSize, bookmark);
+    });
+    chaincodeStub.getQueryResultWithPagination.callsFake(async () => paginate({}, [], 50, ''));
+
+    return { transactionContext, chaincodeStub };
+}
+
+module.exports = { paginate, createContext };
@@ -0,0 +1,23 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+'use strict';
+
+const chai = require('chai');
+const expect = chai.expect;
+const fs = require('fs');
+const path = require('path');
+
+const { MODULES, PACKAGES, sync } = require('../sync');
+
+describe('Contract copies', () => {
+    it('should match the shared modules in every contract package', () => {
+        expect(sync(true)).to.eql([]);
+        for (const pkg of PACKAGES) {
+            for (const module of MODULES) {
+                expect(fs.existsSync(path.join(__dirname, '..', '..', pkg, 'lib', module))).to.equal(true);
+            }
+        }
+    });
+});
@@ -1,6 +1,13 @@
 'use strict';
 
 const { Contract } = require('fabric-contract-api');
+const { getRangePage, getDevicePage, getQueryPage, putIndexEntry, deleteIndexEntry } = require('./pagination');
+const { putReadingsBatch, getReadingsPage } = require('./readings');
+const { putAnchor, readAnchor, verifyReading } = require('./anchors');
+
+const DOC_TYPE = 'integrity';
+// Fields a batched reading must carry besides device_id
+const REQUIRED_READING_FIELDS = [];
 
 class Integrity extends Contract {
     /**
@@ -10,8 +17,8 @@ class Integrity extends Contract {
         console.info('Initializing the Integrity Ledger with default data');
 
         const defaultIntegrityData = [
-            { RID: '201', Status: 'Operational', TamperIncidents: 0, IntegrityScore: 100 },
-            { RID: '202', Status: 'Compromised', TamperIncidents: 3, IntegrityScore: 70 },
+            { RID: '201', Status: 'Operational', TamperIncidents: 0, IntegrityScore: 100, docType: DOC_TYPE },
+            { RID: '202', Status: 'Compromised', TamperIncidents: 3, IntegrityScore: 70, docType: DOC_TYPE },
         ];
 
         for (const record of defaultIntegrityData) {
@@ -29,8 +36,9 @@ class Integrity extends Contract {
      * @param {String} status - Current status of the sensor (e.g., "Operational", "Compromised")
      * @param {Number} tamperIncidents - Count of tampering incidents observed
      * @param {Number} integrityScore - Integrity score (0-100)
+     * @param {String} deviceId - Reporting device for the device index (optional, defaults to the RID)
      */
-    async CreateIntegrityRecord(ctx, rid, status, tamperIncidents, integrityScore) {
+    async CreateIntegrityRecord(ctx, rid, status, tamperIncidents, integrityScore, deviceId) {
         if (await this.recordExists(ctx, rid)) {
             throw new Error(`Integrity record with RID ${rid} already exists`);
         }
@@ -44,9 +52,11 @@ class Integrity extends Contract {
             Status: status || 'Unknown',
             TamperIncidents: parseInt(tamperIncidents) || 0,
             IntegrityScore: parseInt(integrityScore) || 100,
+            docType: DOC_TYPE,
         };
 
         await ctx.stub.putState(rid, Buffer.from(JSON.stringify(newRecord)));
+        await putIndexEntry(ctx, DOC_TYPE, deviceId, rid);
 
         return JSON.stringify(newRecord);
     }
@@ -113,6 +123,7 @@ class Integrity extends Contract {
         }
 
         await ctx.stub.deleteState(rid);
+        await deleteIndexEntry(ctx, DOC_TYPE, rid);
 
         return `Integrity record ${rid} successfully deleted`;
     }
@@ -132,6 +143,92 @@ class Integrity extends Contract {
         return JSON.stringify(results);
     }
 
+    /**
+     * Get one page of integrity records, in key order
+     * @param {Context} ctx - The Fabric transaction context
+     * @param {String} pageSize - Records per page (default 50, at most 500)
+     * @param {String} bookmark - Bookmark returned with the previous page, empty for the first
+     */
+    async GetAllIntegrityRecordsPage(ctx, pageSize, bookmark) {
+        return getRangePage(ctx, pageSize, bookmark);
+    }
+
+    /**
+     * Get one page of a device's integrity records through the composite key index
+     * @param {Context} ctx - The Fabric transaction context
+     * @param {String} deviceId - Reporting device
+     * @param {String} bucket - Hour bucket ("YYYY-MM-DDTHH"), empty for every hour
+     * @param {String} pageSize - Records per page
+     * @param {String} bookmark - Bookmark returned with the previous page
+     */
+    async GetIntegrityRecordsByDevice(ctx, deviceId, bucket, pageSize, bookmark) {
+        return getDevicePage(ctx, DOC_TYPE, deviceId, bucket, pageSize, bookmark);
+    }
+
+    /**
+     * Get one page of a CouchDB rich query over integrity records
+     * @param {Context} ctx - The Fabric transaction context
+     * @param {String} selectorJSON - Extra selector fields as JSON, empty for all records
+     * @param {String} pageSize - Records per page
+     * @param {String} bookmark - Bookmark returned with the previous page
+     */
+    async QueryIntegrityRecordsPage(ctx, selectorJSON, pageSize, bookmark) {
+        return getQueryPage(ctx, DOC_TYPE, selectorJSON, pageSize, bookmark);
+    }
+
+    /**
+     * Store a batch of readings in one transaction; invalid readings are reported, not fatal
+     * @param {Context} ctx - The Fabric transaction context
+     * @param {String} readingsJSON - JSON array of driver readings, each with a device_id
+     */
+    async PutReadingsBatch(ctx, readingsJSON) {
+        return putReadingsBatch(ctx, DOC_TYPE, readingsJSON, REQUIRED_READING_FIELDS);
+    }
+
+    /**
+     * Get one page of a device's batched readings, oldest first
+     * @param {Context} ctx - The Fabric transaction context
+     * @param {String} deviceId - Reporting device
+     * @param {String} pageSize - Readings per page
+     * @param {String} bookmark - Bookmark returned with the previous page
+     */
+    async GetReadingsByDevice(ctx, deviceId, pageSize, bookmark) {
+        return getReadingsPage(ctx, DOC_TYPE, deviceId, pageSize, bookmark);
+    }
+
+    /**
+     * Anchor the Merkle root of one window of off-chain readings (write-once)
+     * @param {Context} ctx - The Fabric transaction context
+     * @param {String} anchorJSON - { windowId, root, count, start, end, segment }
+     */
+    async AnchorWindow(ctx, anchorJSON) {
+        return putAnchor(ctx, DOC_TYPE, anchorJSON);
+    }
+
+    /**
+     * Read the anchor of one window
+     * @param {Context} ctx - The Fabric transaction context
+     * @param {String} windowId - Window start in epoch milliseconds
+     */
+    async ReadAnchor(ctx, windowId) {
+        const anchor = await readAnchor(ctx, DOC_TYPE, windowId);
+        if (!anchor) {
+            throw new Error(`Window ${windowId} is not anchored`);
+        }
+        return JSON.stringify(anchor);
+    }
+
+    /**
+     * Check an off-chain reading and its inclusion proof against the anchored root
+     * @param {Context} ctx - The Fabric transaction context
+     * @param {String} windowId - Window the reading was stored in
+     * @param {String} line - The reading's JSON line exactly as stored
+     * @param {String} proofJSON - Sibling hashes from the leaf up
+     */
+    async VerifyReading(ctx, windowId, line, proofJSON) {
+        return verifyReading(ctx, DOC_TYPE, windowId, line, proofJSON);
+    }
+
     /**
      * Utility: Check if a record exists
      * @param {Context} ctx - The Fabric transaction context
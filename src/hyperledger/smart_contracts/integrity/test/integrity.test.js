@@ -7,6 +7,22 @@ const { ChaincodeStub } = require('fabric-shim');
 const Integrity = require('../lib/integrity');
 const expect = chai.expect;
 
+// Page through sorted keys the way the peer does: the bookmark is the first key of the next page
+function paginate(states, keys, pageSize, bookmark) {
+    const sorted = keys.sort();
+    const start = bookmark ? sorted.indexOf(bookmark) : 0;
+    const page = sorted.slice(start, start + pageSize);
+    const results = page.map((key) => ({ key, value: states[key] }));
+    let i = 0;
+    return {
+        iterator: {
+            next: async () => (i < results.length ? { value: results[i++], done: false } : { done: true }),
+            close: async () => {},
+        },
+        metadata: { fetchedRecordsCount: page.length, bookmark: sorted[start + pageSize] || '' },
+    };
+}
+
 describe('Integrity Smart Contract Tests', () => {
     let context, chaincodeStub;
 
@@ -28,6 +44,25 @@ describe('Integrity Smart Contract Tests', () => {
             if (chaincodeStub.states) delete chaincodeStub.states[key];
             return Promise.resolve();
         });
+
+        // Composite keys, transaction time and paginated iterators as the peer provides them
+        chaincodeStub.getTxTimestamp.returns({ seconds: 1700000000, nanos: 0 }); // 2023-11-14T22:13:20Z
+        chaincodeStub.getTxID.returns('tx1');
+        chaincodeStub.createCompositeKey.callsFake((objectType, attributes) =>
+            `\u0000${objectType}\u0000${attributes.map((attribute) => `${attribute}\u0000`).join('')}`);
+        chaincodeStub.splitCompositeKey.callsFake((key) => {
+            const [objectType, ...attributes] = key.split('\u0000').slice(1, -1);
+            return { objectType, attributes };
+        });
+        chaincodeStub.getStateByRangeWithPagination.callsFake(async (startKey, endKey, pageSize, bookmark) => {
+            const keys = Object.keys(chaincodeStub.states || {}).filter((key) => !key.startsWith('\u0000'));
+            return paginate(chaincodeStub.states || {}, keys, pageSize, bookmark);
+        });
+        chaincodeStub.getStateByPartialCompositeKeyWithPagination.callsFake(async (objectType, attributes, pageSize, bookmark) => {
+            const prefix = chaincodeStub.createCompositeKey(objectType, attributes);
+            const keys = Object.keys(chaincodeStub.states || {}).filter((key) => key.startsWith(prefix));
+            return paginate(chaincodeStub.states || {}, keys, pageSize, bookmark);
+        });
     });
 
     it('should create an integrity record', async () => {
@@ -119,4 +154,42 @@ describe('Integrity Smart Contract Tests', () => {
 
         expect(record).to.be.undefined;
     });
-});
\ No newline at end of file
+
+    // Pagination, batches and anchors are tested in smart_contracts/common; these check this contract's wiring.
+    // Anchoring is wired the same way in every contract and is checked in the availability tests only.
+    describe('Shared query and batch modules', () => {
+        it('should index and query records under the integrity docType', async () => {
+            const contract = new Integrity();
+            await contract.CreateIntegrityRecord(context, 'R1', 'Operational', 0, 100, 'A1');
+            await contract.CreateIntegrityRecord(context, 'R2', 'Operational', 0, 100, 'B2');
+
+            const all = JSON.parse(await contract.GetAllIntegrityRecordsPage(context, '', ''));
+            expect(all.records.map((record) => record.RID)).to.eql(['R1', 'R2']);
+            const device = JSON.parse(await contract.GetIntegrityRecordsByDevice(context, 'A1', '', '', ''));
+            expect(device.records.map((record) => record.RID)).to.eql(['R1']);
+
+            chaincodeStub.getQueryResultWithPagination.callsFake(async () => paginate({}, [], 50, ''));
+            await contract.QueryIntegrityRecordsPage(context, '', '', '');
+            expect(JSON.parse(chaincodeStub.getQueryResultWithPagination.firstCall.args[0]).selector).to.eql({ docType: 'integrity' });
+        });
+
+        it('should remove a deleted record from the device index', async () => {
+            const contract = new Integrity();
+            await contract.CreateIntegrityRecord(context, 'R1', 'Operational', 0, 100, 'A1');
+            await contract.DeleteIntegrityRecord(context, 'R1');
+
+            const device = JSON.parse(await contract.GetIntegrityRecordsByDevice(context, 'A1', '', '', ''));
+            expect(device.fetchedRecordsCount).to.equal(0);
+        });
+
+        it('should batch readings under the integrity docType', async () => {
+            const contract = new Integrity();
+            const reading = { rid: '1700000000000', device_id: '0A', seq: 1, integrity_flag: 0 };
+
+            const result = JSON.parse(await contract.PutReadingsBatch(context, JSON.stringify([reading])));
+            expect(result.results[0].key).to.equal('\u0000docType~device~time~seq\u0000integrity\u00000A\u00002023-11-14T22:13:20.000Z\u00001\u0000');
+            const page = JSON.parse(await contract.GetReadingsByDevice(context, '0A', '', ''));
+            expect(page.records.map((stored) => stored.docType)).to.eql(['integrityReading']);
+        });
+    });
+});
@@ -4,6 +4,21 @@
 const stringify = require('json-stringify-deterministic');
 const sortKeysRecursive = require('sort-keys-recursive');
 const { Contract } = require('fabric-contract-api');
+const { getRangePage, getDevicePage, getQueryPage, putIndexEntry } = require('./pagination');
+const { putReadingsBatch, getReadingsPage } = require('./readings');
+const { putAnchor, readAnchor, verifyReading } = require('./anchors');
+
+const DOC_TYPE = 'mobility';
+// Fields a batched reading must carry besides device_id
+const REQUIRED_READING_FIELDS = [];
+
+// Counter increments are written as deltas under rid~counter~txid instead of
+// rewriting the record, so concurrent increments of one RID touch disjoint keys
+// and do not fail MVCC validation. Reads add the pending deltas to the stored
+// values; CompactCounters folds them into the record and deletes them.
+const COUNTER_INDEX = 'rid~counter~txid';
+const COUNTERS = ['Attempts', 'SecurityIncidents'];
+const MAX_COMPACTION_DELTAS = 10000; // Deltas folded per CompactCounters transaction
 
 class Mobility extends Contract {
     /**
@@ -28,15 +43,15 @@ class Mobility extends Contract {
         ];
 
         for (const asset of assets) {
-            asset.docType = 'mobility';
+            asset.docType = DOC_TYPE;
             await ctx.stub.putState(asset.RID, Buffer.from(stringify(sortKeysRecursive(asset))));
         }
     }
 
     /**
-     * Create a new mobility record
+     * Create a new mobility record; deviceId (optional, defaults to the RID) feeds the device index
      */
-    async CreateMobility(ctx, rid, location, geoFence, attempts = 0, securityIncidents = 0) {
+    async CreateMobility(ctx, rid, location, geoFence, attempts = 0, securityIncidents = 0, deviceId = '') {
         if (!rid || !location || !geoFence) {
             throw new Error('RID, Location, and GeoFence must be provided.');
         }
@@ -51,10 +66,11 @@ class Mobility extends Contract {
             GeoFence: geoFence,
             Attempts: parseInt(attempts),
             SecurityIncidents: parseInt(securityIncidents),
-            docType: 'mobility',
+            docType: DOC_TYPE,
         };
 
         await ctx.stub.putState(rid, Buffer.from(stringify(sortKeysRecursive(record))));
+        await putIndexEntry(ctx, DOC_TYPE, deviceId, rid);
         return JSON.stringify(record);
     }
 
@@ -66,7 +82,9 @@ class Mobility extends Contract {
         if (!recordBytes || recordBytes.length === 0) {
             throw new Error(`Mobility record with RID ${rid} does not exist.`);
         }
-        return recordBytes.toString();
+        const record = JSON.parse(recordBytes.toString());
+        const deltasByRid = await this.pendingDeltas(ctx, [rid]);
+        return JSON.stringify(applyDeltas(record, deltasByRid.get(rid)));
     }
 
     /**
@@ -83,48 +101,72 @@ class Mobility extends Contract {
             GeoFence: geoFence,
             Attempts: parseInt(attempts),
             SecurityIncidents: parseInt(securityIncidents),
-            docType: 'mobility',
+            docType: DOC_TYPE,
         };
 
+        // The new values are absolute, so pending increments are superseded
+        const deltasByRid = await this.pendingDeltas(ctx, [rid]);
+        for (const key of deltasByRid.has(rid) ? deltasByRid.get(rid).keys : []) {
+            await ctx.stub.deleteState(key);
+        }
         await ctx.stub.putState(rid, Buffer.from(stringify(sortKeysRecursive(updatedRecord))));
         return JSON.stringify(updatedRecord);
     }
 
     /**
-     * Increment attempts for a location breach
+     * Increment attempts for a location breach; returns the delta written
      */
     async IncrementAttempts(ctx, rid) {
-        const currentRecord = await this.ReadMobility(ctx, rid);
-        const parsedRecord = JSON.parse(currentRecord);
-
-        parsedRecord.Attempts += 1;
-        await ctx.stub.putState(rid, Buffer.from(stringify(sortKeysRecursive(parsedRecord))));
-        return JSON.stringify(parsedRecord);
+        return this.addCounterDelta(ctx, rid, 'Attempts');
     }
 
     /**
-     * Increment security incidents for a location
+     * Increment security incidents for a location; returns the delta written
      */
     async IncrementSecurityIncidents(ctx, rid) {
-        const currentRecord = await this.ReadMobility(ctx, rid);
-        const parsedRecord = JSON.parse(currentRecord);
+        return this.addCounterDelta(ctx, rid, 'SecurityIncidents');
+    }
+
+    /**
+     * Fold pending counter deltas into their records and delete them.
+     * With a RID only that record is compacted; without one, up to
+     * MAX_COMPACTION_DELTAS deltas across all records are.
+     */
+    async CompactCounters(ctx, rid) {
+        const deltasByRid = await this.pendingDeltas(ctx, rid ? [rid] : [], MAX_COMPACTION_DELTAS);
+        let compacted = 0;
+
+        for (const [recordId, deltas] of deltasByRid) {
+            const recordBytes = await ctx.stub.getState(recordId);
+            if (recordBytes && recordBytes.length > 0) {
+                const record = JSON.parse(recordBytes.toString());
+                for (const counter of COUNTERS) {
+                    record[counter] += deltas.totals[counter];
+                }
+                await ctx.stub.putState(recordId, Buffer.from(stringify(sortKeysRecursive(record))));
+            }
+            // Deltas of a record that no longer exists are dropped
+            for (const key of deltas.keys) {
+                await ctx.stub.deleteState(key);
+            }
+            compacted += deltas.keys.length;
+        }
 
-        parsedRecord.SecurityIncidents += 1;
-        await ctx.stub.putState(rid, Buffer.from(stringify(sorted(parsedRecord))));
-        return JSON.stringify(parsedRecord);
+        return JSON.stringify({ records: deltasByRid.size, deltas: compacted });
     }
 
     /**
      * Retrieve all mobility records
      */
     async GetAllMobility(ctx) {
+        const deltasByRid = await this.pendingDeltas(ctx, []);
         const iterator = await ctx.stub.getStateByRange('', '');
         const result = [];
         for await (const record of iterator) {
             const strValue = Buffer.from(record.value).toString('utf8');
             try {
                 const parsedRecord = JSON.parse(strValue);
-                result.push(parsedRecord);
+                result.push(applyDeltas(parsedRecord, deltasByRid.get(parsedRecord.RID)));
             } catch (e) {
                 console.error('Error parsing state:', e);
             }
@@ -132,6 +174,66 @@ class Mobility extends Contract {
         return JSON.stringify(result);
     }
 
+    /**
+     * Retrieve one page of mobility records; pass the returned bookmark for the next
+     */
+    async GetAllMobilityPage(ctx, pageSize, bookmark) {
+        return this.withPendingDeltas(ctx, await getRangePage(ctx, pageSize, bookmark));
+    }
+
+    /**
+     * Retrieve one page of a device's mobility records, optionally within one hour bucket
+     */
+    async GetMobilityByDevice(ctx, deviceId, bucket, pageSize, bookmark) {
+        return this.withPendingDeltas(ctx, await getDevicePage(ctx, DOC_TYPE, deviceId, bucket, pageSize, bookmark));
+    }
+
+    /**
+     * Retrieve one page of a CouchDB rich query over mobility records
+     */
+    async QueryMobilityPage(ctx, selectorJSON, pageSize, bookmark) {
+        return this.withPendingDeltas(ctx, await getQueryPage(ctx, DOC_TYPE, selectorJSON, pageSize, bookmark));
+    }
+
+    /**
+     * Store a batch of mobility readings in one transaction; invalid readings are reported, not fatal
+     */
+    async PutReadingsBatch(ctx, readingsJSON) {
+        return putReadingsBatch(ctx, DOC_TYPE, readingsJSON, REQUIRED_READING_FIELDS);
+    }
+
+    /**
+     * Retrieve one page of a device's batched readings, oldest first
+     */
+    async GetReadingsByDevice(ctx, deviceId, pageSize, bookmark) {
+        return getReadingsPage(ctx, DOC_TYPE, deviceId, pageSize, bookmark);
+    }
+
+    /**
+     * Anchor the Merkle root of one window of off-chain readings (write-once)
+     */
+    async AnchorWindow(ctx, anchorJSON) {
+        return putAnchor(ctx, DOC_TYPE, anchorJSON);
+    }
+
+    /**
+     * Read the anchor of one window
+     */
+    async ReadAnchor(ctx, windowId) {
+        const anchor = await readAnchor(ctx, DOC_TYPE, windowId);
+        if (!anchor) {
+            throw new Error(`Window ${windowId} is not anchored`);
+        }
+        return JSON.stringify(anchor);
+    }
+
+    /**
+     * Check an off-chain reading and its inclusion proof against the anchored root
+     */
+    async VerifyReading(ctx, windowId, line, proofJSON) {
+        return verifyReading(ctx, DOC_TYPE, windowId, line, proofJSON);
+    }
+
     /**
      * Mobility existence check utility
      */
@@ -139,6 +241,65 @@ class Mobility extends Contract {
         const recordBytes = await ctx.stub.getState(rid);
         return recordBytes && recordBytes.length > 0;
     }
+
+    /**
+     * Write one +1 delta for a counter. Only the record's existence is read,
+     * so concurrent increments conflict with updates and compaction, not with each other.
+     */
+    async addCounterDelta(ctx, rid, counter) {
+        if (!(await this.MobilityExists(ctx, rid))) {
+            throw new Error(`Mobility record with RID ${rid} does not exist.`);
+        }
+
+        const txId = ctx.stub.getTxID();
+        const deltaKey = ctx.stub.createCompositeKey(COUNTER_INDEX, [rid, counter, txId]);
+        await ctx.stub.putState(deltaKey, Buffer.from('1'));
+        return JSON.stringify({ RID: rid, Counter: counter, Delta: 1, TxID: txId });
+    }
+
+    /**
+     * Pending deltas per RID, as { keys, totals }, for the given RID or all of them
+     */
+    async pendingDeltas(ctx, attributes, limit = Infinity) {
+        const deltasByRid = new Map();
+        const iterator = await ctx.stub.getStateByPartialCompositeKey(COUNTER_INDEX, attributes);
+        let count = 0;
+
+        for await (const delta of iterator) {
+            if (count++ >= limit) {
+                break;
+            }
+            const { attributes: [rid, counter] } = ctx.stub.splitCompositeKey(delta.key);
+            if (!deltasByRid.has(rid)) {
+                deltasByRid.set(rid, { keys: [], totals: { Attempts: 0, SecurityIncidents: 0 } });
+            }
+            const deltas = deltasByRid.get(rid);
+            deltas.keys.push(delta.key);
+            deltas.totals[counter] += parseInt(Buffer.from(delta.value).toString('utf8'));
+        }
+        return deltasByRid;
+    }
+
+    /**
+     * Add pending deltas to the records of a query page
+     */
+    async withPendingDeltas(ctx, pageJSON) {
+        const page = JSON.parse(pageJSON);
+        for (const record of page.records) {
+            const deltasByRid = await this.pendingDeltas(ctx, [record.RID]);
+            applyDeltas(record, deltasByRid.get(record.RID));
+        }
+        return JSON.stringify(page);
+    }
+}
+
+function applyDeltas(record, deltas) {
+    if (deltas) {
+        for (const counter of COUNTERS) {
+            record[counter] += deltas.totals[counter];
+        }
+    }
+    return record;
 }
 
 module.exports = Mobility;
\ No newline at end of file
@@ -0,0 +1,169 @@
+// Generated from smart_contracts/common/lib/pagination.js by common/sync.js; edit that file, not this copy.
+'use strict';
+
+/*
+ * Paginated ledger queries shared by the sensor contracts.
+ *
+ * Records stay keyed by RID. Each create also writes an index entry under the
+ * composite key docType~device~bucket~rid, where bucket is the hour of the
+ * transaction timestamp, so one device's readings (optionally within one
+ * hour) are found by a key range scan instead of a full world-state scan.
+ * A docType~rid entry points back at the index entry, so deleting a record
+ * can delete its index entry too.
+ * Rich queries use the CouchDB index in META-INF/statedb/couchdb/indexes.
+ */
+
+const INDEX_NAME = 'docType~device~bucket~rid';
+const INDEX_REF = 'docType~rid';
+const DEFAULT_PAGE_SIZE = 50;
+const MAX_PAGE_SIZE = 500;
+const BUCKET_SECONDS = 3600;
+const DOC_TYPE_INDEX = ['indexDocTypeDoc', 'indexDocType'];
+
+/**
+ * Clamp a page size argument to 1..MAX_PAGE_SIZE
+ * @param {String|Number} pageSize - Requested page size, default when empty
+ */
+function toPageSize(pageSize) {
+    const size = parseInt(pageSize);
+    if (!size || size < 1) {
+        return DEFAULT_PAGE_SIZE;
+    }
+    return Math.min(size, MAX_PAGE_SIZE);
+}
+
+/**
+ * Hour bucket of the transaction timestamp, e.g. "2025-03-01T14".
+ * Endorsers agree on it because it comes from the proposal, not the clock.
+ * @param {Context} ctx - The transaction context
+ */
+function timeBucket(ctx) {
+    const timestamp = ctx.stub.getTxTimestamp();
+    const seconds = typeof timestamp.seconds === 'object' ? timestamp.seconds.toNumber() : Number(timestamp.seconds);
+    const start = Math.floor(seconds / BUCKET_SECONDS) * BUCKET_SECONDS;
+    return new Date(start * 1000).toISOString().slice(0, 13);
+}
+
+/**
+ * Write the docType~device~bucket~rid index entry for a new record
+ * @param {Context} ctx - The transaction context
+ * @param {String} docType - Record type
+ * @param {String} deviceId - Reporting device, the RID when unknown
+ * @param {String} rid - Record key
+ */
+async function putIndexEntry(ctx, docType, deviceId, rid) {
+    const indexKey = ctx.stub.createCompositeKey(INDEX_NAME, [docType, deviceId || rid, timeBucket(ctx), rid]);
+    await ctx.stub.putState(indexKey, Buffer.from('\u0000'));
+    await ctx.stub.putState(ctx.stub.createCompositeKey(INDEX_REF, [docType, rid]), Buffer.from(indexKey));
+}
+
+/**
+ * Delete a record's index entry, for the contracts' Delete* transactions
+ * @param {Context} ctx - The transaction context
+ * @param {String} docType - Record type
+ * @param {String} rid - Record key
+ */
+async function deleteIndexEntry(ctx, docType, rid) {
+    const refKey = ctx.stub.createCompositeKey(INDEX_REF, [docType, rid]);
+    const indexKey = await ctx.stub.getState(refKey);
+    if (!indexKey || indexKey.length === 0) {
+        return; // Written before index entries had a back reference; getDevicePage skips it
+    }
+    await ctx.stub.deleteState(indexKey.toString());
+    await ctx.stub.deleteState(refKey);
+}
+
+/**
+ * Drain a query iterator into parsed records, skipping values that are not JSON
+ * @param {Iterator} iterator - State query iterator
+ * @param {Function} toRecord - Maps one result to record bytes, or null to skip it
+ */
+async function collect(iterator, toRecord) {
+    const records = [];
+    let result = await iterator.next();
+
+    while (!result.done) {
+        const bytes = await toRecord(result.value);
+        if (bytes && bytes.length > 0) {
+            try {
+                records.push(JSON.parse(bytes.toString()));
+            } catch (err) {
+                console.error('Skipping unparsable state:', err.message);
+            }
+        }
+        result = await iterator.next();
+    }
+
+    await iterator.close();
+    return records;
+}
+
+function toPage(records, metadata) {
+    return JSON.stringify({
+        records,
+        fetchedRecordsCount: metadata.fetchedRecordsCount,
+        bookmark: metadata.bookmark,
+    });
+}
+
+/**
+ * One page of every record, in key order
+ * @param {Context} ctx - The transaction context
+ * @param {String} pageSize - Records per page
+ * @param {String} bookmark - Bookmark from the previous page, empty for the first
+ */
+async function getRangePage(ctx, pageSize, bookmark) {
+    const { iterator, metadata } = await ctx.stub.getStateByRangeWithPagination(
+        '', '', toPageSize(pageSize), bookmark || '');
+    return toPage(await collect(iterator, (result) => result.value), metadata);
+}
+
+/**
+ * One page of a device's records, optionally limited to one hour bucket
+ * @param {Context} ctx - The transaction context
+ * @param {String} docType - Record type
+ * @param {String} deviceId - Reporting device
+ * @param {String} bucket - Hour bucket ("YYYY-MM-DDTHH"), empty for all
+ * @param {String} pageSize - Records per page
+ * @param {String} bookmark - Bookmark from the previous page, empty for the first
+ */
+async function getDevicePage(ctx, docType, deviceId, bucket, pageSize, bookmark) {
+    const attributes = bucket ? [docType, deviceId, bucket] : [docType, deviceId];
+    const { iterator, metadata } = await ctx.stub.getStateByPartialCompositeKeyWithPagination(
+        INDEX_NAME, attributes, toPageSize(pageSize), bookmark || '');
+
+    return toPage(await collect(iterator, (result) => {
+        const { attributes: keyParts } = ctx.stub.splitCompositeKey(result.key);
+        return ctx.stub.getState(keyParts[3]); // Empty if deleted without its entry
+    }), metadata);
+}
+
+/**
+ * One page of a CouchDB rich query over one docType (CouchDB state database only)
+ * @param {Context} ctx - The transaction context
+ * @param {String} docType - Record type
+ * @param {String} selectorJSON - Extra CouchDB selector fields as JSON, may be empty
+ * @param {String} pageSize - Records per page
+ * @param {String} bookmark - Bookmark from the previous page, empty for the first
+ */
+async function getQueryPage(ctx, docType, selectorJSON, pageSize, bookmark) {
+    const selector = Object.assign(selectorJSON ? JSON.parse(selectorJSON) : {}, { docType });
+    const query = JSON.stringify({ selector, use_index: DOC_TYPE_INDEX });
+    const { iterator, metadata } = await ctx.stub.getQueryResultWithPagination(
+        query, toPageSize(pageSize), bookmark || '');
+    return toPage(await collect(iterator, (result) => result.value), metadata);
+}
+
+module.exports = {
+    INDEX_NAME,
+    INDEX_REF,
+    DEFAULT_PAGE_SIZE,
+    MAX_PAGE_SIZE,
+    toPageSize,
+    timeBucket,
+    putIndexEntry,
+    deleteIndexEntry,
+    getRangePage,
+    getDevicePage,
+    getQueryPage,
+};
@@ -16,6 +16,22 @@ const { Context } = require('fabric-contract-api');
 const { ChaincodeStub } = require('fabric-shim');
 const Mobility = require('../lib/mobility.js'); // The Mobility smart contract
 
+// Page through sorted keys the way the peer does: the bookmark is the first key of the next page
+function paginate(states, keys, pageSize, bookmark) {
+    const sorted = keys.sort();
+    const start = bookmark ? sorted.indexOf(bookmark) : 0;
+    const page = sorted.slice(start, start + pageSize);
+    const results = page.map((key) => ({ key, value: states[key] }));
+    let i = 0;
+    return {
+        iterator: {
+            next: async () => (i < results.length ? { value: results[i++], done: false } : { done: true }),
+            close: async () => {},
+        },
+        metadata: { fetchedRecordsCount: page.length, bookmark: sorted[start + pageSize] || '' },
+    };
+}
+
 describe('Mobility Chaincode Unit Tests', () => {
     let transactionContext, chaincodeStub, testAsset;
 
@@ -44,6 +60,7 @@ describe('Mobility Chaincode Unit Tests', () => {
             function* internalGetStateByRange() {
                 if (chaincodeStub.states) {
                     for (let key in chaincodeStub.states) {
+                        if (key.startsWith('\u0000')) continue; // Composite keys are not in range scans
                         yield { value: chaincodeStub.states[key] };
                     }
                 }
@@ -59,6 +76,35 @@ describe('Mobility Chaincode Unit Tests', () => {
             Attempts: 0,
             SecurityIncidents: 0,
         };
+
+        // Composite keys, transaction time and paginated iterators as the peer provides them
+        chaincodeStub.getTxTimestamp.returns({ seconds: 1700000000, nanos: 0 }); // 2023-11-14T22:13:20Z
+        chaincodeStub.createCompositeKey.callsFake((objectType, attributes) =>
+            `\u0000${objectType}\u0000${attributes.map((attribute) => `${attribute}\u0000`).join('')}`);
+        chaincodeStub.splitCompositeKey.callsFake((key) => {
+            const [objectType, ...attributes] = key.split('\u0000').slice(1, -1);
+            return { objectType, attributes };
+        });
+        chaincodeStub.getStateByRangeWithPagination.callsFake(async (startKey, endKey, pageSize, bookmark) => {
+            const keys = Object.keys(chaincodeStub.states || {}).filter((key) => !key.startsWith('\u0000'));
+            return paginate(chaincodeStub.states || {}, keys, pageSize, bookmark);
+        });
+        let txCount = 0;
+        chaincodeStub.getTxID.callsFake(() => `tx${txCount++}`); // Every increment runs in its own transaction
+        chaincodeStub.getStateByPartialCompositeKey.callsFake(async (objectType, attributes) => {
+            const prefix = chaincodeStub.createCompositeKey(objectType, attributes);
+            const keys = Object.keys(chaincodeStub.states || {}).filter((key) => key.startsWith(prefix)).sort();
+            return (function* () {
+                for (const key of keys) {
+                    yield { key, value: chaincodeStub.states[key] };
+                }
+            })();
+        });
+        chaincodeStub.getStateByPartialCompositeKeyWithPagination.callsFake(async (objectType, attributes, pageSize, bookmark) => {
+            const prefix = chaincodeStub.createCompositeKey(objectType, attributes);
+            const keys = Object.keys(chaincodeStub.states || {}).filter((key) => key.startsWith(prefix));
+            return paginate(chaincodeStub.states || {}, keys, pageSize, bookmark);
+        });
     });
 
     describe('Initialize Mobility Ledger (InitLedger)', () => {
@@ -204,9 +250,32 @@ describe('Mobility Chaincode Unit Tests', () => {
             );
 
             await mobility.IncrementAttempts(transactionContext, testAsset.RID);
-            const record = JSON.parse(await chaincodeStub.getState(testAsset.RID));
+            const record = JSON.parse(await mobility.ReadMobility(transactionContext, testAsset.RID));
             expect(record.Attempts).to.equal(1);
         });
+
+        it('should write a delta key instead of rewriting the record', async () => {
+            const mobility = new Mobility();
+            await mobility.CreateMobility(transactionContext, testAsset.RID, testAsset.Location, testAsset.GeoFence, 0, 0);
+            const storedBefore = chaincodeStub.states[testAsset.RID];
+
+            await mobility.IncrementAttempts(transactionContext, testAsset.RID);
+            await mobility.IncrementAttempts(transactionContext, testAsset.RID);
+
+            expect(chaincodeStub.states[testAsset.RID]).to.equal(storedBefore);
+            const deltaKeys = Object.keys(chaincodeStub.states).filter((key) => key.startsWith('\u0000rid~counter~txid'));
+            expect(deltaKeys).to.have.lengthOf(2);
+        });
+
+        it('should fail to increment a non-existent record', async () => {
+            const mobility = new Mobility();
+            try {
+                await mobility.IncrementAttempts(transactionContext, 'unknown_record');
+                chai.assert.fail('Expected error not thrown');
+            } catch (err) {
+                expect(err.message).to.equal('Mobility record with RID unknown_record does not exist.');
+            }
+        });
     });
 
     describe('IncrementSecurityIncidents', () => {
@@ -222,8 +291,53 @@ describe('Mobility Chaincode Unit Tests', () => {
             );
 
             await mobility.IncrementSecurityIncidents(transactionContext, testAsset.RID);
-            const record = JSON.parse(await chaincodeStub.getState(testAsset.RID));
+            const record = JSON.parse(await mobility.ReadMobility(transactionContext, testAsset.RID));
             expect(record.SecurityIncidents).to.equal(1);
+            expect(record.Attempts).to.equal(0);
+        });
+    });
+
+    describe('CompactCounters', () => {
+        it('should fold pending deltas into the record and delete them', async () => {
+            const mobility = new Mobility();
+            await mobility.CreateMobility(transactionContext, '301', 'Zone A', 'Restricted', 2, 0);
+            await mobility.CreateMobility(transactionContext, '302', 'Zone B', 'Allowed', 0, 0);
+            for (let i = 0; i < 3; i++) {
+                await mobility.IncrementAttempts(transactionContext, '301');
+            }
+            await mobility.IncrementSecurityIncidents(transactionContext, '302');
+
+            const summary = JSON.parse(await mobility.CompactCounters(transactionContext, ''));
+            expect(summary).to.eql({ records: 2, deltas: 4 });
+
+            const stored = JSON.parse(chaincodeStub.states['301'].toString());
+            expect(stored.Attempts).to.equal(5);
+            expect(JSON.parse(chaincodeStub.states['302'].toString()).SecurityIncidents).to.equal(1);
+            expect(Object.keys(chaincodeStub.states).filter((key) => key.startsWith('\u0000rid~counter~txid'))).to.have.lengthOf(0);
+            expect(JSON.parse(await mobility.ReadMobility(transactionContext, '301')).Attempts).to.equal(5);
+        });
+
+        it('should only compact the given RID', async () => {
+            const mobility = new Mobility();
+            await mobility.CreateMobility(transactionContext, '301', 'Zone A', 'Restricted', 0, 0);
+            await mobility.CreateMobility(transactionContext, '302', 'Zone B', 'Allowed', 0, 0);
+            await mobility.IncrementAttempts(transactionContext, '301');
+            await mobility.IncrementAttempts(transactionContext, '302');
+
+            await mobility.CompactCounters(transactionContext, '301');
+
+            expect(JSON.parse(chaincodeStub.states['302'].toString()).Attempts).to.equal(0);
+            const all = JSON.parse(await mobility.GetAllMobility(transactionContext));
+            expect(all.map((record) => record.Attempts)).to.eql([1, 1]);
+        });
+
+        it('should let an update supersede pending increments', async () => {
+            const mobility = new Mobility();
+            await mobility.CreateMobility(transactionContext, '301', 'Zone A', 'Restricted', 0, 0);
+            await mobility.IncrementAttempts(transactionContext, '301');
+
+            await mobility.UpdateMobility(transactionContext, '301', 'Zone A', 'Restricted', 10, 0);
+            expect(JSON.parse(await mobility.ReadMobility(transactionContext, '301')).Attempts).to.equal(10);
         });
     });
 
@@ -266,4 +380,33 @@ describe('Mobility Chaincode Unit Tests', () => {
             expect(allRecords.length).to.equal(2);
         });
     });
-});
\ No newline at end of file
+
+    // Pagination, batches and anchors are tested in smart_contracts/common; these check this contract's wiring.
+    // Anchoring is wired the same way in every contract and is checked in the availability tests only.
+    describe('Shared query and batch modules', () => {
+        it('should index and query records under the mobility docType', async () => {
+            const contract = new Mobility();
+            await contract.CreateMobility(transactionContext, 'R1', 'Zone A', 'Restricted', 0, 0, 'A1');
+            await contract.CreateMobility(transactionContext, 'R2', 'Zone A', 'Restricted', 0, 0, 'B2');
+
+            const all = JSON.parse(await contract.GetAllMobilityPage(transactionContext, '', ''));
+            expect(all.records.map((record) => record.RID)).to.eql(['R1', 'R2']);
+            const device = JSON.parse(await contract.GetMobilityByDevice(transactionContext, 'A1', '', '', ''));
+            expect(device.records.map((record) => record.RID)).to.eql(['R1']);
+
+            chaincodeStub.getQueryResultWithPagination.callsFake(async () => paginate({}, [], 50, ''));
+            await contract.QueryMobilityPage(transactionContext, '', '', '');
+            expect(JSON.parse(chaincodeStub.getQueryResultWithPagination.firstCall.args[0]).selector).to.eql({ docType: 'mobility' });
+        });
+
+        it('should batch readings under the mobility docType', async () => {
+            const contract = new Mobility();
+            const reading = { rid: '1700000000000', device_id: '0A', seq: 1, log_id: 3 };
+
+            const result = JSON.parse(await contract.PutReadingsBatch(transactionContext, JSON.stringify([reading])));
+            expect(result.results[0].key).to.equal('\u0000docType~device~time~seq\u0000mobility\u00000A\u00002023-11-14T22:13:20.000Z\u00001\u0000');
+            const page = JSON.parse(await contract.GetReadingsByDevice(transactionContext, '0A', '', ''));
+            expect(page.records.map((stored) => stored.docType)).to.eql(['mobilityReading']);
+        });
+    });
+});
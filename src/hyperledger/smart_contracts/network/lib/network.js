@@ -10,6 +10,13 @@
 const stringify = require('json-stringify-deterministic');
 const sortKeysRecursive = require('sort-keys-recursive');
 const { Contract } = require('fabric-contract-api');
+const { getRangePage, getDevicePage, getQueryPage, putIndexEntry, deleteIndexEntry } = require('./pagination');
+const { putReadingsBatch, getReadingsPage } = require('./readings');
+const { putAnchor, readAnchor, verifyReading } = require('./anchors');
+
+const DOC_TYPE = 'network-sensor';
+// Fields a batched reading must carry besides device_id
+const REQUIRED_READING_FIELDS = [];
 
 class Network extends Contract {
     // Initialize the network ledger with default records
@@ -22,13 +29,13 @@ class Network extends Contract {
         ];
 
         for (const record of networkRecords) {
-            record.docType = 'network-sensor';
+            record.docType = DOC_TYPE;
             await ctx.stub.putState(record.RID, Buffer.from(stringify(sortKeysRecursive(record))));
         }
     }
 
-    // Create a new network performance record
-    async CreateNetworkRecord(ctx, rid, latency, packetLoss, bandwidth) {
+    // Create a new network performance record; deviceId (optional, defaults to the RID) feeds the device index
+    async CreateNetworkRecord(ctx, rid, latency, packetLoss, bandwidth, deviceId) {
         const exists = await this.RecordExists(ctx, rid);
         if (exists) {
             throw new Error(`Network record ${rid} already exists.`);
@@ -38,9 +45,10 @@ class Network extends Contract {
             Latency: parseFloat(latency),
             PacketLoss: parseFloat(packetLoss),
             Bandwidth: parseInt(bandwidth),
-            docType: 'network-sensor',
+            docType: DOC_TYPE,
         };
         await ctx.stub.putState(rid, Buffer.from(stringify(sortKeysRecursive(record))));
+        await putIndexEntry(ctx, DOC_TYPE, deviceId, rid);
         return JSON.stringify(record);
     }
 
@@ -64,7 +72,7 @@ class Network extends Contract {
             Latency: parseFloat(latency),
             PacketLoss: parseFloat(packetLoss),
             Bandwidth: parseInt(bandwidth),
-            docType: 'network-sensor',
+            docType: DOC_TYPE,
         };
         await ctx.stub.putState(rid, Buffer.from(stringify(sortKeysRecursive(updatedRecord))));
         return JSON.stringify(updatedRecord);
@@ -77,6 +85,7 @@ class Network extends Contract {
             throw new Error(`Network record ${rid} does not exist.`);
         }
         await ctx.stub.deleteState(rid);
+        await deleteIndexEntry(ctx, DOC_TYPE, rid);
     }
 
     // Check if a network record exists
@@ -100,6 +109,50 @@ class Network extends Contract {
         }
         return JSON.stringify(allResults);
     }
+
+    // One page of network records in key order; pass the returned bookmark for the next
+    async GetAllNetworkRecordsPage(ctx, pageSize, bookmark) {
+        return getRangePage(ctx, pageSize, bookmark);
+    }
+
+    // One page of a device's network records, optionally within one hour bucket
+    async GetNetworkRecordsByDevice(ctx, deviceId, bucket, pageSize, bookmark) {
+        return getDevicePage(ctx, DOC_TYPE, deviceId, bucket, pageSize, bookmark);
+    }
+
+    // One page of a CouchDB rich query over network records
+    async QueryNetworkRecordsPage(ctx, selectorJSON, pageSize, bookmark) {
+        return getQueryPage(ctx, DOC_TYPE, selectorJSON, pageSize, bookmark);
+    }
+
+    // Store a batch of readings in one transaction; invalid readings are reported, not fatal
+    async PutReadingsBatch(ctx, readingsJSON) {
+        return putReadingsBatch(ctx, DOC_TYPE, readingsJSON, REQUIRED_READING_FIELDS);
+    }
+
+    // One page of a device's batched readings, oldest first
+    async GetReadingsByDevice(ctx, deviceId, pageSize, bookmark) {
+        return getReadingsPage(ctx, DOC_TYPE, deviceId, pageSize, bookmark);
+    }
+
+    // Anchor the Merkle root of one window of off-chain readings (write-once)
+    async AnchorWindow(ctx, anchorJSON) {
+        return putAnchor(ctx, DOC_TYPE, anchorJSON);
+    }
+
+    // Read the anchor of one window
+    async ReadAnchor(ctx, windowId) {
+        const anchor = await readAnchor(ctx, DOC_TYPE, windowId);
+        if (!anchor) {
+            throw new Error(`Window ${windowId} is not anchored`);
+        }
+        return JSON.stringify(anchor);
+    }
+
+    // Check an off-chain reading and its inclusion proof against the anchored root
+    async VerifyReading(ctx, windowId, line, proofJSON) {
+        return verifyReading(ctx, DOC_TYPE, windowId, line, proofJSON);
+    }
 }
 
 module.exports = Network;
\ No newline at end of file
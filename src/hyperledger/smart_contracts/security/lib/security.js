@@ -10,6 +10,13 @@
 const stringify = require('json-stringify-deterministic');
 const sortKeysRecursive = require('sort-keys-recursive');
 const {Contract} = require('fabric-contract-api');
+const {getRangePage, getDevicePage, getQueryPage, putIndexEntry, deleteIndexEntry} = require('./pagination');
+const {putReadingsBatch, getReadingsPage} = require('./readings');
+const {putAnchor, readAnchor, verifyReading} = require('./anchors');
+
+const DOC_TYPE = 'security';
+// Fields a batched reading must carry besides device_id
+const REQUIRED_READING_FIELDS = ['breach_flag'];
 
 class Security extends Contract {
     async InitLedger(ctx) {
@@ -56,7 +63,7 @@ class Security extends Contract {
         }
     }
 
-    async CreateSecurityRecord(ctx, id, x, y, sp) {
+    async CreateSecurityRecord(ctx, id, x, y, sp, deviceId) {
         const exists = await this.AssetExists(ctx, id);
         if (exists) {
             throw new Error(`The security record ${id} already exists.`);
@@ -67,10 +74,11 @@ class Security extends Contract {
             Xco: x,
             Yco: y,
             Speed: sp,
-            docType: 'security',
+            docType: DOC_TYPE,
         };
 
         await ctx.stub.putState(id, Buffer.from(stringify(sortKeysRecursive(asset))));
+        await putIndexEntry(ctx, DOC_TYPE, deviceId, id);
         return JSON.stringify(asset);
     }
 
@@ -93,7 +101,7 @@ class Security extends Contract {
             Xco: x,
             Yco: y,
             Speed: sp,
-            docType: 'security',
+            docType: DOC_TYPE,
         };
 
         await ctx.stub.putState(id, Buffer.from(stringify(sortKeysRecursive(updatedAsset))));
@@ -106,6 +114,7 @@ class Security extends Contract {
             throw new Error(`The security record ${id} does not exist.`);
         }
         await ctx.stub.deleteState(id);
+        await deleteIndexEntry(ctx, DOC_TYPE, id);
     }
 
     async AssetExists(ctx, id) {
@@ -134,6 +143,42 @@ class Security extends Contract {
         await iterator.close();
         return JSON.stringify(allResults);
     }
+
+    async GetAllSecurityRecordsPage(ctx, pageSize, bookmark) {
+        return getRangePage(ctx, pageSize, bookmark);
+    }
+
+    async GetSecurityRecordsByDevice(ctx, deviceId, bucket, pageSize, bookmark) {
+        return getDevicePage(ctx, DOC_TYPE, deviceId, bucket, pageSize, bookmark);
+    }
+
+    async QuerySecurityRecordsPage(ctx, selectorJSON, pageSize, bookmark) {
+        return getQueryPage(ctx, DOC_TYPE, selectorJSON, pageSize, bookmark);
+    }
+
+    async PutReadingsBatch(ctx, readingsJSON) {
+        return putReadingsBatch(ctx, DOC_TYPE, readingsJSON, REQUIRED_READING_FIELDS);
+    }
+
+    async GetReadingsByDevice(ctx, deviceId, pageSize, bookmark) {
+        return getReadingsPage(ctx, DOC_TYPE, deviceId, pageSize, bookmark);
+    }
+
+    async AnchorWindow(ctx, anchorJSON) {
+        return putAnchor(ctx, DOC_TYPE, anchorJSON);
+    }
+
+    async ReadAnchor(ctx, windowId) {
+        const anchor = await readAnchor(ctx, DOC_TYPE, windowId);
+        if (!anchor) {
+            throw new Error(`Window ${windowId} is not anchored`);
+        }
+        return JSON.stringify(anchor);
+    }
+
+    async VerifyReading(ctx, windowId, line, proofJSON) {
+        return verifyReading(ctx, DOC_TYPE, windowId, line, proofJSON);
+    }
 }
 
 module.exports = Security;
@@ -19,6 +19,22 @@ const Security = require('../lib/security.js');
 let assert = sinon.assert;
 chai.use(sinonChai);
 
+// Page through sorted keys the way the peer does: the bookmark is the first key of the next page
+function paginate(states, keys, pageSize, bookmark) {
+    const sorted = keys.sort();
+    const start = bookmark ? sorted.indexOf(bookmark) : 0;
+    const page = sorted.slice(start, start + pageSize);
+    const results = page.map((key) => ({ key, value: states[key] }));
+    let i = 0;
+    return {
+        iterator: {
+            next: async () => (i < results.length ? { value: results[i++], done: false } : { done: true }),
+            close: async () => {},
+        },
+        metadata: { fetchedRecordsCount: page.length, bookmark: sorted[start + pageSize] || '' },
+    };
+}
+
 describe('Security Chaincode Tests', () => {
     let transactionContext, chaincodeStub, asset;
 
@@ -50,6 +66,7 @@ describe('Security Chaincode Tests', () => {
             async function* internalGetStateByRange() {
                 if (chaincodeStub.states) {
                     for (const key of Object.keys(chaincodeStub.states).sort()) {
+                        if (key.startsWith('\u0000')) continue; // Composite keys are not in range scans
                         yield {key, value: chaincodeStub.states[key]};
                     }
                 }
@@ -64,6 +81,25 @@ describe('Security Chaincode Tests', () => {
             BreachAttempts: 0,
             AlertsTriggered: 0,
         };
+
+        // Composite keys, transaction time and paginated iterators as the peer provides them
+        chaincodeStub.getTxTimestamp.returns({ seconds: 1700000000, nanos: 0 }); // 2023-11-14T22:13:20Z
+        chaincodeStub.getTxID.returns('tx1');
+        chaincodeStub.createCompositeKey.callsFake((objectType, attributes) =>
+            `\u0000${objectType}\u0000${attributes.map((attribute) => `${attribute}\u0000`).join('')}`);
+        chaincodeStub.splitCompositeKey.callsFake((key) => {
+            const [objectType, ...attributes] = key.split('\u0000').slice(1, -1);
+            return { objectType, attributes };
+        });
+        chaincodeStub.getStateByRangeWithPagination.callsFake(async (startKey, endKey, pageSize, bookmark) => {
+            const keys = Object.keys(chaincodeStub.states || {}).filter((key) => !key.startsWith('\u0000'));
+            return paginate(chaincodeStub.states || {}, keys, pageSize, bookmark);
+        });
+        chaincodeStub.getStateByPartialCompositeKeyWithPagination.callsFake(async (objectType, attributes, pageSize, bookmark) => {
+            const prefix = chaincodeStub.createCompositeKey(objectType, attributes);
+            const keys = Object.keys(chaincodeStub.states || {}).filter((key) => key.startsWith(prefix));
+            return paginate(chaincodeStub.states || {}, keys, pageSize, bookmark);
+        });
     });
 
     describe('Test InitLedger', () => {
@@ -139,4 +175,45 @@ describe('Security Chaincode Tests', () => {
             expect(ret).to.be.undefined;
         });
     });
+
+    // Pagination, batches and anchors are tested in smart_contracts/common; these check this contract's wiring.
+    // Anchoring is wired the same way in every contract and is checked in the availability tests only.
+    describe('Shared query and batch modules', () => {
+        it('should index and query records under the security docType', async () => {
+            const contract = new Security();
+            await contract.CreateSecurityRecord(transactionContext, 'R1', 1, 2, 3, 'A1');
+            await contract.CreateSecurityRecord(transactionContext, 'R2', 1, 2, 3, 'B2');
+
+            const all = JSON.parse(await contract.GetAllSecurityRecordsPage(transactionContext, '', ''));
+            expect(all.records.map((record) => record.ID)).to.eql(['R1', 'R2']);
+            const device = JSON.parse(await contract.GetSecurityRecordsByDevice(transactionContext, 'A1', '', '', ''));
+            expect(device.records.map((record) => record.ID)).to.eql(['R1']);
+
+            chaincodeStub.getQueryResultWithPagination.callsFake(async () => paginate({}, [], 50, ''));
+            await contract.QuerySecurityRecordsPage(transactionContext, '', '', '');
+            expect(JSON.parse(chaincodeStub.getQueryResultWithPagination.firstCall.args[0]).selector).to.eql({ docType: 'security' });
+        });
+
+        it('should remove a deleted record from the device index', async () => {
+            const contract = new Security();
+            await contract.CreateSecurityRecord(transactionContext, 'R1', 1, 2, 3, 'A1');
+            await contract.DeleteSecurityRecord(transactionContext, 'R1');
+
+            const device = JSON.parse(await contract.GetSecurityRecordsByDevice(transactionContext, 'A1', '', '', ''));
+            expect(device.fetchedRecordsCount).to.equal(0);
+        });
+
+        it('should batch readings under the security docType', async () => {
+            const contract = new Security();
+            const reading = { rid: '1700000000000', device_id: '0A', seq: 1, breach_flag: 0 };
+
+            const result = JSON.parse(await contract.PutReadingsBatch(transactionContext, JSON.stringify([reading])));
+            expect(result.results[0].key).to.equal('\u0000docType~device~time~seq\u0000security\u00000A\u00002023-11-14T22:13:20.000Z\u00001\u0000');
+            const page = JSON.parse(await contract.GetReadingsByDevice(transactionContext, '0A', '', ''));
+            expect(page.records.map((stored) => stored.docType)).to.eql(['securityReading']);
+
+            const missing = JSON.parse(await contract.PutReadingsBatch(transactionContext, JSON.stringify([{ device_id: '0A' }])));
+            expect(missing.results[0].error).to.equal('Missing field(s): breach_flag');
+        });
+    });
 });
@@ -0,0 +1,227 @@
+'use strict';
+
+// ------------------------------------------------------------
+// Configuration and Constants
+// ------------------------------------------------------------
+const BORDER_ROUTER_ID = 1;
+const MATCH_WINDOW_US = 30 * 1000 * 1000; // Sends older than this are counted as lost
+
+// CC2420 supply currents on the Z1 (mA) and supply voltage (V)
+const RADIO_TX_MA = 17.4;
+const RADIO_RX_MA = 18.8;
+const SUPPLY_V = 3.0;
+const CPU_ACTIVE_MA = 4.0; // MSP430F2617 at 8 MHz
+
+const TELEMETRY_FLAG_BATCH = 0x80;
+const HOP_TRAILER_HEX_LEN = 10; // Border router receive time appended to telemetry frames
+const FRAME_VERSIONS = ['b1', 'b2']; // Plain and authenticated (telemetry-auth.h) frames
+
+// ------------------------------------------------------------
+// Function: Parse Cooja Test Log Lines
+// ------------------------------------------------------------
+// Lines are "time_us:mote_id:message" as written by the scene's script.
+function parseLogLine(line) {
+  const match = /^(\d+):(\d+):(.*)$/.exec(line);
+  if (!match) {
+    return null;
+  }
+  return { time: Number(match[1]), id: Number(match[2]), msg: match[3] };
+}
+
+// Samples carried by one forwarded payload (batch frames hold a count byte,
+// after the body length byte in authenticated frames)
+function samplesInPayload(hex) {
+  const version = FRAME_VERSIONS.indexOf(hex.slice(0, 2));
+  const countAt = 6 + 2 * version;
+  if (version >= 0 && hex.length >= countAt + 2 && (parseInt(hex.slice(2, 4), 16) & TELEMETRY_FLAG_BATCH)) {
+    return parseInt(hex.slice(countAt, countAt + 2), 16);
+  }
+  return 1;
+}
+
+// The hop trailer differs between border routers, so copies compare without
+// it; it is not sent over the air either
+function withoutHopTrailer(hex) {
+  return FRAME_VERSIONS.includes(hex.slice(0, 2)) && hex.length > HOP_TRAILER_HEX_LEN
+    ? hex.slice(0, -HOP_TRAILER_HEX_LEN) : hex;
+}
+
+function percentile(sorted, p) {
+  if (sorted.length === 0) {
+    return 0;
+  }
+  return sorted[Math.min(sorted.length - 1, Math.floor((p / 100) * sorted.length))];
+}
+
+// ------------------------------------------------------------
+// Function: Parse PowerTracker Radio Statistics
+// ------------------------------------------------------------
+// Lines look like "Z1 4 ON 123456 us 1.23 %"; the AVG summary is skipped.
+function parseRadioStatistics(lines) {
+  const motes = new Map();
+  for (const line of lines) {
+    const match = /(\d+)\s+(MONITORED|ON|TX|RX|INT)\s+(\d+)\s+us/.exec(line);
+    if (!match || line.startsWith('AVG')) {
+      continue;
+    }
+    const id = Number(match[1]);
+    if (!motes.has(id)) {
+      motes.set(id, {});
+    }
+    motes.get(id)[match[2]] = Number(match[3]);
+  }
+  return motes;
+}
+
+// ------------------------------------------------------------
+// Function: Parse Border Router Energy Lines
+// ------------------------------------------------------------
+// "E <iid> <cpu ms> <lpm ms> <tx ms> <listen ms>" totals, printed for motes
+// built with the energy monitor. The most complete line per node is kept.
+function parseEnergyLine(msg, totals) {
+  const match = /^E ([0-9a-f]{4}) (\d+) (\d+) (\d+) (\d+)$/.exec(msg.trim());
+  if (!match) {
+    return false;
+  }
+  const [cpu, lpm, tx, listen] = match.slice(2).map(Number);
+  const previous = totals.get(match[1]);
+  if (!previous || cpu + lpm >= previous.cpu + previous.lpm) {
+    totals.set(match[1], { cpu, lpm, tx, listen });
+  }
+  return true;
+}
+
+// Z1 motes put the whole mote ID in the last two MAC bytes, so a node's IID
+// ends in it as 4 hex digits; scenes above 255 motes need more than the low byte
+function senderKey(id) {
+  return (id & 0xffff).toString(16).padStart(4, '0');
+}
+
+// ------------------------------------------------------------
+// Function: Compute Benchmark Metrics from a Test Log
+// ------------------------------------------------------------
+// Counts datagrams sensors sent and the border routers in rootIds forwarded
+// ("I" lines) after the warm-up, matches them per sender in FIFO order for
+// latency and converts PowerTracker radio times into energy. Latency is also
+// reported separately for the motes in urgentIds (security and integrity
+// sensors). A payload forwarded again within the match window, e.g. by a
+// second root, is counted as a duplicate rather than a delivery. Payload
+// bytes per delivery give the airtime cost of the frame format, and the
+// energy monitor's totals (when the sensors are built with it) the CPU time.
+function computeMetrics(logText, { warmupS, durationS, urgentIds = new Set(), rootIds = new Set([BORDER_ROUTER_ID]) }) {
+  const lines = logText.split('\n');
+  const warmupUs = warmupS * 1e6;
+  const pending = new Map(); // sender key -> send times
+  const urgentKeys = new Set([...urgentIds].map(senderKey));
+  const forwardedAt = new Map(); // sender key + payload -> last forward time
+  const latencies = [];
+  const urgentLatencies = [];
+  let sent = 0;
+  let delivered = 0;
+  let duplicates = 0;
+  let samples = 0;
+  let payloadBytes = 0;
+  let powerLines = null;
+  const energy = new Map(); // iid -> Energest totals
+
+  for (const line of lines) {
+    if (powerLines) {
+      if (line.startsWith('END')) {
+        break;
+      }
+      powerLines.push(line);
+      continue;
+    }
+    if (line.startsWith('POWER')) {
+      powerLines = [];
+      continue;
+    }
+
+    const entry = parseLogLine(line);
+    if (entry && rootIds.has(entry.id) && parseEnergyLine(entry.msg, energy)) {
+      continue; // Totals since boot, so the warm-up is kept
+    }
+    if (!entry || entry.time < warmupUs) {
+      continue;
+    }
+
+    if (!rootIds.has(entry.id) && entry.msg.includes('Sent ')) {
+      const key = senderKey(entry.id);
+      sent++;
+      if (!pending.has(key)) {
+        pending.set(key, []);
+      }
+      pending.get(key).push(entry.time);
+      continue;
+    }
+
+    const forwarded = /^I ([0-9a-f]{16}) \d+ ([0-9a-f]*)$/.exec(entry.msg.trim());
+    if (rootIds.has(entry.id) && forwarded) {
+      const key = forwarded[1].slice(12);
+      const copyKey = `${key}/${withoutHopTrailer(forwarded[2])}`;
+      const previous = forwardedAt.get(copyKey);
+      forwardedAt.set(copyKey, entry.time);
+      if (previous !== undefined && entry.time - previous <= MATCH_WINDOW_US) {
+        duplicates++;
+        continue;
+      }
+
+      delivered++;
+      samples += samplesInPayload(forwarded[2]);
+      payloadBytes += withoutHopTrailer(forwarded[2]).length / 2;
+
+      const queue = pending.get(key) || [];
+      while (queue.length > 0 && entry.time - queue[0] > MATCH_WINDOW_US) {
+        queue.shift();
+      }
+      if (queue.length > 0 && queue[0] <= entry.time) {
+        const latency = (entry.time - queue.shift()) / 1000;
+        latencies.push(latency);
+        if (urgentKeys.has(key)) {
+          urgentLatencies.push(latency);
+        }
+      }
+    }
+  }
+
+  const radio = parseRadioStatistics(powerLines || []);
+  const sensorRadio = [...radio.entries()].filter(([id]) => !rootIds.has(id)).map(([, r]) => r);
+  const average = (values) => (values.length ? values.reduce((a, b) => a + b, 0) / values.length : 0);
+  const dutyCycle = (key) => average(sensorRadio.map((r) => (r.MONITORED ? (100 * (r[key] || 0)) / r.MONITORED : 0)));
+  const energyMj = average(sensorRadio.map((r) =>
+    ((r.TX || 0) * RADIO_TX_MA + Math.max(0, (r.ON || 0) - (r.TX || 0)) * RADIO_RX_MA) * SUPPLY_V / 1e6));
+  const cpuTotals = [...energy.values()];
+  const cpuPct = average(cpuTotals.map((e) => (e.cpu + e.lpm ? (100 * e.cpu) / (e.cpu + e.lpm) : 0)));
+  const cpuEnergyMj = average(cpuTotals.map((e) => (e.cpu * CPU_ACTIVE_MA * SUPPLY_V) / 1000));
+
+  latencies.sort((a, b) => a - b);
+  urgentLatencies.sort((a, b) => a - b);
+  const windowS = Math.max(1, durationS - warmupS);
+
+  return {
+    sent,
+    delivered,
+    duplicates,
+    samples,
+    payload_bytes_avg: delivered ? payloadBytes / delivered : 0,
+    pdr: sent ? delivered / sent : 0,
+    delivered_pps: delivered / windowS,
+    latency_avg_ms: average(latencies),
+    latency_p95_ms: percentile(latencies, 95),
+    latency_urgent_avg_ms: average(urgentLatencies),
+    latency_urgent_p95_ms: percentile(urgentLatencies, 95),
+    radio_on_pct: dutyCycle('ON'),
+    radio_tx_pct: dutyCycle('TX'),
+    radio_rx_pct: dutyCycle('RX'),
+    radio_energy_mj_per_mote: energyMj,
+    cpu_pct: cpuPct,
+    cpu_energy_mj_per_mote: cpuEnergyMj,
+  };
+}
+
+module.exports = {
+  parseLogLine,
+  parseRadioStatistics,
+  parseEnergyLine,
+  computeMetrics,
+};
@@ -0,0 +1,195 @@
+'use strict';
+
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const { MAC_MODES, AUTH_MODES, URGENT_ROLES, buildScene, requiredFirmware, roleOfMote } = require('./scene');
+const { computeMetrics } = require('./metrics');
+
+// ------------------------------------------------------------
+// Configuration and Constants
+// ------------------------------------------------------------
+const CONTIKI_NG = process.env.CONTIKI_NG || path.join(process.env.HOME || '', 'contiki-ng');
+const COOJA_JAR = process.env.COOJA_JAR || path.join(CONTIKI_NG, 'tools', 'cooja', 'dist', 'cooja.jar');
+const JAVA_HEAP = process.env.COOJA_HEAP || '4096m';
+
+const DEFAULTS = {
+  sizes: [10, 50, 100, 250, 500],
+  macs: ['csma'],
+  auths: ['off'],    // Frame authentication modes, 'off,on' compares them
+  roots: 1,          // Border routers, motes 1..roots
+  failRootAt: 0,     // Simulated second root 1 is removed at, 0 keeps it
+  seed: 987654,      // Same seed as configs/iot_security_simulation.csc
+  duration: 600,     // Simulated seconds per run
+  warmup: 120,       // Seconds ignored while RPL forms
+  out: path.join(__dirname, 'results'),
+  generateOnly: false,
+};
+
+const CSV_COLUMNS = [
+  'mac', 'auth', 'motes', 'roots', 'fail_root_at_s', 'seed', 'duration_s', 'warmup_s', 'sent', 'delivered',
+  'duplicates', 'samples', 'payload_bytes_avg', 'pdr',
+  'delivered_pps', 'latency_avg_ms', 'latency_p95_ms', 'latency_urgent_avg_ms',
+  'latency_urgent_p95_ms', 'radio_on_pct', 'radio_tx_pct',
+  'radio_rx_pct', 'radio_energy_mj_per_mote', 'cpu_pct', 'cpu_energy_mj_per_mote', 'wall_s',
+];
+
+// ------------------------------------------------------------
+// Function: Parse Command Line Options
+// ------------------------------------------------------------
+// --sizes 10,50 --macs csma,tsch --auth off,on --roots N --fail-root-at S --seed N
+// --duration S --warmup S --out DIR --generate-only
+function parseArgs(argv) {
+  const options = { ...DEFAULTS };
+  for (let i = 0; i < argv.length; i++) {
+    const value = argv[i + 1];
+    switch (argv[i]) {
+      case '--sizes': options.sizes = value.split(',').map(Number); i++; break;
+      case '--macs': options.macs = value.split(','); i++; break;
+      case '--auth': options.auths = value.split(','); i++; break;
+      case '--roots': options.roots = Number(value); i++; break;
+      case '--fail-root-at': options.failRootAt = Number(value); i++; break;
+      case '--seed': options.seed = Number(value); i++; break;
+      case '--duration': options.duration = Number(value); i++; break;
+      case '--warmup': options.warmup = Number(value); i++; break;
+      case '--out': options.out = path.resolve(value); i++; break;
+      case '--generate-only': options.generateOnly = true; break;
+      default: throw new Error(`Unknown option ${argv[i]}`);
+    }
+  }
+  if (options.warmup >= options.duration) {
+    throw new Error('Warm-up must be shorter than the run');
+  }
+  if (!(options.roots >= 1)) {
+    throw new Error('At least one border router is needed');
+  }
+  if (options.failRootAt > 0 && (options.roots < 2 || options.failRootAt >= options.duration)) {
+    throw new Error('Root failure needs a second root and must happen during the run');
+  }
+  const unknown = options.macs.filter((mac) => !MAC_MODES.includes(mac));
+  if (unknown.length > 0) {
+    throw new Error(`Unknown MAC ${unknown.join(', ')}, expected ${MAC_MODES.join(' or ')}`);
+  }
+  const unknownAuth = options.auths.filter((auth) => !AUTH_MODES.includes(auth));
+  if (unknownAuth.length > 0) {
+    throw new Error(`Unknown auth mode ${unknownAuth.join(', ')}, expected ${AUTH_MODES.join(' or ')}`);
+  }
+  return options;
+}
+
+// ------------------------------------------------------------
+// Function: Run One Headless Cooja Simulation
+// ------------------------------------------------------------
+// Cooja writes the script log to COOJA.testlog in its working directory.
+function runCooja(scenePath, runDir) {
+  const result = spawnSync('java', [
+    `-mx${JAVA_HEAP}`, '-jar', COOJA_JAR, `-nogui=${scenePath}`, `-contiki=${CONTIKI_NG}`,
+  ], { cwd: runDir, stdio: ['ignore', 'ignore', 'inherit'] });
+
+  if (result.error) {
+    throw result.error;
+  }
+  const logPath = path.join(runDir, 'COOJA.testlog');
+  if (!fs.existsSync(logPath)) {
+    throw new Error(`Cooja exited with status ${result.status} and wrote no test log`);
+  }
+  return fs.readFileSync(logPath, 'utf8');
+}
+
+function toCsvRow(row) {
+  return CSV_COLUMNS.map((column) => {
+    const value = row[column];
+    return typeof value === 'number' && !Number.isInteger(value) ? value.toFixed(4) : value;
+  }).join(',');
+}
+
+// ------------------------------------------------------------
+// Main Function: Generate, Run and Summarise Every Scale
+// ------------------------------------------------------------
+function main() {
+  const options = parseArgs(process.argv.slice(2));
+  const csvPath = path.join(options.out, `benchmark-seed-${options.seed}.csv`);
+  fs.mkdirSync(options.out, { recursive: true });
+
+  if (!options.generateOnly) {
+    const missing = requiredFirmware(options.macs, options.auths).filter((file) => !fs.existsSync(file)).concat(
+        fs.existsSync(COOJA_JAR) ? [] : [COOJA_JAR]);
+    if (missing.length > 0) {
+      console.error(`❌ Missing files:\n  ${missing.join('\n  ')}`);
+      process.exit(1);
+    }
+    fs.writeFileSync(csvPath, `${CSV_COLUMNS.join(',')}\n`);
+  }
+
+  // Each density is run with every MAC and auth mode back to back, so rows compare directly
+  const { roots, failRootAt } = options;
+  const rootIds = new Set(Array.from({ length: roots }, (_, i) => i + 1));
+  const runSuffix = (roots > 1 ? `-roots-${roots}` : '') + (failRootAt > 0 ? `-fail-${failRootAt}` : '');
+
+  for (const motes of options.sizes) {
+    const urgentIds = new Set();
+    for (let id = roots + 1; id <= motes + roots; id++) {
+      if (URGENT_ROLES.includes(roleOfMote(id, roots))) {
+        urgentIds.add(id);
+      }
+    }
+
+    for (const mac of options.macs) {
+      for (const auth of options.auths) {
+        const label = `${mac.toUpperCase()}${auth === 'on' ? ' + auth' : ''}`;
+        const runDir = path.join(options.out, `${mac}${auth === 'on' ? '-auth' : ''}-motes-${motes}${runSuffix}`);
+        const scenePath = path.join(runDir, 'scene.csc');
+        fs.mkdirSync(runDir, { recursive: true });
+        fs.writeFileSync(scenePath, buildScene({
+          motes, seed: options.seed, durationS: options.duration, mac, auth, roots, failRootAtS: failRootAt,
+        }));
+        console.log(`🧪 ${label} scene for ${motes} motes written to ${scenePath}`);
+
+        if (options.generateOnly) {
+          continue;
+        }
+
+        const started = Date.now();
+        const metrics = computeMetrics(runCooja(scenePath, runDir), {
+          warmupS: options.warmup,
+          durationS: options.duration,
+          urgentIds,
+          rootIds,
+        });
+        const row = {
+          mac,
+          auth,
+          motes,
+          roots,
+          fail_root_at_s: failRootAt,
+          seed: options.seed,
+          duration_s: options.duration,
+          warmup_s: options.warmup,
+          ...metrics,
+          wall_s: Math.round((Date.now() - started) / 1000),
+        };
+
+        fs.appendFileSync(csvPath, `${toCsvRow(row)}\n`);
+        console.log(`✅ ${label}, ${motes} motes: PDR ${(100 * row.pdr).toFixed(1)}%, ` +
+          `${row.delivered_pps.toFixed(2)} pkt/s, latency ${row.latency_avg_ms.toFixed(0)} ms ` +
+          `(urgent ${row.latency_urgent_avg_ms.toFixed(0)} ms), radio on ${row.radio_on_pct.toFixed(1)}%, ` +
+          `${row.payload_bytes_avg.toFixed(1)} B/frame, CPU ${row.cpu_pct.toFixed(2)}%`);
+      }
+    }
+  }
+
+  if (!options.generateOnly) {
+    console.log(`📄 Results written to ${csvPath}`);
+  }
+}
+
+if (require.main === module) {
+  try {
+    main();
+  } catch (error) {
+    console.error(`❌ Benchmark failed: ${error.message}`);
+    process.exit(1);
+  }
+}
+
+module.exports = { parseArgs };
@@ -0,0 +1,59 @@
+<?xml version="1.0" encoding="UTF-8"?>
+<simconf>
+  <!-- Generated by benchmark/run-benchmark.js, do not edit the scenes in results/ by hand -->
+  <project EXPORT="discard">[APPS_DIR]/mspsim</project>
+  <project EXPORT="discard">[APPS_DIR]/powertracker</project>
+
+  <!-- Simulation Configuration -->
+  <simulation>
+    <title>{{TITLE}}</title>
+    <randomseed>{{SEED}}</randomseed>
+    <motedelay_us>1000000</motedelay_us>
+    <radiomedium>
+      org.contikios.cooja.radiomediums.UDGM
+      <transmitting_range>{{TX_RANGE}}</transmitting_range>
+      <interference_range>{{INTERFERENCE_RANGE}}</interference_range>
+      <success_ratio_tx>{{SUCCESS_RATIO}}</success_ratio_tx>
+      <success_ratio_rx>{{SUCCESS_RATIO}}</success_ratio_rx>
+    </radiomedium>
+
+    <events>
+      <logoutput>40000</logoutput>
+    </events>
+
+{{MOTETYPES}}
+{{MOTES}}
+  </simulation>
+
+  <!-- Plugins -->
+  <plugin>
+    org.contikios.cooja.plugins.PowerTracker
+    <width>400</width>
+    <height>400</height>
+  </plugin>
+
+  <plugin>
+    org.contikios.cooja.plugins.ScriptRunner
+    <plugin_config>
+      <script>
+/* Log every mote line as "time:id:message" and dump radio statistics at the end */
+TIMEOUT({{DURATION_MS}}, log.log("POWER\n" + sim.getCooja().getStartedPlugin("PowerTracker").radioStatistics() + "\nEND\n"));
+{{FAILOVER}}
+
+while (true) {
+  if (msg.equals("fail-root")) {
+    /* Failover runs: take border router 1 out of the network */
+    log.log(time + ":0:Root 1 removed\n");
+    sim.removeMote(sim.getMoteWithID(1));
+  } else {
+    log.log(time + ":" + id + ":" + msg + "\n");
+  }
+  YIELD();
+}
+      </script>
+      <active>true</active>
+    </plugin_config>
+    <width>600</width>
+    <height>700</height>
+  </plugin>
+</simconf>
@@ -0,0 +1,175 @@
+'use strict';
+
+const fs = require('fs');
+const path = require('path');
+
+// ------------------------------------------------------------
+// Configuration and Constants
+// ------------------------------------------------------------
+const TEMPLATE_PATH = path.join(__dirname, 'scene-template.csc');
+const LAYOUT_PATH = path.join(__dirname, '..', 'configs', 'mobility_end_simulation.csv');
+const FIRMWARE_DIR = path.join(__dirname, '..', 'firmware');
+
+const TILE_MARGIN = 20; // Metres between repeated copies of the base layout
+
+// Sensor roles are assigned to motes round-robin after the border routers (motes 1..roots)
+const SENSOR_ROLES = ['security', 'integrity', 'availability', 'network', 'monitor'];
+
+// Roles whose reports use the urgent Orchestra slotframe in TSCH builds
+const URGENT_ROLES = ['security', 'integrity'];
+
+// MAC layers with a firmware set each: CSMA images are <name>.z1, TSCH + Orchestra <name>-tsch.z1
+const MAC_MODES = ['csma', 'tsch'];
+
+// Frame authentication: sensors built with TELEMETRY_CONF_AUTH carry an -auth suffix
+const AUTH_MODES = ['off', 'on'];
+
+// ------------------------------------------------------------
+// Function: Load the Base Layout
+// ------------------------------------------------------------
+// Reads node coordinates from the mobility scenario (Node_ID,Zone_ID,X,Y).
+function loadLayout(layoutPath = LAYOUT_PATH) {
+  return fs.readFileSync(layoutPath, 'utf8')
+      .trim()
+      .split('\n')
+      .slice(1)
+      .map((line) => {
+        const [, , x, y] = line.split(',').map(Number);
+        return { x, y };
+      });
+}
+
+// ------------------------------------------------------------
+// Function: Place N Sensor Motes
+// ------------------------------------------------------------
+// Repeats the base layout on a square grid of tiles until there are enough
+// positions, so density stays the same at every scale. A single border router
+// sits at the centre of the occupied area; several split it into equal
+// vertical strips with a root at the centre of each.
+function placeMotes(count, layout = loadLayout(), rootCount = 1) {
+  const width = Math.max(...layout.map((p) => p.x)) + TILE_MARGIN;
+  const height = Math.max(...layout.map((p) => p.y)) + TILE_MARGIN;
+  const tiles = Math.ceil(count / layout.length);
+  const columns = Math.ceil(Math.sqrt(tiles));
+  const rows = Math.ceil(tiles / columns);
+
+  const sensors = [];
+  for (let i = 0; i < count; i++) {
+    const tile = Math.floor(i / layout.length);
+    const base = layout[i % layout.length];
+    sensors.push({
+      x: base.x + (tile % columns) * width,
+      y: base.y + Math.floor(tile / columns) * height,
+    });
+  }
+
+  const usedColumns = Math.min(columns, tiles);
+  const roots = [];
+  for (let k = 0; k < rootCount; k++) {
+    roots.push({ x: ((k + 0.5) * usedColumns * width) / rootCount, y: (rows * height) / 2 });
+  }
+  return { roots, sensors };
+}
+
+// Role of a sensor mote; sensor IDs start after the border routers
+function roleOfMote(id, rootCount = 1) {
+  return SENSOR_ROLES[(id - rootCount - 1) % SENSOR_ROLES.length];
+}
+
+// The border router forwards authenticated frames unchanged, so it has no -auth image
+function firmwareFile(name, mac, auth = 'off') {
+  return `${name}${mac === 'tsch' ? '-tsch' : ''}${auth === 'on' && name !== 'border-router' ? '-auth' : ''}.z1`;
+}
+
+// ------------------------------------------------------------
+// Function: Render Scene Fragments
+// ------------------------------------------------------------
+function renderMotetype(identifier, description, firmware) {
+  return `    <motetype>
+      org.contikios.cooja.mspmote.Z1MoteType
+      <identifier>${identifier}</identifier>
+      <description>${description}</description>
+      <firmware EXPORT="copy">${path.join(FIRMWARE_DIR, firmware)}</firmware>
+      <moteinterface>org.contikios.cooja.interfaces.Position</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.RimeAddress</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.IPAddress</moteinterface>
+      <moteinterface>org.contikios.cooja.mspmote.interfaces.MspMoteID</moteinterface>
+      <moteinterface>org.contikios.cooja.mspmote.interfaces.MspSerial</moteinterface>
+    </motetype>`;
+}
+
+function renderMote(identifier, id, position) {
+  return `    <mote>
+      <motetype_identifier>${identifier}</motetype_identifier>
+      <interface_config>
+        org.contikios.cooja.interfaces.Position
+        <x>${position.x.toFixed(1)}</x>
+        <y>${position.y.toFixed(1)}</y>
+        <z>0</z>
+      </interface_config>
+      <interface_config>
+        org.contikios.cooja.mspmote.interfaces.MspMoteID
+        <id>${id}</id>
+      </interface_config>
+    </mote>`;
+}
+
+// ------------------------------------------------------------
+// Function: Build a Scene
+// ------------------------------------------------------------
+// Returns the .csc text for one benchmark run. Firmware images are expected
+// in simulation/firmware as border-router.z1 and <role>-sensor-node.z1, with
+// a -tsch suffix for the TSCH + Orchestra builds and an -auth suffix for
+// sensors sending authenticated frames. With failRootAtS, border router 1 is
+// removed at that time to measure failover to the other roots.
+function buildScene({
+  motes, seed, durationS, mac = 'csma', auth = 'off', roots = 1, failRootAtS = 0,
+  txRange = 75, interferenceRange = 100, successRatio = 0.9,
+}) {
+  const { roots: rootPositions, sensors } = placeMotes(motes, loadLayout(), roots);
+
+  const motetypes = [renderMotetype('border_router', 'RPL Border Router', firmwareFile('border-router', mac))]
+      .concat(SENSOR_ROLES.map((role) =>
+        renderMotetype(`${role}_sensor`, `${role} sensor node`, firmwareFile(`${role}-sensor-node`, mac, auth))));
+
+  const moteList = rootPositions.map((position, i) => renderMote('border_router', i + 1, position))
+      .concat(sensors.map((position, i) =>
+        renderMote(`${roleOfMote(i + roots + 1, roots)}_sensor`, i + roots + 1, position)));
+
+  const values = {
+    TITLE: `benchmark-${mac}-${auth === 'on' ? 'auth-' : ''}${motes}-motes-${roots}-roots-seed-${seed}`,
+    SEED: seed,
+    TX_RANGE: txRange.toFixed(1),
+    INTERFERENCE_RANGE: interferenceRange.toFixed(1),
+    SUCCESS_RATIO: successRatio,
+    DURATION_MS: durationS * 1000,
+    MOTETYPES: motetypes.join('\n'),
+    MOTES: moteList.join('\n'),
+    FAILOVER: failRootAtS > 0 ? `GENERATE_MSG(${failRootAtS * 1000}, "fail-root");` : '',
+  };
+
+  return fs.readFileSync(TEMPLATE_PATH, 'utf8')
+      .replace(/\{\{(\w+)\}\}/g, (match, key) => (key in values ? String(values[key]) : match));
+}
+
+// ------------------------------------------------------------
+// Function: List Firmware the Scenes Need
+// ------------------------------------------------------------
+function requiredFirmware(macs = ['csma'], auths = ['off']) {
+  const files = macs.flatMap((mac) => auths.flatMap((auth) => ['border-router']
+      .concat(SENSOR_ROLES.map((role) => `${role}-sensor-node`))
+      .map((name) => path.join(FIRMWARE_DIR, firmwareFile(name, mac, auth)))));
+  return [...new Set(files)];
+}
+
+module.exports = {
+  SENSOR_ROLES,
+  URGENT_ROLES,
+  MAC_MODES,
+  AUTH_MODES,
+  roleOfMote,
+  loadLayout,
+  placeMotes,
+  buildScene,
+  requiredFirmware,
+};
@@ -4,26 +4,328 @@
 #include "net/netstack.h"
 #include "sys/log.h"
 #include "global_resources.h"
+#include "telemetry.h"
 #include "net/ipv6/simple-udp.h"
+#include "lib/list.h"
+#include "lib/memb.h"
+#if MAC_CONF_WITH_TSCH
+#include "net/mac/tsch/tsch.h"
+#endif
 #include <stdbool.h>
+#include <string.h>
 
 #define LOG_MODULE "Border Router"
+#ifdef BORDER_ROUTER_CONF_LOG_LEVEL
+#define LOG_LEVEL BORDER_ROUTER_CONF_LOG_LEVEL   // LOG_LEVEL_DBG enables per-packet logging
+#else
 #define LOG_LEVEL LOG_LEVEL_INFO
+#endif
 
 #define UDP_PORT 1234
 #define RPL_JOIN_TIMEOUT (120 * CLOCK_SECOND) // Increased timeout for RPL network to form
 
+/* Ingest packet pool: received datagrams wait here until forwarded */
+#ifdef INGEST_CONF_POOL_SIZE
+#define INGEST_POOL_SIZE INGEST_CONF_POOL_SIZE
+#else
+#define INGEST_POOL_SIZE 8
+#endif
+
+#ifdef INGEST_CONF_PAYLOAD_MAX
+#define INGEST_PAYLOAD_MAX INGEST_CONF_PAYLOAD_MAX
+#else
+#define INGEST_PAYLOAD_MAX TELEMETRY_MAX_FRAME
+#endif
+
+#define INGEST_COLLECTOR_PORT_FIRST 8843         // Sensor collector ports, one per role
+#define INGEST_COLLECTOR_PORT_LAST 8847
+#define INGEST_COLLECTOR_PORTS (INGEST_COLLECTOR_PORT_LAST - INGEST_COLLECTOR_PORT_FIRST + 1)
+#define INGEST_FORWARD_BATCH 4                  // Packets forwarded per scheduler turn
+#define INGEST_STATS_INTERVAL (60 * CLOCK_SECOND) // Drop counter report period
+
+/* Congestion back-channel: ask known senders to slow down when the pool overflows */
+#ifdef INGEST_CONF_CONGESTION_SLOWDOWN
+#define INGEST_CONGESTION_SLOWDOWN INGEST_CONF_CONGESTION_SLOWDOWN
+#else
+#define INGEST_CONGESTION_SLOWDOWN 4             // Report interval multiplier requested
+#endif
+#define INGEST_CONGESTION_HOLD_S 120             // Seconds each notice applies
+#define INGEST_CONGESTION_HOLDOFF (30 * CLOCK_SECOND) // Minimum time between notices
+#define INGEST_SENSOR_PORT 5555                  // Sensor runtime's local port
+
+/* Per-node statistics table */
+#ifdef NODE_STATS_CONF_MAX_NODES
+#define NODE_STATS_MAX_NODES NODE_STATS_CONF_MAX_NODES
+#else
+#define NODE_STATS_MAX_NODES 16
+#endif
+
+#ifdef NODE_STATS_CONF_INTERVAL
+#define NODE_STATS_INTERVAL NODE_STATS_CONF_INTERVAL
+#else
+#define NODE_STATS_INTERVAL (30 * CLOCK_SECOND)  // Sampler and dump period
+#endif
+
+#define NODE_STATS_PORT 5688                     // UDP port answering table queries
+#define NODE_STATS_PER_REPLY 8                   // Entries per query reply
+#define NODE_STATS_ENTRY_LEN 16                  // Encoded bytes per entry
+
+/* A received datagram waiting in the ingest pool */
+struct ingest_packet {
+    struct ingest_packet *next;
+    uip_ipaddr_t sender;
+    uint16_t sender_port;
+    uint16_t receiver_port;     // Collector port the datagram was sent to, which names the role
+    uint16_t len;
+    uint32_t received_ms;       // Network clock at reception, forwarded as the hop trailer
+    uint8_t data[INGEST_PAYLOAD_MAX];
+};
+
+MEMB(ingest_pool, struct ingest_packet, INGEST_POOL_SIZE);
+LIST(ingest_queue);
+
+/* Ingest counters, reported periodically by the forwarder */
+static uint32_t ingest_received;
+static uint32_t ingest_forwarded;
+static uint32_t ingest_dropped_full;
+static uint32_t ingest_dropped_oversize;
+
+static struct simple_udp_connection collector_conns[INGEST_COLLECTOR_PORTS];
+
+/* Ingest and radio counters for one source address */
+struct node_stats {
+    uip_ipaddr_t addr;
+    uint32_t packets;
+    uint32_t bytes;
+    clock_time_t last_seen;
+    clock_time_t last_gap;      // Previous inter-arrival time
+    clock_time_t jitter;        // Smoothed inter-arrival jitter (RFC 3550 style)
+    uint16_t last_seq[TELEMETRY_SENSOR_ENERGY]; // Per sensor type: each role numbers its own samples
+    uint16_t seq_gaps;          // Samples missing according to sequence numbers
+    uint32_t energy_ms[4];      // Reported CPU, LPM, TX and listen time (energy-monitor.c)
+    uint8_t has_energy;
+    uint8_t has_seq;            // Bit (type - 1) set once last_seq[type - 1] holds a sample
+    uint8_t used;
+};
+
+static struct node_stats node_table[NODE_STATS_MAX_NODES];
+static struct simple_udp_connection stats_conn;
+
 /* Process Declarations */
 PROCESS(border_router_process, "Contiki-NG Border Router");
 PROCESS(configure_network_process, "Configure RPL Network");
 PROCESS(monitor_rpl_nodes_process, "Monitor RPL Nodes");
+PROCESS(ingest_forward_process, "Ingest Forwarder");
 AUTOSTART_PROCESSES(&border_router_process);
 
+/*---------------------------------------------------------------------------*/
+/* Find the table entry for an address, reusing the least recently seen slot */
+static struct node_stats *node_stats_lookup(const uip_ipaddr_t *addr) {
+    struct node_stats *victim = &node_table[0];
+    uint8_t i;
+
+    for (i = 0; i < NODE_STATS_MAX_NODES; i++) {
+        if (node_table[i].used && uip_ipaddr_cmp(&node_table[i].addr, addr)) {
+            return &node_table[i];
+        }
+        if (!node_table[i].used) {
+            victim = &node_table[i];
+        } else if (victim->used && node_table[i].last_seen < victim->last_seen) {
+            victim = &node_table[i];
+        }
+    }
+
+    memset(victim, 0, sizeof(*victim));
+    uip_ipaddr_copy(&victim->addr, addr);
+    victim->used = 1;
+    return victim;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Track sequence gaps of one role using 16-bit serial number arithmetic */
+static void node_stats_track_seq(struct node_stats *stats, uint8_t sensor_type, uint16_t seq) {
+    uint8_t bit;
+    uint16_t delta;
+
+    if (sensor_type == 0 || sensor_type > TELEMETRY_SENSOR_ENERGY) {
+        return;
+    }
+    bit = 1 << (sensor_type - 1);
+    if (stats->has_seq & bit) {
+        delta = seq - stats->last_seq[sensor_type - 1];
+        if (delta == 0 || delta >= 0x8000) {
+            return;     // Duplicate or reordered sample
+        }
+        stats->seq_gaps += delta - 1;
+    }
+    stats->last_seq[sensor_type - 1] = seq;
+    stats->has_seq |= bit;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Account one received datagram */
+static void node_stats_update(const uip_ipaddr_t *addr, const uint8_t *data, uint16_t datalen) {
+    struct node_stats *stats = node_stats_lookup(addr);
+    clock_time_t now = clock_time();
+    clock_time_t gap, deviation;
+    struct telemetry_reader reader;
+    const uint8_t *fields;
+    uint8_t fields_len;
+    uint32_t seq, value;
+    uint8_t i;
+
+    if (stats->packets > 0) {
+        gap = now - stats->last_seen;
+        if (stats->packets > 1) {
+            deviation = gap > stats->last_gap ? gap - stats->last_gap : stats->last_gap - gap;
+            stats->jitter += (deviation - stats->jitter) / 16;
+        }
+        stats->last_gap = gap;
+    }
+
+    stats->packets++;
+    stats->bytes += datalen;
+    stats->last_seen = now;
+
+    if (telemetry_reader_init(&reader, data, datalen)) {
+        while (telemetry_reader_next(&reader, &fields, &fields_len)) {
+            if (telemetry_get_field(fields, fields_len, TELEMETRY_FIELD_SEQ, &seq)) {
+                node_stats_track_seq(stats, data[1] & TELEMETRY_SENSOR_MASK, (uint16_t)seq);
+            }
+            if ((data[1] & TELEMETRY_SENSOR_MASK) != TELEMETRY_SENSOR_ENERGY) {
+                continue;
+            }
+            for (i = 0; i < 4; i++) {
+                if (telemetry_get_field(fields, fields_len, TELEMETRY_FIELD_CPU_MS + i, &value)) {
+                    stats->energy_ms[i] += value;
+                }
+            }
+            stats->has_energy = 1;
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Convert clock ticks to milliseconds, saturating at 16 bits */
+static uint16_t ticks_to_ms16(clock_time_t ticks) {
+    uint32_t ms = (uint32_t)ticks * 1000 / CLOCK_SECOND;
+    return ms > 0xFFFF ? 0xFFFF : (uint16_t)ms;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Print the table to the serial uplink, one "S" line per node plus "E" energy totals */
+static void node_stats_dump(void) {
+    clock_time_t now = clock_time();
+    uint8_t i;
+
+    /* Format: "S <iid> <packets> <bytes> <jitter ms> <seq gaps> <seconds since last seen>" */
+    for (i = 0; i < NODE_STATS_MAX_NODES; i++) {
+        const struct node_stats *stats = &node_table[i];
+        if (!stats->used) {
+            continue;
+        }
+        printf("S %02x%02x %lu %lu %u %u %lu\n",
+               stats->addr.u8[14], stats->addr.u8[15],
+               (unsigned long)stats->packets, (unsigned long)stats->bytes,
+               ticks_to_ms16(stats->jitter), stats->seq_gaps,
+               (unsigned long)((now - stats->last_seen) / CLOCK_SECOND));
+
+        /* Format: "E <iid> <cpu ms> <lpm ms> <tx ms> <listen ms>", totals since first record */
+        if (stats->has_energy) {
+            printf("E %02x%02x %lu %lu %lu %lu\n",
+                   stats->addr.u8[14], stats->addr.u8[15],
+                   (unsigned long)stats->energy_ms[0], (unsigned long)stats->energy_ms[1],
+                   (unsigned long)stats->energy_ms[2], (unsigned long)stats->energy_ms[3]);
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Tell every known sender to slow down; sensors listen on their local port */
+static void send_congestion_notice(void) {
+    uint8_t buf[TELEMETRY_HEADER_LEN + 2 * (1 + TELEMETRY_MAX_VALUE_LEN)];
+    struct telemetry_frame frame;
+    uint8_t i, notified = 0;
+
+    telemetry_begin(&frame, buf, sizeof(buf), TELEMETRY_SENSOR_CONTROL, 0);
+    telemetry_put(&frame, TELEMETRY_FIELD_SLOWDOWN, INGEST_CONGESTION_SLOWDOWN);
+    telemetry_put(&frame, TELEMETRY_FIELD_HOLD_S, INGEST_CONGESTION_HOLD_S);
+
+    for (i = 0; i < NODE_STATS_MAX_NODES; i++) {
+        if (node_table[i].used) {
+            simple_udp_sendto_port(&stats_conn, buf, frame.len, &node_table[i].addr, INGEST_SENSOR_PORT);
+            notified++;
+        }
+    }
+    LOG_WARN("Ingest pool overflowing, asked %u nodes to slow down x%u\n", notified, INGEST_CONGESTION_SLOWDOWN);
+}
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Answer a table query. The request's first byte is the starting slot; the
+ * reply holds the slot to ask for next, the table size and up to
+ * NODE_STATS_PER_REPLY big-endian entries:
+ * iid(2) packets(4) bytes(4) jitter_ms(2) gaps(2) age_s(2).
+ */
+static void stats_rx_callback(struct simple_udp_connection *c,
+                              const uip_ipaddr_t *sender_addr,
+                              uint16_t sender_port,
+                              const uip_ipaddr_t *receiver_addr,
+                              uint16_t receiver_port,
+                              const uint8_t *data,
+                              uint16_t datalen) {
+    static uint8_t reply[2 + NODE_STATS_PER_REPLY * NODE_STATS_ENTRY_LEN];
+    clock_time_t now = clock_time();
+    uint8_t start = datalen > 0 ? data[0] : 0;
+    uint16_t len = 2;
+    clock_time_t age_s;
+    uint16_t age;
+    uint8_t i, sent = 0;
+
+    reply[1] = NODE_STATS_MAX_NODES;
+
+    for (i = start; i < NODE_STATS_MAX_NODES && sent < NODE_STATS_PER_REPLY; i++) {
+        const struct node_stats *stats = &node_table[i];
+        uint8_t *entry = &reply[len];
+        if (!stats->used) {
+            continue;
+        }
+
+        age_s = (now - stats->last_seen) / CLOCK_SECOND;
+        age = age_s > 0xFFFF ? 0xFFFF : (uint16_t)age_s;
+        entry[0] = stats->addr.u8[14];
+        entry[1] = stats->addr.u8[15];
+        entry[2] = stats->packets >> 24;
+        entry[3] = stats->packets >> 16;
+        entry[4] = stats->packets >> 8;
+        entry[5] = stats->packets;
+        entry[6] = stats->bytes >> 24;
+        entry[7] = stats->bytes >> 16;
+        entry[8] = stats->bytes >> 8;
+        entry[9] = stats->bytes;
+        entry[10] = ticks_to_ms16(stats->jitter) >> 8;
+        entry[11] = ticks_to_ms16(stats->jitter);
+        entry[12] = stats->seq_gaps >> 8;
+        entry[13] = stats->seq_gaps;
+        entry[14] = age >> 8;
+        entry[15] = age;
+
+        len += NODE_STATS_ENTRY_LEN;
+        sent++;
+    }
+    reply[0] = i;
+
+    simple_udp_sendto_port(&stats_conn, reply, len, sender_addr, sender_port);
+}
+
 /*---------------------------------------------------------------------------*/
 /* Set IPv6 Prefix */
 static void set_prefix_64(uip_ipaddr_t *prefix) {
-    uip_ip6addr(prefix, 0xaaaa, 0, 0, 0, 0, 0, 0, 0);
+    uip_ip6addr(prefix, border_router_prefix(), 0, 0, 0, 0, 0, 0, 0);
     NETSTACK_ROUTING.root_set_prefix(prefix, NULL); // Set the routing root prefix
+#if MAC_CONF_WITH_TSCH
+    tsch_set_coordinator(1); // The root is the TSCH time source of the whole mesh
+#endif
     NETSTACK_ROUTING.root_start(); // Ensure root is started correctly
 
     LOG_INFO("IPv6 Prefix Set: ");
@@ -43,47 +345,44 @@ static bool verify_rpl_status(void) {
 }
 
 /*---------------------------------------------------------------------------*/
-/* Monitor Active RPL Network Nodes */
+/* Monitor Active RPL Network Nodes: periodic route count and node table dump */
 PROCESS_THREAD(monitor_rpl_nodes_process, ev, data) {
     static struct etimer node_timer;
-    static int retries = 30;         // Maximum retries for checking nodes
     static int num_nodes = 0;
+    static int last_num_nodes = -1;
 
     PROCESS_BEGIN();
 
-    etimer_set(&node_timer, CLOCK_SECOND / 2); // Half-second checks
+    simple_udp_register(&stats_conn, NODE_STATS_PORT, NULL, 0, stats_rx_callback);
+    etimer_set(&node_timer, NODE_STATS_INTERVAL);
 
-    while (retries > 0) {
+    while (1) {
         PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&node_timer));
         etimer_reset(&node_timer);
 
-        num_nodes = 0;
-        uip_ds6_route_t *route;
-
-        // Iterate through the routing table to count active nodes
-        for (route = uip_ds6_route_head(); route != NULL; route = uip_ds6_route_next(route)) {
-            num_nodes++;
-        }
+        num_nodes = uip_ds6_route_num_routes();
 
-        if (num_nodes > 0) {
-            LOG_INFO("Active RPL Nodes Detected: %d\n", num_nodes);
-            PROCESS_EXIT(); // Exit if nodes are detected
+        if (num_nodes != last_num_nodes) {
+            if (num_nodes > 0) {
+                LOG_INFO("Active RPL Nodes Detected: %d\n", num_nodes);
+            } else {
+                LOG_WARN("No sensor nodes in the routing table\n");
+            }
+            last_num_nodes = num_nodes;
         }
 
-        LOG_INFO("Waiting for sensor nodes to join... (retries left: %d)\n", retries - 1);
-        retries--;
+        /* Format: "R <routes>" followed by one "S" line per known node */
+        printf("R %d\n", num_nodes);
+        node_stats_dump();
     }
 
-    LOG_WARN("No sensor nodes detected after timeout!\n");
-
     PROCESS_END();
 }
 
 /*---------------------------------------------------------------------------*/
-/* Configure RPL Network Process */
+/* Configure RPL Network Process: start the root, re-root if the join helper stays silent */
 PROCESS_THREAD(configure_network_process, ev, data) {
     static struct etimer rpl_timer;
-    static bool rpl_ready = false; // RPL readiness flag
     static uip_ipaddr_t prefix;
 
     PROCESS_BEGIN();
@@ -92,39 +391,36 @@ PROCESS_THREAD(configure_network_process, ev, data) {
     set_prefix_64(&prefix);
 
     /* Start the timer for RPL formation */
+    rpl_join_subscribe(PROCESS_CURRENT());
     etimer_set(&rpl_timer, RPL_JOIN_TIMEOUT);
 
     LOG_INFO("Waiting for the RPL network to form...\n");
 
-    while (!etimer_expired(&rpl_timer)) {
-        if (verify_rpl_status()) {
-            rpl_ready = true;
+    while (1) {
+        PROCESS_WAIT_EVENT_UNTIL(ev == network_ready_event || etimer_expired(&rpl_timer));
+        if (ev == network_ready_event) {
             break;
         }
-        PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&rpl_timer));
-    }
 
-    if (!rpl_ready) {
         LOG_ERR("Failed to form RPL network within the timeout period.\n");
 
         /* Retry Mechanism for RPL */
         LOG_WARN("Retrying RPL network initialization...\n");
-        process_start(&configure_network_process, NULL); // Restart process
-        PROCESS_EXIT();
+        set_prefix_64(&prefix);
+        etimer_restart(&rpl_timer);
+    }
 
-    } else {
-        LOG_INFO("RPL Network formed successfully.\n");
+    verify_rpl_status();
+    LOG_INFO("RPL Network formed successfully.\n");
 
-        /* Monitor Active RPL Nodes */
-        process_start(&monitor_rpl_nodes_process, NULL); // Start monitoring nodes
-        PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_EXIT); // Wait for exit
-    }
+    /* Monitor Active RPL Nodes */
+    process_start(&monitor_rpl_nodes_process, NULL);
 
     PROCESS_END();
 }
 
 /*---------------------------------------------------------------------------*/
-/* UDP Callback Function */
+/* UDP Callback Function: copy the datagram into the pool and wake the forwarder */
 static void udp_rx_callback(struct simple_udp_connection *c,
                              const uip_ipaddr_t *sender_addr,
                              uint16_t sender_port,
@@ -132,22 +428,140 @@ static void udp_rx_callback(struct simple_udp_connection *c,
                              uint16_t receiver_port,
                              const uint8_t *data,
                              uint16_t datalen) {
-    LOG_INFO("Received UDP Packet:\n");
-    LOG_INFO("  From: ");
-    LOG_INFO_6ADDR(sender_addr);
-    LOG_INFO_("\n");
-    LOG_INFO("  To: ");
-    LOG_INFO_6ADDR(receiver_addr);
-    LOG_INFO_("\n");
-    LOG_INFO("  Data: %.*s\n", datalen, (char *)data);
+    struct ingest_packet *packet;
+
+    ingest_received++;
+    node_stats_update(sender_addr, data, datalen);
+
+    if (datalen > INGEST_PAYLOAD_MAX) {
+        ingest_dropped_oversize++;
+        return;
+    }
+
+    packet = memb_alloc(&ingest_pool);
+    if (packet == NULL) {
+        ingest_dropped_full++;
+        process_poll(&ingest_forward_process); // Lets the forwarder send a congestion notice
+        return;
+    }
+
+    uip_ipaddr_copy(&packet->sender, sender_addr);
+    packet->sender_port = sender_port;
+    packet->receiver_port = receiver_port;
+    packet->len = datalen;
+    packet->received_ms = network_time_ms();
+    memcpy(packet->data, data, datalen);
+
+    list_add(ingest_queue, packet);
+    process_poll(&ingest_forward_process);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Write one packet to the serial uplink as a single compact line */
+static void forward_packet(const struct ingest_packet *packet) {
+    uint16_t i;
+
+#if LOG_LEVEL >= LOG_LEVEL_DBG
+    struct telemetry_reader reader;
+    const uint8_t *fields;
+    uint8_t fields_len;
+    uint8_t samples = 0;
+
+    LOG_DBG("Received UDP Packet from ");
+    LOG_DBG_6ADDR(&packet->sender);
+    LOG_DBG_(":%u to port %u, %u bytes\n", packet->sender_port, packet->receiver_port, packet->len);
+
+    if (telemetry_reader_init(&reader, packet->data, packet->len)) {
+        while (telemetry_reader_next(&reader, &fields, &fields_len)) {
+            samples++;
+        }
+        LOG_DBG("  Telemetry from device %02X, sensor %u, %u sample(s)\n",
+                packet->data[2], packet->data[1] & TELEMETRY_SENSOR_MASK, samples);
+    }
+#endif
+
+    /*
+     * Format: "I <sender iid, 16 hex> <collector port> <hex payload>". The
+     * full IID names the mote whichever root's prefix it uses. The sensor
+     * always sends from INGEST_SENSOR_PORT, so the port printed is the one
+     * it sent to. Telemetry frames get the hop trailer, so the host can tell
+     * mesh time from uplink time.
+     */
+    printf("I ");
+    for (i = 8; i < 16; i++) {
+        printf("%02x", packet->sender.u8[i]);
+    }
+    printf(" %u ", packet->receiver_port);
+    for (i = 0; i < packet->len; i++) {
+        printf("%02x", packet->data[i]);
+    }
+    if (telemetry_is_frame(packet->data, packet->len) || telemetry_is_auth_frame(packet->data, packet->len)) {
+        printf("%02x%08lx", (TELEMETRY_FIELD_HOP_TIME_MS << 3) | 4, (unsigned long)packet->received_ms);
+    }
+    printf("\n");
+}
+
+/*---------------------------------------------------------------------------*/
+/* Ingest Forwarder: drain the pool in batches to the serial uplink */
+PROCESS_THREAD(ingest_forward_process, ev, data) {
+    static struct etimer stats_timer;
+    static uint32_t reported_drops;
+    static uint32_t notified_drops;
+    static clock_time_t last_notice;
+    struct ingest_packet *packet;
+    uint8_t n;
+
+    PROCESS_BEGIN();
+
+    etimer_set(&stats_timer, INGEST_STATS_INTERVAL);
 
-    /* Log Specific Sensor Packet Data */
-    LOG_INFO("[LOG] Processing data received from node: %.*s\n", datalen, (char *)data);
+    while (1) {
+        PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL || etimer_expired(&stats_timer));
+
+        if (ev == PROCESS_EVENT_POLL) {
+            for (n = 0; n < INGEST_FORWARD_BATCH; n++) {
+                packet = list_pop(ingest_queue);
+                if (packet == NULL) {
+                    break;
+                }
+                forward_packet(packet);
+                memb_free(&ingest_pool, packet);
+                ingest_forwarded++;
+            }
+
+            /* Yield between batches so the network stack keeps running */
+            if (list_head(ingest_queue) != NULL) {
+                process_poll(&ingest_forward_process);
+            }
+
+            /* New pool-full drops: ask senders to back off, at most once per holdoff */
+            if (ingest_dropped_full != notified_drops &&
+                (last_notice == 0 || clock_time() - last_notice >= INGEST_CONGESTION_HOLDOFF)) {
+                notified_drops = ingest_dropped_full;
+                last_notice = clock_time();
+                send_congestion_notice();
+            }
+        }
+
+        if (etimer_expired(&stats_timer)) {
+            etimer_reset(&stats_timer);
+            if (ingest_dropped_full + ingest_dropped_oversize != reported_drops) {
+                reported_drops = ingest_dropped_full + ingest_dropped_oversize;
+                LOG_WARN("Ingest drops: pool full %lu, oversize %lu (received %lu, forwarded %lu)\n",
+                         (unsigned long)ingest_dropped_full, (unsigned long)ingest_dropped_oversize,
+                         (unsigned long)ingest_received, (unsigned long)ingest_forwarded);
+            }
+        }
+    }
+
+    PROCESS_END();
 }
 
 /*---------------------------------------------------------------------------*/
 /* Border Router Main Process */
 PROCESS_THREAD(border_router_process, ev, data) {
+    static uint8_t i;
+
     PROCESS_BEGIN();
 
     LOG_INFO("Starting the Contiki-NG Border Router...\n");
@@ -155,14 +569,25 @@ PROCESS_THREAD(border_router_process, ev, data) {
     /* Initialize Global Resources */
     initialize_global_resources();
 
-    /* Configure the RPL Network */
+    /* Configure the RPL Network and wait until it is up */
     process_start(&configure_network_process, NULL); // Start configuration process
-    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_EXIT);
+    rpl_join_subscribe(PROCESS_CURRENT());
+    PROCESS_WAIT_EVENT_UNTIL(ev == network_ready_event);
 
     /* Initialize UDP Processing */
+    memb_init(&ingest_pool);
+    list_init(ingest_queue);
+    process_start(&ingest_forward_process, NULL);
     simple_udp_register(&udp_conn, UDP_PORT, NULL, UDP_PORT, udp_rx_callback);
     LOG_INFO("Listening for UDP traffic on port %u\n", UDP_PORT);
 
+    /* Sensors address the collector ports on the root, so ingest those too */
+    for (i = 0; i < INGEST_COLLECTOR_PORTS; i++) {
+        simple_udp_register(&collector_conns[i], INGEST_COLLECTOR_PORT_FIRST + i, NULL, 0, udp_rx_callback);
+    }
+    LOG_INFO("Listening for sensor traffic on ports %u-%u\n",
+             INGEST_COLLECTOR_PORT_FIRST, INGEST_COLLECTOR_PORT_LAST);
+
     /* Keep the process alive for handling UDP traffic */
     while (1) {
         PROCESS_WAIT_EVENT(); // Infinite event waiting loop
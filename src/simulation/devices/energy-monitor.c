@@ -0,0 +1,49 @@
+#include "contiki.h"
+#include "sys/energest.h"
+#include "energy-monitor.h"
+
+#if ENERGY_MONITOR_ENABLED
+
+// ------------------------------------------------------------
+// Energy Provider: Energest times per interval
+// ------------------------------------------------------------
+static const uint8_t energest_types[SENSOR_MAX_VALUES] = {
+    ENERGEST_TYPE_CPU, ENERGEST_TYPE_LPM, ENERGEST_TYPE_TRANSMIT, ENERGEST_TYPE_LISTEN,
+};
+static const uint8_t energy_fields[SENSOR_MAX_VALUES] = {
+    TELEMETRY_FIELD_CPU_MS, TELEMETRY_FIELD_LPM_MS, TELEMETRY_FIELD_TX_MS, TELEMETRY_FIELD_LISTEN_MS,
+};
+static uint64_t last_time[SENSOR_MAX_VALUES];   // Energest totals at the previous record
+
+// Milliseconds spent in each state since the previous record
+static void energy_sample(struct sensor_reading *reading) {
+    uint64_t now;
+    uint8_t i;
+
+    energest_flush();
+    for (i = 0; i < SENSOR_MAX_VALUES; i++) {
+        now = energest_type_time(energest_types[i]);
+        reading->values[i] = (int32_t)((now - last_time[i]) * 1000 / ENERGEST_SECOND);
+        last_time[i] = now;
+    }
+}
+
+static void energy_encode(const struct sensor_reading *reading, struct telemetry_frame *sample) {
+    uint8_t i;
+
+    for (i = 0; i < SENSOR_MAX_VALUES; i++) {
+        telemetry_put(sample, energy_fields[i], reading->values[i]);
+    }
+}
+
+const struct sensor_provider energy_provider = {
+    .name = "energy",
+    .sensor_type = TELEMETRY_SENSOR_ENERGY,
+    .port = 0,
+    .period = ENERGY_MONITOR_INTERVAL,
+    .threshold = 0,     // Every record is sent
+    .sample = energy_sample,
+    .encode = energy_encode,
+};
+
+#endif /* ENERGY_MONITOR_ENABLED */
@@ -0,0 +1,39 @@
+#ifndef ENERGY_MONITOR_H_
+#define ENERGY_MONITOR_H_
+
+/*
+ * Optional Energest instrumentation.
+ *
+ * When ENERGY_MONITOR_CONF_ENABLED is 1 the sensor runtime hosts one extra
+ * provider that samples Energest every ENERGY_MONITOR_INTERVAL and sends the
+ * CPU, LPM, transmit and listen time spent since the previous record as a
+ * TELEMETRY_SENSOR_ENERGY frame to the node's first collector port. Energest
+ * counts receive time as listen time. When disabled nothing here is compiled.
+ */
+
+#include "sensor-runtime.h"
+
+#ifdef ENERGY_MONITOR_CONF_ENABLED
+#define ENERGY_MONITOR_ENABLED ENERGY_MONITOR_CONF_ENABLED
+#else
+#define ENERGY_MONITOR_ENABLED 0
+#endif
+
+#ifdef ENERGY_MONITOR_CONF_INTERVAL
+#define ENERGY_MONITOR_INTERVAL ENERGY_MONITOR_CONF_INTERVAL
+#else
+#define ENERGY_MONITOR_INTERVAL (60 * CLOCK_SECOND)
+#endif
+
+#if ENERGY_MONITOR_ENABLED
+#if !ENERGEST_CONF_ON
+#error "ENERGY_MONITOR_CONF_ENABLED needs ENERGEST_CONF_ON 1 in project-conf.h"
+#endif
+#if TELEMETRY_ASCII
+#error "ENERGY_MONITOR_CONF_ENABLED needs binary telemetry (TELEMETRY_CONF_ASCII 0)"
+#endif
+
+extern const struct sensor_provider energy_provider;
+#endif
+
+#endif /* ENERGY_MONITOR_H_ */
@@ -3,16 +3,54 @@
 #include "net/ipv6/uip-ds6.h"
 #include "net/netstack.h"
 #include "net/routing/routing.h"
+#include "net/ipv6/uiplib.h"
+#include "sys/node-id.h"
+#if MAC_CONF_WITH_TSCH
+#include "net/mac/tsch/tsch.h"
+#endif
 
 #define LOG_MODULE "Global Resources"
 #define LOG_LEVEL LOG_LEVEL_INFO
 
-#define RPL_NETWORK_TIMEOUT (120 * CLOCK_SECOND) // Timeout for RPL network formation
+#define RPL_NETWORK_TIMEOUT (120 * CLOCK_SECOND) // Warn when the network takes longer than this
+
+#ifdef RPL_JOIN_CONF_INITIAL_INTERVAL
+#define RPL_JOIN_INITIAL_INTERVAL RPL_JOIN_CONF_INITIAL_INTERVAL
+#else
+#define RPL_JOIN_INITIAL_INTERVAL (2 * CLOCK_SECOND)  // First join check delay
+#endif
+
+#ifdef RPL_JOIN_CONF_MAX_INTERVAL
+#define RPL_JOIN_MAX_INTERVAL RPL_JOIN_CONF_MAX_INTERVAL
+#else
+#define RPL_JOIN_MAX_INTERVAL (32 * CLOCK_SECOND)     // Backoff cap while joining
+#endif
+
+#ifdef RPL_JOIN_CONF_CHECK_INTERVAL
+#define RPL_JOIN_CHECK_INTERVAL RPL_JOIN_CONF_CHECK_INTERVAL
+#else
+#define RPL_JOIN_CHECK_INTERVAL (10 * CLOCK_SECOND)   // Route check period once joined, bounds failover time
+#endif
+
+#ifdef RPL_JOIN_CONF_NATIVE_COLLECTOR
+#define RPL_JOIN_NATIVE_COLLECTOR RPL_JOIN_CONF_NATIVE_COLLECTOR
+#else
+#define RPL_JOIN_NATIVE_COLLECTOR "aaaa::1"           // Host running the drivers (native builds)
+#endif
 
 char custom_node_id[NODE_ID_LENGTH];         // Unique node identifier
 uip_ipaddr_t server_addr;                    // Border Router address
 struct simple_udp_connection udp_conn;       // UDP connection object
 
+process_event_t network_ready_event;         // Posted when the root becomes reachable
+process_event_t network_lost_event;          // Posted when the route to the root is lost
+
+static struct process *join_subscribers[RPL_JOIN_MAX_SUBSCRIBERS];
+static uint8_t join_subscriber_count;
+static uint8_t network_ready;
+
+PROCESS(rpl_join_process, "RPL Join");
+
 /*---------------------------------------------------------------------------*/
 /* Function to Generate Node ID */
 void generate_node_id(void) {
@@ -27,11 +65,45 @@ void generate_node_id(void) {
     LOG_INFO("Generated Custom Node ID: %s\n", custom_node_id);
 }
 
+/*---------------------------------------------------------------------------*/
+/* Prefix of This Border Router */
+uint16_t border_router_prefix(void) {
+#if BORDER_ROUTER_PREFIX_PER_NODE
+    return BORDER_ROUTER_PREFIX + (node_id > 0 ? node_id - 1 : 0);
+#else
+    return BORDER_ROUTER_PREFIX;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Network Clock: in TSCH builds every associated node shares the network
+ * uptime derived from the ASN, so timestamps from different motes and the
+ * border router compare directly. CSMA builds have no shared clock and fall
+ * back to the node's own uptime.
+ */
+uint32_t network_time_ms(void) {
+#if MAC_CONF_WITH_TSCH
+    if (tsch_is_associated) {
+        return (uint32_t)(tsch_get_network_uptime_ticks() * 1000 / CLOCK_SECOND);
+    }
+#endif
+    return (uint32_t)((uint64_t)clock_time() * 1000 / CLOCK_SECOND);
+}
+
+int network_time_is_synced(void) {
+#if MAC_CONF_WITH_TSCH
+    return tsch_is_associated;
+#else
+    return 0;
+#endif
+}
+
 /*---------------------------------------------------------------------------*/
 /* Initialize Global Resources */
 void initialize_global_resources(void) {
     if (NETSTACK_ROUTING.node_is_root()) {
-        uip_ip6addr(&server_addr, 0xaaaa, 0, 0, 0, 0, 0, 0, 1);
+        uip_ip6addr(&server_addr, border_router_prefix(), 0, 0, 0, 0, 0, 0, 1);
     }
 
     generate_node_id();
@@ -42,27 +114,119 @@ void initialize_global_resources(void) {
 }
 
 /*---------------------------------------------------------------------------*/
-/* Wait for RPL Network Formation */
-int wait_for_rpl_network(void) {
-    clock_time_t start_time = clock_time(); // Record the start time
-    clock_time_t deadline = start_time + RPL_NETWORK_TIMEOUT; // Calculate the timeout deadline
-
-    LOG_INFO("⌛ Waiting for RPL network to form...\n");
-
-    while (clock_time() < deadline) {
-        // Check if the RPL network is reachable and root IP address is available
-        if (NETSTACK_ROUTING.node_is_reachable() && NETSTACK_ROUTING.get_root_ipaddr(&server_addr)) {
-            LOG_INFO("🌐 RPL Network Formed. Border Router Address: ");
-            LOG_INFO_6ADDR(&server_addr);
-            LOG_INFO_("\n");
-            return 1; // Network successfully formed
+#ifdef CONTIKI_TARGET_NATIVE
+/* Native builds have no RPL root to wait for: report straight to the host collector */
+static int network_is_ready(void) {
+    return uiplib_ipaddrconv(RPL_JOIN_NATIVE_COLLECTOR, &server_addr);
+}
+#else
+/* Check RPL Reachability: the root is ready at once, other nodes need a route */
+static int network_is_ready(void) {
+    if (NETSTACK_ROUTING.node_is_root()) {
+        return 1;
+    }
+    return NETSTACK_ROUTING.node_is_reachable() && NETSTACK_ROUTING.get_root_ipaddr(&server_addr);
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+/* Notify Every Subscriber */
+static void notify_subscribers(process_event_t ev) {
+    uint8_t i;
+
+    for (i = 0; i < join_subscriber_count; i++) {
+        process_post(join_subscribers[i], ev, &server_addr);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+/* RPL Join Helper: poll with exponential backoff, then watch for route loss */
+PROCESS_THREAD(rpl_join_process, ev, data) {
+    static struct etimer join_timer;
+    static clock_time_t interval;
+    static clock_time_t waited;
+    static uip_ipaddr_t current_root;            // Root the subscribers were last told about
+
+    PROCESS_BEGIN();
+
+    while (1) {
+        LOG_INFO("⌛ Waiting for RPL network to form...\n");
+        interval = RPL_JOIN_INITIAL_INTERVAL;
+        waited = 0;
+
+        while (!network_is_ready()) {
+            etimer_set(&join_timer, interval);
+            PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&join_timer));
+
+            if (waited < RPL_NETWORK_TIMEOUT && waited + interval >= RPL_NETWORK_TIMEOUT) {
+                LOG_WARN("⚠️ Timeout waiting for RPL network to form, still trying.\n");
+            }
+            waited += interval;
+
+            /* Back off so a node far from the root does not keep waking up */
+            interval *= 2;
+            if (interval > RPL_JOIN_MAX_INTERVAL) {
+                interval = RPL_JOIN_MAX_INTERVAL;
+            }
         }
 
-        // Allow other processes to run while we check intermittently
-        process_poll(&etimer_process);
-        clock_wait(CLOCK_SECOND); // Sleep for one second before checking again
+        network_ready = 1;
+        LOG_INFO("🌐 RPL Network Formed. Border Router Address: ");
+        LOG_INFO_6ADDR(&server_addr);
+        LOG_INFO_("\n");
+        notify_subscribers(network_ready_event);
+
+        /*
+         * Watch the route to the root and start over when it disappears. With
+         * several border routers, RPL may move the node to another DODAG; the
+         * collector is always the current root, so subscribers are told again.
+         */
+        uip_ipaddr_copy(&current_root, &server_addr);
+        do {
+            etimer_set(&join_timer, RPL_JOIN_CHECK_INTERVAL);
+            PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&join_timer));
+
+            if (network_is_ready() && !uip_ipaddr_cmp(&current_root, &server_addr)) {
+                LOG_INFO("🔀 Collector moved to root ");
+                LOG_INFO_6ADDR(&server_addr);
+                LOG_INFO_("\n");
+                uip_ipaddr_copy(&current_root, &server_addr);
+                notify_subscribers(network_ready_event);
+            }
+        } while (network_is_ready());
+
+        network_ready = 0;
+        LOG_WARN("⚠️ Lost the route to the RPL root, rejoining.\n");
+        notify_subscribers(network_lost_event);
     }
 
-    LOG_WARN("⚠️ Timeout waiting for RPL network to form.\n");
-    return 0; // Network formation failed
-}
\ No newline at end of file
+    PROCESS_END();
+}
+
+/*---------------------------------------------------------------------------*/
+/* Subscribe to Join Events, starting the helper on first use */
+int rpl_join_subscribe(struct process *p) {
+    if (network_ready_event == 0) {
+        network_ready_event = process_alloc_event();
+        network_lost_event = process_alloc_event();
+    }
+
+    if (join_subscriber_count >= RPL_JOIN_MAX_SUBSCRIBERS) {
+        LOG_ERR("Too many RPL join subscribers.\n");
+        return 0;
+    }
+    join_subscribers[join_subscriber_count++] = p;
+
+    if (!process_is_running(&rpl_join_process)) {
+        process_start(&rpl_join_process, NULL);
+    } else if (network_ready) {
+        process_post(p, network_ready_event, &server_addr); // Joined before this subscriber
+    }
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Report Whether the Root Is Reachable */
+int rpl_join_is_ready(void) {
+    return network_ready;
+}
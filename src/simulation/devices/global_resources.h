@@ -11,14 +11,46 @@
 #define NODE_ID_LENGTH 16    // Max length for node ID string
 #define UDP_PORT 1234        // UDP port used for communication
 
+/*
+ * Prefix a border router announces: BORDER_ROUTER_PREFIX::/64. With
+ * BORDER_ROUTER_PREFIX_PER_NODE, several border routers in one simulation
+ * run the same image and each announces BORDER_ROUTER_PREFIX + node_id - 1
+ * (aaaa::/64, aaab::/64, ... for motes 1, 2, ...).
+ */
+#ifdef BORDER_ROUTER_CONF_PREFIX
+#define BORDER_ROUTER_PREFIX BORDER_ROUTER_CONF_PREFIX
+#else
+#define BORDER_ROUTER_PREFIX 0xaaaa
+#endif
+
+#ifdef BORDER_ROUTER_CONF_PREFIX_PER_NODE
+#define BORDER_ROUTER_PREFIX_PER_NODE BORDER_ROUTER_CONF_PREFIX_PER_NODE
+#else
+#define BORDER_ROUTER_PREFIX_PER_NODE 0
+#endif
+
+#ifdef RPL_JOIN_CONF_MAX_SUBSCRIBERS
+#define RPL_JOIN_MAX_SUBSCRIBERS RPL_JOIN_CONF_MAX_SUBSCRIBERS
+#else
+#define RPL_JOIN_MAX_SUBSCRIBERS 4   // Processes notified about join state changes
+#endif
+
 // Global variables for all nodes
 extern char custom_node_id[NODE_ID_LENGTH];              // Unique node ID
 extern uip_ipaddr_t server_addr;                         // Border Router address
 extern struct simple_udp_connection udp_conn;            // UDP connection object
 
+// RPL join events, posted to subscribers with data pointing to server_addr
+extern process_event_t network_ready_event;              // Root became reachable, or a different root took over
+extern process_event_t network_lost_event;               // Route to the root was lost
+
 // Functions
 void generate_node_id(void);                             // Create unique node ID
 void initialize_global_resources(void);                  // Initialize resource settings
-int wait_for_rpl_network(void);                          // Wait until RPL network is formed
+uint16_t border_router_prefix(void);                     // First 16 bits of this root's /64 prefix
+uint32_t network_time_ms(void);                          // Network clock in ms, see network_time_is_synced
+int network_time_is_synced(void);                        // Whether network_time_ms is shared by the mesh
+int rpl_join_subscribe(struct process *p);               // Start the join helper and notify p
+int rpl_join_is_ready(void);                             // Whether the root is currently reachable
 
 #endif /* GLOBAL_RESOURCES_H_ */
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "sensor-runtime.h"
+
+// ------------------------------------------------------------
+// Multi-Role Sensor Node
+// ------------------------------------------------------------
+// Hosts several sensor roles on one mote, sharing the UDP socket, the device
+// ID and the scheduler. Pick the roles at build time, e.g.
+//   CFLAGS += -DSENSOR_CONF_PROVIDERS="&security_provider,&network_provider"
+// The default hosts all five.
+#ifdef SENSOR_CONF_PROVIDERS
+SENSOR_PROVIDERS(SENSOR_CONF_PROVIDERS);
+#else
+SENSOR_PROVIDERS(&availability_provider, &integrity_provider, &monitor_provider,
+                 &network_provider, &security_provider);
+#endif
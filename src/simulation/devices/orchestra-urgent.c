@@ -0,0 +1,76 @@
+#include "contiki.h"
+#include "tsch-orchestra-conf.h"
+
+#if MAC_CONF_WITH_TSCH
+#include "orchestra.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uipbuf.h"
+#include "net/packetbuf.h"
+
+// ------------------------------------------------------------
+// Orchestra Rule: Urgent Sensor Traffic
+// ------------------------------------------------------------
+// One shared Tx/Rx cell per ORCHESTRA_URGENT_PERIOD timeslots, installed on
+// every node so forwarders and the border router listen in it too. Unicast
+// datagrams to the security and integrity collector ports are sent in this
+// cell instead of the sender's unicast slotframe. TSCH asks Orchestra for a
+// cell while 6LoWPAN is still sending from uip_buf, so the datagram being
+// framed, originated or forwarded, can be classified by its UDP port.
+
+static uint16_t slotframe_handle;
+static struct tsch_slotframe *sf_urgent;
+
+// Whether uip_buf holds a datagram for an urgent collector port
+static int is_urgent_datagram(void) {
+    const struct uip_udp_hdr *udp;
+
+    if (uip_len == 0) {
+        return 0;
+    }
+    udp = (const struct uip_udp_hdr *)uipbuf_search_header(uip_buf, uip_len, UIP_PROTO_UDP);
+    if (udp == NULL) {
+        return 0;
+    }
+    switch (uip_ntohs(udp->destport)) {
+    case ORCHESTRA_URGENT_PORT_INTEGRITY:
+    case ORCHESTRA_URGENT_PORT_SECURITY:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static int select_packet(uint16_t *slotframe, uint16_t *timeslot, uint16_t *channel_offset) {
+    const linkaddr_t *dest = packetbuf_addr(PACKETBUF_ADDR_RECEIVER);
+
+    // Broadcasts (RPL, beacons) stay in the common slotframe
+    if (linkaddr_cmp(dest, &linkaddr_null) || !is_urgent_datagram()) {
+        return 0;
+    }
+    if (slotframe != NULL) {
+        *slotframe = slotframe_handle;
+    }
+    if (timeslot != NULL) {
+        *timeslot = 0;
+    }
+    if (channel_offset != NULL) {
+        *channel_offset = ORCHESTRA_URGENT_CHANNEL_OFFSET;
+    }
+    return 1;
+}
+
+static void init(uint16_t sf_handle) {
+    slotframe_handle = sf_handle;
+    sf_urgent = tsch_schedule_add_slotframe(slotframe_handle, ORCHESTRA_URGENT_PERIOD);
+    tsch_schedule_add_link(sf_urgent, LINK_OPTION_RX | LINK_OPTION_TX | LINK_OPTION_SHARED,
+                           LINK_TYPE_NORMAL, &tsch_broadcast_address,
+                           0, ORCHESTRA_URGENT_CHANNEL_OFFSET, 1);
+}
+
+struct orchestra_rule urgent_sensor_rule = {
+    .init = init,
+    .select_packet = select_packet,
+    .name = "urgent sensor traffic",
+};
+
+#endif /* MAC_CONF_WITH_TSCH */
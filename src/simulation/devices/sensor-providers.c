@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "contiki.h"
+#include "sensor-runtime.h"
+
+// ------------------------------------------------------------
+// Metric Providers
+// ------------------------------------------------------------
+// One descriptor per sensor role. The ASCII formatters reproduce the legacy
+// payloads byte for byte so the drivers parse either build the same way.
+
+#define SAMPLE_PERIOD (10 * CLOCK_SECOND)    // Default sampling period
+
+// ------------------------------------------------------------
+// Availability: random up/down flag, port 8845
+// ------------------------------------------------------------
+static void availability_sample(struct sensor_reading *reading) {
+    reading->values[0] = rand() % 2; // 1 = "Up", 0 = "Down"
+}
+
+static void availability_encode(const struct sensor_reading *reading, struct telemetry_frame *sample) {
+    telemetry_put(sample, TELEMETRY_FIELD_AVAILABILITY, reading->values[0]);
+}
+
+#if TELEMETRY_ASCII
+static int availability_format(const struct sensor_reading *reading, const char *device_id, char *buf, size_t size) {
+    return snprintf(buf, size, "device_id:%s,availability:%d", device_id, (int)reading->values[0]);
+}
+#endif
+
+const struct sensor_provider availability_provider = {
+    .name = "availability",
+    .sensor_type = TELEMETRY_SENSOR_AVAILABILITY,
+    .port = 8845,
+    .period = SAMPLE_PERIOD,
+    .threshold = 1,     // Any flip
+    .sample = availability_sample,
+    .encode = availability_encode,
+#if TELEMETRY_ASCII
+    .format = availability_format,
+#endif
+};
+
+// ------------------------------------------------------------
+// Integrity: random integrity flag, port 8843
+// ------------------------------------------------------------
+static void integrity_sample(struct sensor_reading *reading) {
+    reading->values[0] = rand() % 2; // Simulated integrity flag
+}
+
+static void integrity_encode(const struct sensor_reading *reading, struct telemetry_frame *sample) {
+    telemetry_put(sample, TELEMETRY_FIELD_INTEGRITY_FLAG, reading->values[0]);
+}
+
+#if TELEMETRY_ASCII
+static int integrity_format(const struct sensor_reading *reading, const char *device_id, char *buf, size_t size) {
+    return snprintf(buf, size, "device_id:%s,integrity_flag:%d", device_id, (int)reading->values[0]);
+}
+#endif
+
+const struct sensor_provider integrity_provider = {
+    .name = "integrity",
+    .sensor_type = TELEMETRY_SENSOR_INTEGRITY,
+    .port = 8843,
+    .period = SAMPLE_PERIOD,
+    .threshold = 1,     // Any flip
+    .sample = integrity_sample,
+    .encode = integrity_encode,
+#if TELEMETRY_ASCII
+    .format = integrity_format,
+#endif
+};
+
+// ------------------------------------------------------------
+// Monitor: log event id with an OK status, port 8844
+// ------------------------------------------------------------
+static void monitor_sample(struct sensor_reading *reading) {
+    reading->values[0] = rand() % 100; // Example "event ID" for monitoring logs
+}
+
+static void monitor_encode(const struct sensor_reading *reading, struct telemetry_frame *sample) {
+    telemetry_put(sample, TELEMETRY_FIELD_LOG_ID, reading->values[0]);
+    telemetry_put(sample, TELEMETRY_FIELD_STATUS, TELEMETRY_STATUS_OK);
+}
+
+#if TELEMETRY_ASCII
+static int monitor_format(const struct sensor_reading *reading, const char *device_id, char *buf, size_t size) {
+    return snprintf(buf, size, "device_id:%s,log_id:%d,message:Monitor_OK", device_id, (int)reading->values[0]);
+}
+#endif
+
+const struct sensor_provider monitor_provider = {
+    .name = "monitor",
+    .sensor_type = TELEMETRY_SENSOR_MONITOR,
+    .port = 8844,
+    .period = SAMPLE_PERIOD,
+    .threshold = 0,     // Every log event
+    .sample = monitor_sample,
+    .encode = monitor_encode,
+#if TELEMETRY_ASCII
+    .format = monitor_format,
+#endif
+};
+
+// ------------------------------------------------------------
+// Network: latency and packet loss, port 8846
+// ------------------------------------------------------------
+static void network_sample(struct sensor_reading *reading) {
+    reading->values[0] = rand() % 100 + 10;  // Simulated latency in ms
+    reading->values[1] = rand() % 10;        // Simulated packet loss (0-9%)
+}
+
+static void network_encode(const struct sensor_reading *reading, struct telemetry_frame *sample) {
+    telemetry_put(sample, TELEMETRY_FIELD_LATENCY_MS, reading->values[0]);
+    telemetry_put(sample, TELEMETRY_FIELD_PACKET_LOSS, reading->values[1]);
+}
+
+#if TELEMETRY_ASCII
+static int network_format(const struct sensor_reading *reading, const char *device_id, char *buf, size_t size) {
+    return snprintf(buf, size, "device_id:%s,latency:%dms,packet_loss:%d%%",
+                    device_id, (int)reading->values[0], (int)reading->values[1]);
+}
+#endif
+
+const struct sensor_provider network_provider = {
+    .name = "network",
+    .sensor_type = TELEMETRY_SENSOR_NETWORK,
+    .port = 8846,
+    .period = SAMPLE_PERIOD,
+    .threshold = 10,    // 10 ms or 10 points of loss
+    .sample = network_sample,
+    .encode = network_encode,
+#if TELEMETRY_ASCII
+    .format = network_format,
+#endif
+};
+
+// ------------------------------------------------------------
+// Security: random breach flag, port 8847
+// ------------------------------------------------------------
+static void security_sample(struct sensor_reading *reading) {
+    reading->values[0] = rand() % 2; // 1 = breach, 0 = secure
+}
+
+static void security_encode(const struct sensor_reading *reading, struct telemetry_frame *sample) {
+    telemetry_put(sample, TELEMETRY_FIELD_BREACH_FLAG, reading->values[0]);
+}
+
+#if TELEMETRY_ASCII
+static int security_format(const struct sensor_reading *reading, const char *device_id, char *buf, size_t size) {
+    return snprintf(buf, size, "device_id:%s,breach_flag:%d", device_id, (int)reading->values[0]);
+}
+#endif
+
+const struct sensor_provider security_provider = {
+    .name = "security",
+    .sensor_type = TELEMETRY_SENSOR_SECURITY,
+    .port = 8847,
+    .period = SAMPLE_PERIOD,
+    .threshold = 1,     // Any flip
+    .sample = security_sample,
+    .encode = security_encode,
+#if TELEMETRY_ASCII
+    .format = security_format,
+#endif
+};
@@ -0,0 +1,368 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef CONTIKI_TARGET_NATIVE
+#include <unistd.h>
+#endif
+#include "contiki.h"
+#include "contiki-net.h"
+#include "sys/log.h"
+#include "net/ipv6/simple-udp.h"
+#include "sensor-runtime.h"
+#include "energy-monitor.h"
+#include "telemetry-auth.h"
+#include "global_resources.h"
+
+#define LOG_MODULE "Sensor"
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+#define ASCII_BUFFER_SIZE 64                // Longest legacy payload is under 50 bytes
+
+/* Runtime state for one hosted role */
+struct sensor_slot {
+    const struct sensor_provider *provider;
+    struct etimer timer;
+#if !TELEMETRY_ASCII
+    struct telemetry_batch batch;           // Samples waiting to be sent
+    uint16_t seq;                           // Next sample sequence number, lets the host drop copies
+    uint16_t dropped;                       // Samples lost because they could not be queued or sent
+#endif
+#if SENSOR_ADAPTIVE
+    int32_t reported[SENSOR_MAX_VALUES];    // Values in the last report
+    clock_time_t last_report;               // When the last report was made
+    clock_time_t heartbeat;                 // Current steady-state report interval
+    uint8_t has_report;
+#endif
+};
+
+static struct sensor_slot slots[SENSOR_MAX_PROVIDERS + ENERGY_MONITOR_ENABLED];
+static uint8_t slot_count;
+static char device_id[SENSOR_DEVICE_ID_SIZE];   // Device ID shared by all roles
+#if SENSOR_ADAPTIVE
+static uint8_t slowdown = 1;                    // Congestion multiplier from the border router
+static clock_time_t slowdown_until;             // When the multiplier expires
+#endif
+
+PROCESS(sensor_runtime_process, "Sensor Runtime");
+AUTOSTART_PROCESSES(&sensor_runtime_process);
+
+// ------------------------------------------------------------
+// Utility Functions
+// ------------------------------------------------------------
+
+// Device byte carried in every frame: the last MAC address byte on motes. Native
+// instances on one host share a link-layer address, so they use their PID instead.
+static uint8_t device_byte() {
+#ifdef CONTIKI_TARGET_NATIVE
+    return (uint8_t)getpid();
+#else
+    return linkaddr_node_addr.u8[7];
+#endif
+}
+
+// Device id bits above the device byte, sent as DEVICE_HI when not zero: native
+// instances use the high byte of their PID, motes have none.
+static uint8_t device_hi() {
+#ifdef CONTIKI_TARGET_NATIVE
+    return (uint8_t)(getpid() >> 8);
+#else
+    return 0;
+#endif
+}
+
+// Generate a 2-digit unique Device ID from the device byte
+static void generate_device_id() {
+    if (device_byte() == 0) {
+        snprintf(device_id, SENSOR_DEVICE_ID_SIZE, "00");
+        LOG_WARN("⚠️ Invalid MAC address. Defaulting Device ID to 00.\n");
+    } else {
+        snprintf(device_id, SENSOR_DEVICE_ID_SIZE, "%02X", device_byte());
+        LOG_INFO("✅ Device ID: %s\n", device_id);
+    }
+}
+
+#if SENSOR_ADAPTIVE
+// Apply a congestion message: stretch reports by SLOWDOWN for HOLD_S seconds
+static int handle_control(const uint8_t *data, uint16_t datalen) {
+    uint32_t factor, hold_s = SENSOR_SLOWDOWN_HOLD_S;
+
+    if (!telemetry_is_frame(data, datalen) || (data[1] & TELEMETRY_SENSOR_MASK) != TELEMETRY_SENSOR_CONTROL ||
+        !telemetry_get_field(data + TELEMETRY_HEADER_LEN, datalen - TELEMETRY_HEADER_LEN,
+                             TELEMETRY_FIELD_SLOWDOWN, &factor)) {
+        return 0;
+    }
+    telemetry_get_field(data + TELEMETRY_HEADER_LEN, datalen - TELEMETRY_HEADER_LEN, TELEMETRY_FIELD_HOLD_S, &hold_s);
+
+    slowdown = factor < 1 ? 1 : factor > SENSOR_MAX_SLOWDOWN ? SENSOR_MAX_SLOWDOWN : factor;
+    slowdown_until = clock_time() + hold_s * CLOCK_SECOND;
+    LOG_INFO("🐢 Border router reports congestion, slowing down x%u for %lu s\n",
+             slowdown, (unsigned long)hold_s);
+    return 1;
+}
+
+// Current congestion multiplier, back to 1 once the hold time has passed
+static uint8_t current_slowdown() {
+    if (slowdown > 1 && (long)(clock_time() - slowdown_until) >= 0) {
+        slowdown = 1;
+        LOG_INFO("🐇 Congestion hold expired, normal reporting resumed.\n");
+    }
+    return slowdown;
+}
+#endif
+
+// UDP callback for control messages and anything else sent back to any role
+static void udp_rx_callback(struct simple_udp_connection *c,
+                            const uip_ipaddr_t *sender_addr,
+                            uint16_t sender_port,
+                            const uip_ipaddr_t *receiver_addr,
+                            uint16_t receiver_port,
+                            const uint8_t *data, uint16_t datalen) {
+#if SENSOR_ADAPTIVE
+    if (handle_control(data, datalen)) {
+        return;
+    }
+#endif
+    LOG_INFO("📩 Received from port %d: %.*s\n", sender_port, datalen, (char *)data);
+}
+
+// Collector port of a role; roles without one report to the first hosted role's
+static uint16_t slot_port(const struct sensor_slot *slot) {
+    return slot->provider->port != 0 ? slot->provider->port : slots[0].provider->port;
+}
+
+// Start sampling one provider
+static void add_slot(const struct sensor_provider *provider) {
+    struct sensor_slot *slot = &slots[slot_count++];
+
+    slot->provider = provider;
+#if !TELEMETRY_ASCII
+    telemetry_batch_init(&slot->batch, TELEMETRY_BATCH_DELTA);
+#endif
+    etimer_set(&slot->timer, provider->period);
+#if SENSOR_ADAPTIVE
+    slot->has_report = 0;
+    slot->heartbeat = provider->period;
+#endif
+    LOG_INFO("🧩 Hosting %s role, collector port %u.\n", provider->name, slot_port(slot));
+}
+
+// Register the one socket every role sends through
+static void setup_udp() {
+    simple_udp_register(&udp_conn, SENSOR_UDP_PORT_LOCAL, NULL, 0, udp_rx_callback);
+    LOG_INFO("🔗 UDP socket bound to port %d.\n", SENSOR_UDP_PORT_LOCAL);
+}
+
+#if TELEMETRY_AUTH
+// Key frames to this node's interface identifier, which the host reads from
+// the sender address
+static void auth_init() {
+    static const uint8_t no_iid[8];
+    uip_ds6_addr_t *lladdr = uip_ds6_get_link_local(-1);
+
+    if (lladdr == NULL) {
+        LOG_WARN("⚠️ No link-local address, telemetry key derived without it.\n");
+    }
+    telemetry_auth_init(lladdr != NULL ? &lladdr->ipaddr.u8[8] : no_iid, device_hi(), device_byte());
+}
+#endif
+
+#if !TELEMETRY_ASCII
+// Send every queued sample of one role, packing as many as fit into each datagram
+static void flush_batch(struct sensor_slot *slot) {
+    static uint8_t payload[TELEMETRY_MAX_FRAME];
+    uint8_t len;
+#if TELEMETRY_AUTH
+    uint8_t samples;
+#endif
+
+    if (!rpl_join_is_ready()) {
+        return; // Keep the samples until the root is reachable again
+    }
+
+#if TELEMETRY_AUTH
+    /* Leave room for the counter and MIC, then seal each frame */
+    while ((len = telemetry_batch_encode(&slot->batch, payload, sizeof(payload) - TELEMETRY_AUTH_OVERHEAD,
+                                         slot->provider->sensor_type, device_byte(), clock_seconds())) > 0) {
+        samples = payload[TELEMETRY_HEADER_LEN]; // The encoder has already dequeued them
+        if ((len = telemetry_auth_seal(payload, len, sizeof(payload))) == 0) {
+            slot->dropped += samples;
+            LOG_WARN("⚠️ %s batch could not be sealed, %u samples dropped (%u so far).\n",
+                     slot->provider->name, samples, slot->dropped);
+            continue;
+        }
+#else
+    while ((len = telemetry_batch_encode(&slot->batch, payload, sizeof(payload), slot->provider->sensor_type,
+                                         device_byte(), clock_seconds())) > 0) {
+#endif
+        simple_udp_sendto_port(&udp_conn, payload, len, &server_addr, slot_port(slot));
+        LOG_INFO("📤 Sent %s batch (%u bytes)\n", slot->provider->name, len);
+    }
+}
+#endif
+
+#if SENSOR_ADAPTIVE
+/*
+ * Decide whether a reading is reported. Changes of at least the provider's
+ * threshold always are; steady readings only when the heartbeat is due, and
+ * each steady report doubles the heartbeat up to the cap. Roles with a zero
+ * threshold report every reading, but none of them counts as a change: they
+ * are left to the batch policy.
+ */
+static int should_report(struct sensor_slot *slot, const struct sensor_reading *reading, uint8_t *changed) {
+    const struct sensor_provider *provider = slot->provider;
+    clock_time_t now = clock_time();
+    uint32_t delta;
+    uint8_t i;
+
+    *changed = 0;
+    if (provider->threshold == 0) {
+        return 1;
+    }
+
+    *changed = !slot->has_report;
+    for (i = 0; i < SENSOR_MAX_VALUES && !*changed; i++) {
+        delta = reading->values[i] > slot->reported[i] ? reading->values[i] - slot->reported[i]
+                                                       : slot->reported[i] - reading->values[i];
+        *changed = delta >= provider->threshold;
+    }
+
+    if (*changed) {
+        slot->heartbeat = provider->period;
+    } else if (now - slot->last_report < slot->heartbeat * current_slowdown()) {
+        return 0;
+    } else if (slot->heartbeat < provider->period * SENSOR_HEARTBEAT_MAX_FACTOR) {
+        slot->heartbeat *= 2;
+    }
+
+    memcpy(slot->reported, reading->values, sizeof(slot->reported));
+    slot->last_report = now;
+    slot->has_report = 1;
+    return 1;
+}
+#endif
+
+// Take one reading from a role and send or queue it
+static void sample_role(struct sensor_slot *slot) {
+    const struct sensor_provider *provider = slot->provider;
+    struct sensor_reading reading;
+    uint8_t changed = 0;
+
+    memset(&reading, 0, sizeof(reading));
+    provider->sample(&reading);
+
+#if SENSOR_ADAPTIVE
+    if (!should_report(slot, &reading, &changed)) {
+#if !TELEMETRY_ASCII
+        /* Steady ticks queue nothing, so check the age of what is already queued here */
+        if (telemetry_batch_due(&slot->batch, clock_seconds())) {
+            flush_batch(slot);
+        }
+#endif
+        return; // Steady value, the heartbeat is not due yet
+    }
+#endif
+
+#if TELEMETRY_ASCII
+    static char payload[ASCII_BUFFER_SIZE];
+    int len;
+
+    if (!rpl_join_is_ready()) {
+        return; // Nothing to send to until the root is reachable
+    }
+    len = provider->format(&reading, device_id, payload, sizeof(payload));
+    if (len <= 0 || len >= (int)sizeof(payload)) {
+        LOG_WARN("⚠️ %s payload does not fit, dropped.\n", provider->name);
+        return;
+    }
+
+    simple_udp_sendto_port(&udp_conn, payload, len, &server_addr, slot_port(slot));
+    LOG_INFO("📤 Sent %s data: [%s]\n", provider->name, payload);
+#else
+    uint8_t fields[TELEMETRY_SAMPLE_MAX_LEN];
+    struct telemetry_frame sample;
+    int due;
+
+    telemetry_begin_fields(&sample, fields, sizeof(fields));
+    provider->encode(&reading, &sample);
+    if (device_hi() != 0) {
+        telemetry_put(&sample, TELEMETRY_FIELD_DEVICE_HI, device_hi());
+    }
+    telemetry_put(&sample, TELEMETRY_FIELD_SEQ, slot->seq++);
+    telemetry_put(&sample, network_time_is_synced() ? TELEMETRY_FIELD_NET_TIME_MS : TELEMETRY_FIELD_NODE_TIME_MS,
+                  network_time_ms());
+    LOG_INFO("📥 Queued %s sample (%u bytes)\n", provider->name, sample.len);
+
+#if SENSOR_ADAPTIVE
+    if (changed && current_slowdown() > 1) {
+        changed = 0; // Congested: leave the change to the batch policy
+    }
+#endif
+
+    /* A full batch is flushed to make room; it stays full while the root is unreachable */
+    due = telemetry_batch_add(&slot->batch, fields, sample.len, reading.values[0], clock_seconds());
+    if (due < 0) {
+        flush_batch(slot);
+        due = telemetry_batch_add(&slot->batch, fields, sample.len, reading.values[0], clock_seconds());
+    }
+    if (due < 0) {
+        slot->dropped++;
+        LOG_WARN("⚠️ %s batch full, sample dropped (%u so far).\n", provider->name, slot->dropped);
+        return;
+    }
+
+    /* Changes go out at once, everything else follows the batch policy */
+    if (due > 0 || changed) {
+        flush_batch(slot);
+    }
+#endif
+}
+
+// ------------------------------------------------------------
+// Main Sensor Process: one scheduler for every hosted role
+// ------------------------------------------------------------
+PROCESS_THREAD(sensor_runtime_process, ev, data) {
+    static uint8_t i;
+
+    PROCESS_BEGIN();
+
+    LOG_INFO("📡 Sensor Node Started.\n");
+    generate_device_id();
+#if TELEMETRY_AUTH
+    auth_init();
+#endif
+    setup_udp();
+
+    for (i = 0; i < SENSOR_MAX_PROVIDERS && sensor_providers[i] != NULL; i++) {
+        add_slot(sensor_providers[i]);
+    }
+    if (sensor_providers[i] != NULL) {
+        LOG_WARN("⚠️ Only the first %u roles are hosted (SENSOR_CONF_MAX_PROVIDERS).\n", SENSOR_MAX_PROVIDERS);
+    }
+#if ENERGY_MONITOR_ENABLED
+    add_slot(&energy_provider);
+#endif
+
+    rpl_join_subscribe(PROCESS_CURRENT()); // Transmit only while the root is reachable
+
+    while (1) {
+        PROCESS_WAIT_EVENT();
+
+#if !TELEMETRY_ASCII
+        if (ev == network_ready_event) {
+            for (i = 0; i < slot_count; i++) {
+                flush_batch(&slots[i]); // Send what was queued while the root was unreachable
+            }
+        }
+#endif
+        if (ev == PROCESS_EVENT_TIMER) {
+            for (i = 0; i < slot_count; i++) {
+                if (data == &slots[i].timer) {
+                    sample_role(&slots[i]);
+                    etimer_reset(&slots[i].timer);
+                }
+            }
+        }
+    }
+
+    PROCESS_END();
+}
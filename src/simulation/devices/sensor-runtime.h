@@ -0,0 +1,77 @@
+#ifndef SENSOR_RUNTIME_H_
+#define SENSOR_RUNTIME_H_
+
+/*
+ * Shared sensor runtime.
+ *
+ * Every sensor role is a static metric provider: a sample function that
+ * takes one reading, an encode function that turns it into telemetry fields
+ * and a sampling period. A firmware image lists the providers it hosts with
+ * SENSOR_PROVIDERS(); the runtime drives them all from one process and sends
+ * every role's traffic over one UDP socket, addressed to the role's port.
+ *
+ * With SENSOR_ADAPTIVE, readings are still taken every period but only sent
+ * when a value moves by the provider's threshold or a heartbeat is due. The
+ * heartbeat interval doubles while values stay steady, up to
+ * SENSOR_HEARTBEAT_MAX_FACTOR periods. A congestion message from the border
+ * router stretches heartbeats and holds change reports for the batch policy.
+ */
+
+#include "contiki.h"
+#include "telemetry-batch.h"
+
+#ifdef SENSOR_CONF_MAX_PROVIDERS
+#define SENSOR_MAX_PROVIDERS SENSOR_CONF_MAX_PROVIDERS
+#else
+#define SENSOR_MAX_PROVIDERS 5          // Roles one mote can host
+#endif
+
+#ifdef SENSOR_CONF_ADAPTIVE
+#define SENSOR_ADAPTIVE SENSOR_CONF_ADAPTIVE
+#else
+#define SENSOR_ADAPTIVE 1
+#endif
+
+#ifdef SENSOR_CONF_HEARTBEAT_MAX_FACTOR
+#define SENSOR_HEARTBEAT_MAX_FACTOR SENSOR_CONF_HEARTBEAT_MAX_FACTOR
+#else
+#define SENSOR_HEARTBEAT_MAX_FACTOR 32  // Steady-state cap, in sampling periods
+#endif
+
+#define SENSOR_MAX_SLOWDOWN 16          // Largest congestion multiplier honoured
+#define SENSOR_SLOWDOWN_HOLD_S 120      // Slowdown length when the message has none
+
+#define SENSOR_MAX_VALUES 4             // Values in one reading
+#define SENSOR_DEVICE_ID_SIZE 3         // 2 hex digits + null terminator
+#define SENSOR_UDP_PORT_LOCAL 5555      // Local port shared by all roles
+
+struct sensor_reading {
+    int32_t values[SENSOR_MAX_VALUES];  // values[0] drives the batch change policy
+};
+
+struct sensor_provider {
+    const char *name;                   // Role name used in logs
+    uint8_t sensor_type;                // TELEMETRY_SENSOR_*
+    uint16_t port;                      // Collector UDP port, 0 for the first hosted role's
+    clock_time_t period;                // Sampling period
+    uint32_t threshold;                 // Change that is reported at once, 0 reports every reading
+    void (*sample)(struct sensor_reading *reading);
+    void (*encode)(const struct sensor_reading *reading, struct telemetry_frame *sample);
+#if TELEMETRY_ASCII
+    int (*format)(const struct sensor_reading *reading, const char *device_id, char *buf, size_t size);
+#endif
+};
+
+// Roles hosted by this firmware, NULL-terminated
+extern const struct sensor_provider *const sensor_providers[];
+#define SENSOR_PROVIDERS(...) \
+    const struct sensor_provider *const sensor_providers[] = { __VA_ARGS__, NULL }
+
+// Built-in providers (sensor-providers.c)
+extern const struct sensor_provider availability_provider;
+extern const struct sensor_provider integrity_provider;
+extern const struct sensor_provider monitor_provider;
+extern const struct sensor_provider network_provider;
+extern const struct sensor_provider security_provider;
+
+#endif /* SENSOR_RUNTIME_H_ */
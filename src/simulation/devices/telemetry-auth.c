@@ -0,0 +1,68 @@
+#include "contiki.h"
+#include "lib/aes-128.h"
+#include "lib/ccm-star.h"
+#include "telemetry-auth.h"
+
+#if TELEMETRY_AUTH
+
+// ------------------------------------------------------------
+// Frame Authentication: AES-CCM MIC over the whole frame
+// ------------------------------------------------------------
+static const uint8_t master_key[AES_128_KEY_LENGTH] = TELEMETRY_AUTH_KEY;
+static uint8_t device;          // Device byte, part of every nonce
+static uint8_t device_high;     // DEVICE_HI, part of every nonce
+static uint32_t counter;        // Frame counter, never reused within one boot
+
+void telemetry_auth_init(const uint8_t *iid, uint8_t device_hi, uint8_t device_id) {
+    uint8_t key[AES_128_KEY_LENGTH] = { 'I', 'B', 'K', 'D' };
+
+    device = device_id;
+    device_high = device_hi;
+#if TELEMETRY_AUTH_DERIVE
+    /* Device key = AES-128(master, "IBKD" 0 0 device_hi device iid) */
+    key[6] = device_hi;
+    key[7] = device_id;
+    memcpy(key + 8, iid, 8);
+    AES_128.set_key(master_key);
+    AES_128.encrypt(key);
+#else
+    memcpy(key, master_key, sizeof(key));
+#endif
+    CCM_STAR.set_key(key);
+}
+
+uint8_t telemetry_auth_seal(uint8_t *buf, uint8_t len, uint8_t size) {
+    uint8_t nonce[CCM_STAR_NONCE_LENGTH];
+    uint8_t *p;
+
+    if (len < TELEMETRY_HEADER_LEN || buf[0] != (TELEMETRY_MAGIC | TELEMETRY_VERSION) ||
+        len + TELEMETRY_AUTH_OVERHEAD > size) {
+        return 0;
+    }
+
+    /* Make room for the body length byte */
+    memmove(buf + TELEMETRY_HEADER_LEN + 1, buf + TELEMETRY_HEADER_LEN, len - TELEMETRY_HEADER_LEN);
+    buf[0] = TELEMETRY_MAGIC | TELEMETRY_VERSION_AUTH;
+    buf[TELEMETRY_HEADER_LEN] = len - TELEMETRY_HEADER_LEN;
+    len++;
+
+    p = buf + len;
+    p[0] = (uint8_t)(counter >> 24);
+    p[1] = (uint8_t)(counter >> 16);
+    p[2] = (uint8_t)(counter >> 8);
+    p[3] = (uint8_t)counter;
+    len += TELEMETRY_AUTH_COUNTER_LEN;
+
+    /* Nonce: device byte, frame counter, DEVICE_HI, zero padding */
+    memset(nonce, 0, sizeof(nonce));
+    nonce[0] = device;
+    memcpy(nonce + 1, p, TELEMETRY_AUTH_COUNTER_LEN);
+    nonce[1 + TELEMETRY_AUTH_COUNTER_LEN] = device_high;
+    counter++;
+
+    /* Authentication only: the whole frame is associated data */
+    CCM_STAR.aead(nonce, NULL, 0, buf, len, buf + len, TELEMETRY_AUTH_MIC_LEN, 1);
+    return len + TELEMETRY_AUTH_MIC_LEN;
+}
+
+#endif /* TELEMETRY_AUTH */
@@ -0,0 +1,71 @@
+#ifndef TELEMETRY_AUTH_H_
+#define TELEMETRY_AUTH_H_
+
+/*
+ * Optional per-frame authentication of sensor telemetry.
+ *
+ * When TELEMETRY_CONF_AUTH is 1 every frame the sensor runtime sends is
+ * sealed into a TELEMETRY_VERSION_AUTH frame (see telemetry.h): a frame
+ * counter and an AES-CCM MIC of TELEMETRY_AUTH_MIC_LEN bytes are appended.
+ * The payload stays readable (authentication only, no encryption), so the
+ * border router can still count and forward it.
+ *
+ * Each device has its own 128-bit key. By default it is derived from the
+ * pre-shared master key TELEMETRY_CONF_AUTH_KEY as AES-128(master, "IBKD"
+ * 0 0 DEVICE_HI device byte, interface identifier), which the drivers repeat
+ * (drivers/auth.js) from the sender address. The interface identifier (the
+ * last 8 bytes of the node's addresses) sets nodes apart that share a device
+ * byte; DEVICE_HI sets apart native instances, which share one address. With
+ * TELEMETRY_CONF_AUTH_DERIVE 0 the configured key is used as the device key.
+ *
+ * The MIC is computed through Contiki-NG's CCM_STAR driver, which runs on the
+ * AES_128 driver. On Z1 motes, select the CC2420's hardware AES in
+ * project-conf.h so the MSP430 does no block encryption itself:
+ *   #define AES_128_CONF cc2420_aes_128_driver
+ * Otherwise the software AES is used. The frame counter lives in RAM and
+ * restarts at 0 on reboot; the drivers allow that only after the device has
+ * been silent for a while.
+ */
+
+#include "telemetry.h"
+
+#ifdef TELEMETRY_CONF_AUTH
+#define TELEMETRY_AUTH TELEMETRY_CONF_AUTH
+#else
+#define TELEMETRY_AUTH 0
+#endif
+
+#ifdef TELEMETRY_CONF_AUTH_KEY
+#define TELEMETRY_AUTH_KEY TELEMETRY_CONF_AUTH_KEY
+#else
+#define TELEMETRY_AUTH_KEY { 0x49, 0x6f, 0x54, 0x2d, 0x42, 0x6c, 0x6f, 0x63, \
+                             0x6b, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x30, 0x31 }  // Development key only
+#endif
+
+#ifdef TELEMETRY_CONF_AUTH_DERIVE
+#define TELEMETRY_AUTH_DERIVE TELEMETRY_CONF_AUTH_DERIVE
+#else
+#define TELEMETRY_AUTH_DERIVE 1
+#endif
+
+#if TELEMETRY_AUTH
+#if TELEMETRY_ASCII
+#error "TELEMETRY_CONF_AUTH needs binary telemetry (TELEMETRY_CONF_ASCII 0)"
+#endif
+
+/*
+ * Load this device's key from its interface identifier (iid, 8 bytes) and
+ * device id. Call once before the first telemetry_auth_seal().
+ */
+void telemetry_auth_init(const uint8_t *iid, uint8_t device_hi, uint8_t device_id);
+
+/*
+ * Seal the version 1 frame of len bytes in buf, in place. size is the buffer
+ * size, which must leave TELEMETRY_AUTH_OVERHEAD bytes after the frame.
+ * Returns the sealed length, or 0 if buf does not hold a frame or it does
+ * not fit.
+ */
+uint8_t telemetry_auth_seal(uint8_t *buf, uint8_t len, uint8_t size);
+#endif
+
+#endif /* TELEMETRY_AUTH_H_ */
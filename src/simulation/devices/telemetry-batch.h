@@ -0,0 +1,168 @@
+#ifndef TELEMETRY_BATCH_H_
+#define TELEMETRY_BATCH_H_
+
+/*
+ * On-node sample batching for telemetry frames.
+ *
+ * Readings are queued in a small ring buffer and sent together in one batch
+ * frame, which saves the per-packet IPv6/UDP overhead and radio wake-ups.
+ * A flush is requested when any of these holds:
+ *   - the buffer holds TELEMETRY_BATCH_MAX_SAMPLES samples,
+ *   - the oldest sample is TELEMETRY_BATCH_MAX_AGE seconds old,
+ *   - the tracked value moved by at least the batch's delta since the last flush.
+ *
+ * Each sample is sent with its age in seconds so receivers can rebuild the
+ * sampling time. With a 10 s sample period the defaults (6 samples / 60 s)
+ * turn six datagrams per minute into one without dropping any reading.
+ */
+
+#include "telemetry.h"
+
+#ifdef TELEMETRY_CONF_BATCH_MAX_SAMPLES
+#define TELEMETRY_BATCH_MAX_SAMPLES TELEMETRY_CONF_BATCH_MAX_SAMPLES
+#else
+#define TELEMETRY_BATCH_MAX_SAMPLES 6
+#endif
+
+#ifdef TELEMETRY_CONF_BATCH_MAX_AGE
+#define TELEMETRY_BATCH_MAX_AGE TELEMETRY_CONF_BATCH_MAX_AGE
+#else
+#define TELEMETRY_BATCH_MAX_AGE 60      // Seconds
+#endif
+
+#ifdef TELEMETRY_CONF_BATCH_DELTA
+#define TELEMETRY_BATCH_DELTA TELEMETRY_CONF_BATCH_DELTA
+#else
+#define TELEMETRY_BATCH_DELTA 0         // Change-triggered flush disabled
+#endif
+
+#define TELEMETRY_SAMPLE_MAX_LEN 16     // Encoded fields per sample, excluding age
+
+struct telemetry_sample {
+    uint32_t time;                              // Sampling time in seconds
+    uint8_t len;                                // Bytes used in fields
+    uint8_t fields[TELEMETRY_SAMPLE_MAX_LEN];   // Encoded fields
+};
+
+struct telemetry_batch {
+    struct telemetry_sample samples[TELEMETRY_BATCH_MAX_SAMPLES];
+    uint8_t head;           // Oldest queued sample
+    uint8_t count;          // Queued samples
+    uint32_t delta;         // Change that forces a flush, 0 disables
+    uint32_t last_value;    // Tracked value at the last flush
+    uint8_t has_value;      // Whether last_value is valid
+};
+
+/*---------------------------------------------------------------------------*/
+/* Reset a batch. delta is the value change that triggers an early flush. */
+static inline void telemetry_batch_init(struct telemetry_batch *batch, uint32_t delta) {
+    batch->head = 0;
+    batch->count = 0;
+    batch->delta = delta;
+    batch->has_value = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Check the count and age policies */
+static inline int telemetry_batch_due(const struct telemetry_batch *batch, uint32_t now) {
+    if (batch->count == 0) {
+        return 0;
+    }
+    return batch->count >= TELEMETRY_BATCH_MAX_SAMPLES ||
+           now - batch->samples[batch->head].time >= TELEMETRY_BATCH_MAX_AGE;
+}
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Queue one sample. value is the reading tracked by the change policy.
+ * Returns 1 when the caller should flush now, 0 otherwise, and -1 if the
+ * sample was rejected. Queued samples are never overwritten: the buffer asks
+ * for a flush as soon as it is full.
+ */
+static inline int telemetry_batch_add(struct telemetry_batch *batch, const uint8_t *fields, uint8_t len,
+                                      uint32_t value, uint32_t now) {
+    struct telemetry_sample *sample;
+    uint32_t change;
+
+    if (batch->count >= TELEMETRY_BATCH_MAX_SAMPLES || len > TELEMETRY_SAMPLE_MAX_LEN) {
+        return -1;
+    }
+
+    sample = &batch->samples[(batch->head + batch->count) % TELEMETRY_BATCH_MAX_SAMPLES];
+    sample->time = now;
+    sample->len = len;
+    memcpy(sample->fields, fields, len);
+    batch->count++;
+
+    if (batch->delta > 0 && batch->has_value) {
+        change = value > batch->last_value ? value - batch->last_value : batch->last_value - value;
+        if (change >= batch->delta) {
+            batch->last_value = value;
+            return 1;
+        }
+    }
+    if (!batch->has_value) {
+        batch->last_value = value;
+        batch->has_value = 1;
+    }
+
+    if (telemetry_batch_due(batch, now)) {
+        batch->last_value = value;
+        return 1;
+    }
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Encode as many queued samples as fit into buf and drop them from the
+ * buffer. Returns the frame length, or 0 once the buffer is empty. Call it
+ * until it returns 0 to drain everything.
+ */
+static inline uint8_t telemetry_batch_encode(struct telemetry_batch *batch, uint8_t *buf, uint8_t size,
+                                             uint8_t sensor_type, uint8_t device_id, uint32_t now) {
+    struct telemetry_frame frame;
+    struct telemetry_frame sample_fields;
+    const struct telemetry_sample *sample;
+    uint8_t *len_byte;
+    uint8_t sent = 0;
+
+    if (batch->count == 0) {
+        return 0;
+    }
+
+    telemetry_begin(&frame, buf, size, sensor_type | TELEMETRY_FLAG_BATCH, device_id);
+    if (frame.len == 0 || frame.len >= frame.size) {
+        return 0;
+    }
+    buf[frame.len++] = 0;   // Sample count, patched below
+
+    while (batch->count > 0) {
+        sample = &batch->samples[batch->head];
+
+        /* Length byte + fields + age tag and up to four age bytes */
+        if (frame.len + 1 + sample->len + 1 + TELEMETRY_MAX_VALUE_LEN > frame.size) {
+            break;
+        }
+
+        len_byte = &buf[frame.len++];
+        memcpy(&buf[frame.len], sample->fields, sample->len);
+        telemetry_begin_fields(&sample_fields, &buf[frame.len], frame.size - frame.len);
+        sample_fields.len = sample->len;
+        telemetry_put(&sample_fields, TELEMETRY_FIELD_AGE_S, now - sample->time);
+        *len_byte = sample_fields.len;
+        frame.len += sample_fields.len;
+
+        batch->head = (batch->head + 1) % TELEMETRY_BATCH_MAX_SAMPLES;
+        batch->count--;
+        sent++;
+    }
+
+    if (sent == 0) {
+        return 0;
+    }
+    buf[TELEMETRY_HEADER_LEN] = sent;
+    return frame.len;
+}
+
+#endif /* TELEMETRY_BATCH_H_ */
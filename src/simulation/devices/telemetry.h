@@ -0,0 +1,277 @@
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/*
+ * Compact binary telemetry frames shared by all sensor firmwares.
+ *
+ * Frame layout (version 1):
+ *   byte 0    TELEMETRY_MAGIC | TELEMETRY_VERSION (0xB1, never printable ASCII)
+ *   byte 1    sensor type (TELEMETRY_SENSOR_*)
+ *   byte 2    device id (last byte of the link-layer address)
+ *   byte 3..  fields: one tag byte followed by 0-4 value bytes
+ *
+ * A tag holds the field id in its upper 5 bits and the value length in its
+ * lower 3 bits. Values are unsigned, big-endian and trimmed to the fewest
+ * bytes, so a zero flag costs only its tag. A typical reading is 5-7 bytes.
+ *
+ * Batch frames set TELEMETRY_FLAG_BATCH in the sensor type byte. Byte 3 then
+ * holds the sample count, and each sample is a length byte followed by its
+ * fields (see telemetry-batch.h).
+ *
+ * The border router appends a trailer to every frame it forwards: one
+ * TELEMETRY_FIELD_HOP_TIME_MS field, always with a 4-byte value. In a plain
+ * frame it is simply the last field. In a batch frame it follows the last
+ * sample and applies to all of them.
+ *
+ * Authenticated frames (TELEMETRY_VERSION_AUTH, see telemetry-auth.h) wrap a
+ * version 1 frame:
+ *   bytes 0-2 header, with TELEMETRY_MAGIC | TELEMETRY_VERSION_AUTH
+ *   byte 3    body length L
+ *   4..       the version 1 body (fields, or count and samples), L bytes
+ *   then      4-byte frame counter and a TELEMETRY_AUTH_MIC_LEN byte AES-CCM MIC
+ * The MIC covers everything before it. A hop trailer goes after the MIC.
+ *
+ * The header only depends on the C library so host tools can share it.
+ * Build with TELEMETRY_CONF_ASCII=1 to keep the legacy "key:value,..." text.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef TELEMETRY_CONF_ASCII
+#define TELEMETRY_ASCII TELEMETRY_CONF_ASCII
+#else
+#define TELEMETRY_ASCII 0
+#endif
+
+#ifdef TELEMETRY_CONF_MAX_FRAME
+#define TELEMETRY_MAX_FRAME TELEMETRY_CONF_MAX_FRAME
+#else
+#define TELEMETRY_MAX_FRAME 64      // Enough for one 802.15.4 frame without fragmentation
+#endif
+
+#define TELEMETRY_MAGIC        0xB0
+#define TELEMETRY_VERSION      1
+#define TELEMETRY_HEADER_LEN   3
+#define TELEMETRY_MAX_VALUE_LEN 4
+#define TELEMETRY_VERSION_AUTH 2
+#define TELEMETRY_AUTH_COUNTER_LEN 4
+
+#ifdef TELEMETRY_CONF_AUTH_MIC_LEN
+#define TELEMETRY_AUTH_MIC_LEN TELEMETRY_CONF_AUTH_MIC_LEN
+#else
+#define TELEMETRY_AUTH_MIC_LEN 4    // CCM MIC bytes: 4, 8 or 16
+#endif
+
+#define TELEMETRY_AUTH_OVERHEAD (1 + TELEMETRY_AUTH_COUNTER_LEN + TELEMETRY_AUTH_MIC_LEN)
+
+/* Sensor types, ordered like the sensor UDP ports 8843-8847 */
+#define TELEMETRY_SENSOR_INTEGRITY    1
+#define TELEMETRY_SENSOR_MONITOR      2
+#define TELEMETRY_SENSOR_AVAILABILITY 3
+#define TELEMETRY_SENSOR_NETWORK      4
+#define TELEMETRY_SENSOR_SECURITY     5
+#define TELEMETRY_SENSOR_ENERGY       6   // Energest record (energy-monitor.c)
+#define TELEMETRY_SENSOR_CONTROL      7   // Border router to sensor control message
+#define TELEMETRY_SENSOR_MASK         0x7F
+#define TELEMETRY_FLAG_BATCH          0x80
+
+/* Field ids (5 bits). Keep in sync with drivers/telemetry.js */
+#define TELEMETRY_FIELD_BREACH_FLAG     1
+#define TELEMETRY_FIELD_INTEGRITY_FLAG  2
+#define TELEMETRY_FIELD_AVAILABILITY    3
+#define TELEMETRY_FIELD_LATENCY_MS      4
+#define TELEMETRY_FIELD_PACKET_LOSS     5
+#define TELEMETRY_FIELD_LOG_ID          6
+#define TELEMETRY_FIELD_STATUS          7
+#define TELEMETRY_FIELD_AGE_S           8   // Seconds between sampling and transmit
+#define TELEMETRY_FIELD_SEQ             9   // Per-node, per-role sample sequence number (16 bit)
+#define TELEMETRY_FIELD_CPU_MS          10  // Energest times over the last interval
+#define TELEMETRY_FIELD_LPM_MS          11
+#define TELEMETRY_FIELD_TX_MS           12
+#define TELEMETRY_FIELD_LISTEN_MS       13
+#define TELEMETRY_FIELD_SLOWDOWN        14  // Control: report interval multiplier, 1 = normal
+#define TELEMETRY_FIELD_HOLD_S          15  // Control: seconds the slowdown applies
+#define TELEMETRY_FIELD_DEVICE_HI       16  // Device id bits above the header byte, for >256 devices
+#define TELEMETRY_FIELD_NET_TIME_MS     17  // Sampling time on the synchronized network clock (TSCH)
+#define TELEMETRY_FIELD_NODE_TIME_MS    18  // Sampling time on the node's own clock (not synchronized)
+#define TELEMETRY_FIELD_HOP_TIME_MS     19  // Border router receive time, network clock (frame trailer)
+
+#define TELEMETRY_HOP_TRAILER_LEN (1 + 4)
+
+#define TELEMETRY_STATUS_OK 0       // Decoded as "Monitor_OK" by the drivers
+
+struct telemetry_frame {
+    uint8_t *buf;       // Output buffer
+    uint8_t size;       // Capacity of buf
+    uint8_t len;        // Bytes written so far
+};
+
+/*---------------------------------------------------------------------------*/
+/* Start a new frame for the given sensor type and device id */
+static inline void telemetry_begin(struct telemetry_frame *frame, uint8_t *buf, uint8_t size,
+                                   uint8_t sensor_type, uint8_t device_id) {
+    frame->buf = buf;
+    frame->size = size;
+    frame->len = 0;
+
+    if (size >= TELEMETRY_HEADER_LEN) {
+        buf[0] = TELEMETRY_MAGIC | TELEMETRY_VERSION;
+        buf[1] = sensor_type;
+        buf[2] = device_id;
+        frame->len = TELEMETRY_HEADER_LEN;
+    } else {
+        frame->size = 0;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Start a header-less field list, e.g. one sample of a batch */
+static inline void telemetry_begin_fields(struct telemetry_frame *frame, uint8_t *buf, uint8_t size) {
+    frame->buf = buf;
+    frame->size = size;
+    frame->len = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Append one field. Returns 0 if the frame has no room left. */
+static inline int telemetry_put(struct telemetry_frame *frame, uint8_t field, uint32_t value) {
+    uint8_t value_len = 0;
+    uint32_t rest;
+
+    for (rest = value; rest != 0; rest >>= 8) {
+        value_len++;
+    }
+
+    if (frame->len + 1 + value_len > frame->size) {
+        return 0;
+    }
+
+    frame->buf[frame->len++] = (uint8_t)((field << 3) | value_len);
+    while (value_len > 0) {
+        value_len--;
+        frame->buf[frame->len++] = (uint8_t)(value >> (8 * value_len));
+    }
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Check whether a received buffer starts with a binary telemetry header */
+static inline int telemetry_is_frame(const uint8_t *data, uint16_t datalen) {
+    return datalen >= TELEMETRY_HEADER_LEN &&
+           data[0] == (TELEMETRY_MAGIC | TELEMETRY_VERSION);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Check whether a received buffer is an authenticated frame whose body fits */
+static inline int telemetry_is_auth_frame(const uint8_t *data, uint16_t datalen) {
+    return datalen > TELEMETRY_HEADER_LEN &&
+           data[0] == (TELEMETRY_MAGIC | TELEMETRY_VERSION_AUTH) &&
+           TELEMETRY_HEADER_LEN + 1 + data[TELEMETRY_HEADER_LEN] + TELEMETRY_AUTH_COUNTER_LEN <= datalen;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Look up a field in an encoded field list. Returns 0 if it is absent. */
+static inline int telemetry_get_field(const uint8_t *fields, uint16_t len, uint8_t field, uint32_t *value) {
+    uint16_t pos = 0;
+
+    while (pos < len) {
+        uint8_t tag = fields[pos++];
+        uint8_t value_len = tag & 0x07;
+        uint32_t v = 0;
+
+        if (value_len > TELEMETRY_MAX_VALUE_LEN || pos + value_len > len) {
+            return 0;
+        }
+        while (value_len-- > 0) {
+            v = (v << 8) | fields[pos++];
+        }
+        if ((tag >> 3) == field) {
+            *value = v;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Sample-by-sample reader for received frames. A plain frame yields one
+ * sample, a batch frame yields each of its samples in transmit order.
+ */
+struct telemetry_reader {
+    const uint8_t *data;
+    uint16_t len;
+    uint16_t pos;
+    uint8_t remaining;  // Samples not yet returned
+    uint8_t batch;      // Non-zero for batch frames
+};
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Prepare a reader. Returns 0 if the buffer is not a telemetry frame. The
+ * samples of an authenticated frame are read without checking its MIC.
+ */
+static inline int telemetry_reader_init(struct telemetry_reader *reader, const uint8_t *data, uint16_t len) {
+    uint16_t body = TELEMETRY_HEADER_LEN;
+
+    if (telemetry_is_auth_frame(data, len)) {
+        body = TELEMETRY_HEADER_LEN + 1;
+        len = body + data[TELEMETRY_HEADER_LEN];
+    } else if (!telemetry_is_frame(data, len)) {
+        return 0;
+    }
+
+    reader->data = data;
+    reader->len = len;
+    reader->batch = (data[1] & TELEMETRY_FLAG_BATCH) != 0;
+
+    if (reader->batch) {
+        if (len < body + 1) {
+            return 0;
+        }
+        reader->remaining = data[body];
+        reader->pos = body + 1;
+    } else {
+        reader->remaining = 1;
+        reader->pos = body;
+    }
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Return the next sample's field list. Returns 0 when done or malformed. */
+static inline int telemetry_reader_next(struct telemetry_reader *reader, const uint8_t **fields, uint8_t *fields_len) {
+    uint8_t sample_len;
+
+    if (reader->remaining == 0 || reader->pos > reader->len) {
+        return 0;
+    }
+
+    if (!reader->batch) {
+        *fields = reader->data + reader->pos;
+        *fields_len = (uint8_t)(reader->len - reader->pos);
+        reader->pos = reader->len;
+        reader->remaining = 0;
+        return 1;
+    }
+
+    if (reader->pos >= reader->len) {
+        reader->remaining = 0;
+        return 0;
+    }
+
+    sample_len = reader->data[reader->pos];
+    if (reader->pos + 1 + sample_len > reader->len) {
+        reader->remaining = 0;
+        return 0;
+    }
+
+    *fields = reader->data + reader->pos + 1;
+    *fields_len = sample_len;
+    reader->pos += 1 + sample_len;
+    reader->remaining--;
+    return 1;
+}
+
+#endif /* TELEMETRY_H_ */
@@ -0,0 +1,62 @@
+#ifndef TSCH_ORCHESTRA_CONF_H_
+#define TSCH_ORCHESTRA_CONF_H_
+
+/*
+ * TSCH + Orchestra MAC mode.
+ *
+ * Include this from project-conf.h. It only takes effect in images built
+ * with MAKE_MAC=MAKE_MAC_TSCH, the Orchestra module and orchestra-urgent.c
+ * (see docs/DETAILS.md). CSMA builds are unchanged.
+ *
+ * The border router is the TSCH coordinator and time source of the whole
+ * mesh. Orchestra derives the schedule from the RPL topology, with one extra
+ * slotframe in front of the unicast one: a short shared slotframe
+ * (orchestra-urgent.c) that carries only security and integrity reports, so
+ * breach flags do not queue behind routine traffic for a unicast cell.
+ */
+
+#if MAC_CONF_WITH_TSCH
+
+/* Orchestra builds the schedule, so the 6TiSCH minimal schedule is not installed */
+#define TSCH_SCHEDULE_CONF_WITH_6TISCH_MINIMAL 0
+#define TSCH_CONF_WITH_LINK_SELECTOR 1
+#define TSCH_CONF_AUTOSTART 1
+
+/* Four channels keep joining fast in Cooja while still hopping */
+#define TSCH_CONF_DEFAULT_HOPPING_SEQUENCE TSCH_HOPPING_SEQUENCE_4_4
+
+/*
+ * Slotframes, highest priority first: beacons, urgent sensor reports,
+ * per-neighbour unicast (receiver-based, for RPL non-storing mode) and the
+ * shared slotframe for broadcast and RPL traffic.
+ */
+#ifndef __ASSEMBLER__
+extern struct orchestra_rule urgent_sensor_rule;
+#endif
+#define ORCHESTRA_CONF_RULES { &eb_per_time_source, &urgent_sensor_rule, \
+                               &unicast_per_neighbor_rpl_ns, &default_common }
+
+#ifndef ORCHESTRA_CONF_UNICAST_PERIOD
+#define ORCHESTRA_CONF_UNICAST_PERIOD 17
+#endif
+
+/* Urgent slotframe: one shared cell every ORCHESTRA_URGENT_PERIOD timeslots */
+#ifdef ORCHESTRA_URGENT_CONF_PERIOD
+#define ORCHESTRA_URGENT_PERIOD ORCHESTRA_URGENT_CONF_PERIOD
+#else
+#define ORCHESTRA_URGENT_PERIOD 7              // 70 ms with 10 ms timeslots
+#endif
+
+#ifdef ORCHESTRA_URGENT_CONF_CHANNEL_OFFSET
+#define ORCHESTRA_URGENT_CHANNEL_OFFSET ORCHESTRA_URGENT_CONF_CHANNEL_OFFSET
+#else
+#define ORCHESTRA_URGENT_CHANNEL_OFFSET 1
+#endif
+
+/* Collector ports whose datagrams use the urgent slotframe: integrity and security */
+#define ORCHESTRA_URGENT_PORT_INTEGRITY 8843
+#define ORCHESTRA_URGENT_PORT_SECURITY 8847
+
+#endif /* MAC_CONF_WITH_TSCH */
+
+#endif /* TSCH_ORCHESTRA_CONF_H_ */
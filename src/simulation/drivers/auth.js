@@ -0,0 +1,202 @@
+'use strict';
+
+const crypto = require('crypto');
+const fs = require('fs');
+const { interfaceId } = require('./capture');     // Sender identity the keys are bound to
+const { frameDeviceHi } = require('./telemetry'); // DEVICE_HI, part of key and nonce
+
+// ------------------------------------------------------------
+// Authenticated Telemetry Frames
+// ------------------------------------------------------------
+// Mirrors devices/telemetry-auth.h. Firmware built with TELEMETRY_CONF_AUTH
+// sends version 2 frames: the version 1 header, a body length byte, the
+// version 1 body, a 4-byte frame counter and an AES-CCM MIC over everything
+// before it. The MIC is checked on the parser workers, so verification runs
+// in parallel with parsing; the frame counters are checked on the main
+// thread (ReplayGuard), which sees every datagram.
+//
+// Device keys are derived from the pre-shared master key as on the motes,
+// AES-128(master, "IBKD" 0 0 DEVICE_HI device byte, interface identifier),
+// where the interface identifier is the last 8 bytes of the sender address.
+// Nodes that share a device byte, and native instances that share an
+// address, therefore get different keys and replay windows. A JSON file of
+// { "<iid hex>": "<key hex>" } or { "<iid hex>/<device id>": "<key hex>" }
+// can give devices their own keys.
+
+const TELEMETRY_MAGIC = 0xb0;
+const TELEMETRY_VERSION = 1;
+const TELEMETRY_VERSION_AUTH = 2;
+const TELEMETRY_HEADER_LEN = 3;
+const COUNTER_LEN = 4;
+const NONCE_LEN = 13;
+
+// Longest silence of a healthy, steady node: the heartbeat cap
+// (SENSOR_HEARTBEAT_MAX_FACTOR x 10 s sampling period) stretched by the border
+// router's congestion slowdown (INGEST_CONGESTION_SLOWDOWN), plus the batch age
+// (TELEMETRY_BATCH_MAX_AGE) its last sample may wait on the node
+const STEADY_SILENCE_S = 32 * 10 * 4 + 60;
+
+const DEFAULTS = {
+  masterKey: process.env.INGEST_AUTH_KEY || Buffer.from('IoT-Blockchain01').toString('hex'), // Firmware default
+  keysFile: process.env.INGEST_AUTH_KEYS || null,
+  micLen: Number(process.env.INGEST_AUTH_MIC_LEN) || 4,             // TELEMETRY_CONF_AUTH_MIC_LEN
+  required: process.env.INGEST_AUTH_REQUIRED === '1',               // Reject frames without a MIC
+  rebootMs: (Number(process.env.INGEST_AUTH_REBOOT_S) || 2 * STEADY_SILENCE_S) * 1000, // Silence after which a counter may restart
+};
+
+const REPLAY_WINDOW = 32; // Counters below the highest that may still arrive late, e.g. via another root
+
+const deviceKeys = new Map(); // "<iid>/<device id>" -> key
+let fileKeys = null;
+
+// Device id as the readings carry it: the device byte, widened by DEVICE_HI
+function deviceId(deviceHi, device) {
+  return (deviceHi * 256 + device).toString(16).toUpperCase().padStart(deviceHi ? 4 : 2, '0');
+}
+
+// ------------------------------------------------------------
+// Function: Look Up a Device Key
+// ------------------------------------------------------------
+function deviceKey(iid, deviceHi, device) {
+  const sender = `${iid}/${deviceId(deviceHi, device)}`;
+  if (deviceKeys.has(sender)) {
+    return deviceKeys.get(sender);
+  }
+
+  if (fileKeys === null) {
+    const configuredKeys = DEFAULTS.keysFile ? JSON.parse(fs.readFileSync(DEFAULTS.keysFile, 'utf8')) : {};
+    fileKeys = Object.fromEntries(Object.entries(configuredKeys).map(([name, key]) => {
+      const [keyIid, keyDevice = ''] = name.split('/');
+      return [`${keyIid.toLowerCase()}/${keyDevice.toUpperCase()}`, key];
+    }));
+  }
+  const configured = fileKeys[sender] || fileKeys[`${iid}/`];
+
+  let key;
+  if (configured) {
+    key = Buffer.from(configured, 'hex');
+  } else {
+    const block = Buffer.alloc(16);
+    block.write('IBKD', 0, 'ascii');
+    block[6] = deviceHi;
+    block[7] = device;
+    Buffer.from(iid, 'hex').copy(block, 8);
+    const cipher = crypto.createCipheriv('aes-128-ecb', Buffer.from(DEFAULTS.masterKey, 'hex'), null);
+    cipher.setAutoPadding(false);
+    key = Buffer.concat([cipher.update(block), cipher.final()]);
+  }
+
+  deviceKeys.set(sender, key);
+  return key;
+}
+
+// ------------------------------------------------------------
+// Function: Detect Authenticated Frames
+// ------------------------------------------------------------
+function isAuthFrame(message) {
+  return message.length > TELEMETRY_HEADER_LEN &&
+    message[0] === (TELEMETRY_MAGIC | TELEMETRY_VERSION_AUTH);
+}
+
+// The MIC of an authentication-only CCM: the frame is associated data
+function computeMic(key, nonce, frame, micLen) {
+  const cipher = crypto.createCipheriv('aes-128-ccm', key, nonce, { authTagLength: micLen });
+  cipher.setAAD(frame, { plaintextLength: 0 });
+  cipher.update(Buffer.alloc(0)); // OpenSSL only computes the tag once update() has run
+  cipher.final();
+  return cipher.getAuthTag();
+}
+
+// ------------------------------------------------------------
+// Function: Verify and Unwrap an Authenticated Frame
+// ------------------------------------------------------------
+// Returns the equivalent version 1 frame (with any hop trailer after it),
+// the device id and the frame counter. source is the sender address, whose
+// interface identifier selects the key. Throws if the MIC does not match.
+function openAuthFrame(message, source, micLen = DEFAULTS.micLen) {
+  const bodyLen = message[TELEMETRY_HEADER_LEN];
+  const counterAt = TELEMETRY_HEADER_LEN + 1 + bodyLen;
+  const micAt = counterAt + COUNTER_LEN;
+  if (micAt + micLen > message.length) {
+    throw new Error('Truncated authenticated telemetry frame');
+  }
+
+  const frame = Buffer.concat([
+    message.subarray(0, TELEMETRY_HEADER_LEN),
+    message.subarray(TELEMETRY_HEADER_LEN + 1, counterAt),
+    message.subarray(micAt + micLen), // Hop trailer added by the border router
+  ]);
+  frame[0] = TELEMETRY_MAGIC | TELEMETRY_VERSION;
+
+  // DEVICE_HI is read before the MIC is checked; the MIC covers it, and a
+  // changed value selects another key
+  const device = message[2];
+  const deviceHi = frameDeviceHi(frame);
+  const iid = interfaceId(source);
+  const nonce = Buffer.alloc(NONCE_LEN);
+  nonce[0] = device;
+  message.copy(nonce, 1, counterAt, micAt);
+  nonce[1 + COUNTER_LEN] = deviceHi;
+
+  const mic = computeMic(deviceKey(iid, deviceHi, device), nonce, message.subarray(0, micAt), micLen);
+  if (!crypto.timingSafeEqual(mic, message.subarray(micAt, micAt + micLen))) {
+    throw new Error(`Telemetry MIC check failed for device ${deviceId(deviceHi, device)} at ${iid}`);
+  }
+
+  return { frame, device: deviceId(deviceHi, device), counter: message.readUInt32BE(counterAt) };
+}
+
+// ------------------------------------------------------------
+// Class: Replay Guard
+// ------------------------------------------------------------
+// Tracks the highest frame counter per sender ("<iid>/<device id>") and
+// which of the REPLAY_WINDOW counters below it were seen. A counter seen before is a
+// copy: the same frame forwarded by two roots, or replayed. Older counters
+// are replays, except that a device silent for rebootMs may start again
+// from a counter below REPLAY_WINDOW, as it does after a reboot. rebootMs
+// must exceed the longest silence of a steady node (STEADY_SILENCE_S); the
+// low-counter rule keeps an old frame replayed after such a silence from
+// resetting the window.
+class ReplayGuard {
+  constructor({ rebootMs = DEFAULTS.rebootMs } = {}) {
+    this.rebootMs = rebootMs;
+    this.senders = new Map(); // sender -> { highest, window, lastMs }
+  }
+
+  // Returns 'fresh', 'duplicate' or 'replay'
+  check(sender, counter, now = Date.now()) {
+    const entry = this.senders.get(sender);
+    if (!entry || (counter < REPLAY_WINDOW && counter + REPLAY_WINDOW <= entry.highest &&
+                   now - entry.lastMs >= this.rebootMs)) {
+      this.senders.set(sender, { highest: counter, window: 1, lastMs: now });
+      return 'fresh';
+    }
+
+    if (counter > entry.highest) {
+      const shift = counter - entry.highest;
+      entry.window = shift >= REPLAY_WINDOW ? 1 : ((entry.window << shift) | 1) >>> 0;
+      entry.highest = counter;
+      entry.lastMs = now;
+      return 'fresh';
+    }
+
+    const age = entry.highest - counter;
+    if (age >= REPLAY_WINDOW) {
+      return 'replay';
+    }
+    const bit = (1 << age) >>> 0;
+    if (entry.window & bit) {
+      return 'duplicate';
+    }
+    entry.window = (entry.window | bit) >>> 0;
+    entry.lastMs = now;
+    return 'fresh';
+  }
+}
+
+module.exports = {
+  AUTH_REQUIRED: DEFAULTS.required,
+  isAuthFrame,
+  openAuthFrame,
+  ReplayGuard,
+};
@@ -0,0 +1,180 @@
+'use strict';
+
+const fs = require('fs');
+const net = require('net');
+
+// ------------------------------------------------------------
+// Ingest Capture Writer
+// ------------------------------------------------------------
+// Records every datagram the collectors receive, with its source address,
+// source and collector ports and arrival time, so a load scenario can be
+// replayed into the drivers without Cooja (replay-source.js, tools/replay.c).
+// The file format is described in tools/capture.h; keep the two in sync.
+
+const MAGIC = 'IBCP';
+const VERSION = 1;
+const FILE_HEADER_LEN = 16;
+const RECORD_HEADER_LEN = 32;
+const FLUSH_BYTES = 64 * 1024;  // Buffered bytes written in one call
+const FLUSH_INTERVAL_MS = 1000; // Longest time a record stays in memory
+
+// ------------------------------------------------------------
+// Function: Encode an Address as 16 Bytes
+// ------------------------------------------------------------
+// IPv4 sources are stored IPv4-mapped (::ffff:a.b.c.d); a zone ID is dropped.
+function addressBytes(address) {
+  const bytes = Buffer.alloc(16);
+  let text = address.split('%')[0];
+
+  if (net.isIPv4(text)) {
+    text = `::ffff:${text}`;
+  }
+  if (!net.isIPv6(text)) {
+    return bytes;
+  }
+
+  // A trailing dotted quad becomes two groups
+  const quad = /(\d+)\.(\d+)\.(\d+)\.(\d+)$/.exec(text);
+  if (quad) {
+    const [a, b, c, d] = quad.slice(1).map(Number);
+    text = text.slice(0, quad.index) + `${((a << 8) | b).toString(16)}:${((c << 8) | d).toString(16)}`;
+  }
+
+  const [head, tail] = text.split('::');
+  const headGroups = head ? head.split(':') : [];
+  const tailGroups = tail !== undefined && tail ? tail.split(':') : [];
+  const groups = tail === undefined
+    ? headGroups
+    : headGroups.concat(new Array(8 - headGroups.length - tailGroups.length).fill('0'), tailGroups);
+
+  groups.forEach((group, i) => bytes.writeUInt16BE(parseInt(group, 16), i * 2));
+  return bytes;
+}
+
+// The interface identifier (last 8 bytes) of an address, as hex. A node
+// keeps it when it fails over to another border router and its /64 prefix
+// changes, so it names the sender across roots and serial uplinks.
+function interfaceId(address) {
+  return addressBytes(address).toString('hex', 8);
+}
+
+// The text form of 16 address bytes, with every group written out
+function addressText(bytes) {
+  const groups = [];
+  for (let i = 0; i < 16; i += 2) {
+    groups.push(bytes.readUInt16BE(i).toString(16));
+  }
+  return groups.join(':');
+}
+
+// ------------------------------------------------------------
+// Function: Read a Capture
+// ------------------------------------------------------------
+// Returns the records of a capture file's contents as { timeUs, remote:
+// { address, port }, port, message }. As in tools/capture.h, a truncated
+// last record (a capture still being written) is ignored.
+function readCapture(buffer) {
+  if (buffer.length < FILE_HEADER_LEN || buffer.toString('ascii', 0, 4) !== MAGIC ||
+      buffer.readUInt16LE(4) !== VERSION || buffer.readUInt16LE(6) !== RECORD_HEADER_LEN) {
+    throw new Error(`Not a version ${VERSION} ingest capture`);
+  }
+
+  const records = [];
+  let offset = FILE_HEADER_LEN;
+  while (offset + RECORD_HEADER_LEN <= buffer.length) {
+    const length = buffer.readUInt16LE(offset + 28);
+    const end = offset + RECORD_HEADER_LEN + length;
+    if (end > buffer.length) {
+      break;
+    }
+    records.push({
+      timeUs: buffer.readBigUInt64LE(offset),
+      remote: { address: addressText(buffer.subarray(offset + 8, offset + 24)), port: buffer.readUInt16LE(offset + 24) },
+      port: buffer.readUInt16LE(offset + 26),
+      message: buffer.subarray(offset + RECORD_HEADER_LEN, end),
+    });
+    offset = end;
+  }
+  return records;
+}
+
+// ------------------------------------------------------------
+// Class: Capture Writer
+// ------------------------------------------------------------
+// Each run starts a new capture: the file is truncated and gets a header
+// with this run's start time. Appending would put a later run's records
+// under the first run's header, and replay would wait out the gap between.
+// Records are buffered and written synchronously, so whatever is pending
+// when the process exits (including process.exit() after a drain) is kept.
+class CaptureWriter {
+  constructor(filePath) {
+    this.fd = fs.openSync(filePath, 'w');
+    this.pending = [];
+    this.pendingBytes = 0;
+    this.records = 0;
+
+    // Arrival times: wall clock at start plus a monotonic offset in microseconds
+    this.startUs = BigInt(Date.now()) * 1000n;
+    this.startHr = process.hrtime.bigint();
+
+    const header = Buffer.alloc(FILE_HEADER_LEN);
+    header.write(MAGIC, 0, 'ascii');
+    header.writeUInt16LE(VERSION, 4);
+    header.writeUInt16LE(RECORD_HEADER_LEN, 6);
+    header.writeBigUInt64LE(this.startUs, 8);
+    fs.writeSync(this.fd, header);
+
+    this.flushTimer = setInterval(() => this.flush(), FLUSH_INTERVAL_MS);
+    this.flushTimer.unref();
+    process.on('exit', () => this.close());
+  }
+
+  // ------------------------------------------------------------
+  // Function: Record One Datagram
+  // ------------------------------------------------------------
+  record(message, remote, port) {
+    if (this.fd === null) {
+      return;
+    }
+    const header = Buffer.alloc(RECORD_HEADER_LEN);
+    header.writeBigUInt64LE(this.startUs + (process.hrtime.bigint() - this.startHr) / 1000n, 0);
+    addressBytes(remote.address).copy(header, 8);
+    header.writeUInt16LE(remote.port, 24);
+    header.writeUInt16LE(port, 26);
+    header.writeUInt16LE(message.length, 28);
+
+    this.pending.push(header, message);
+    this.pendingBytes += RECORD_HEADER_LEN + message.length;
+    this.records++;
+    if (this.pendingBytes >= FLUSH_BYTES) {
+      this.flush();
+    }
+  }
+
+  flush() {
+    if (this.pending.length === 0 || this.fd === null) {
+      return;
+    }
+    fs.writeSync(this.fd, Buffer.concat(this.pending, this.pendingBytes));
+    this.pending = [];
+    this.pendingBytes = 0;
+  }
+
+  close() {
+    if (this.fd === null) {
+      return;
+    }
+    this.flush();
+    clearInterval(this.flushTimer);
+    fs.closeSync(this.fd);
+    this.fd = null;
+  }
+}
+
+module.exports = {
+  RECORD_HEADER_LEN,
+  addressBytes,
+  interfaceId,
+  readCapture,
+  CaptureWriter,
+};
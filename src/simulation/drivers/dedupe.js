@@ -0,0 +1,60 @@
+'use strict';
+
+// ------------------------------------------------------------
+// Cross-Root Duplicate Filter
+// ------------------------------------------------------------
+// With several border routers, a sample can reach the host more than once:
+// a sensor that fails over to another root re-sends its queued batch, and
+// link-layer retransmissions can be forwarded by two roots. Binary samples
+// carry a per-node, per-role sequence number, so a (sensor, sender, device,
+// seq) key seen within the window is a copy. The sender is the source's
+// interface identifier (interfaceId() in capture.js): the device byte alone
+// is shared by nodes whose addresses differ only above it, and the /64
+// prefix changes with the root a copy came through. Readings without a seq
+// (legacy ASCII payloads) always pass.
+
+const DEFAULT_WINDOW_MS = 2 * 60 * 1000; // Copies arrive within seconds; seq wraps after hours
+const DEFAULT_MAX_ENTRIES = 65536;
+
+class DuplicateFilter {
+  constructor({ windowMs = DEFAULT_WINDOW_MS, maxEntries = DEFAULT_MAX_ENTRIES } = {}) {
+    this.windowMs = windowMs;
+    this.maxEntries = maxEntries;
+    this.seen = new Map(); // key -> time first seen, oldest first
+    this.duplicates = 0;
+  }
+
+  // Returns true the first time a sample from sender is seen, false for copies
+  accept(reading, sender, now = Date.now()) {
+    if (reading.seq === undefined) {
+      return true;
+    }
+
+    this.expire(now);
+    const key = `${reading.sensor}/${sender}/${reading.device_id}/${reading.seq}`;
+    if (this.seen.has(key)) {
+      this.duplicates++;
+      return false;
+    }
+
+    this.seen.set(key, now);
+    if (this.seen.size > this.maxEntries) {
+      this.seen.delete(this.seen.keys().next().value);
+    }
+    return true;
+  }
+
+  // Drop keys older than the window; the Map iterates in insertion order
+  expire(now) {
+    for (const [key, time] of this.seen) {
+      if (now - time < this.windowMs) {
+        break;
+      }
+      this.seen.delete(key);
+    }
+  }
+}
+
+module.exports = {
+  DuplicateFilter,
+};
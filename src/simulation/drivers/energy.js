@@ -0,0 +1,73 @@
+'use strict';
+
+// ------------------------------------------------------------
+// Per-Mote Energy Aggregation
+// ------------------------------------------------------------
+// Sensors built with ENERGY_MONITOR_CONF_ENABLED send Energest records with
+// the milliseconds spent in CPU, LPM, transmit and listen since the previous
+// record. Totals are kept per mote and reported periodically as duty cycles.
+// A mote is its sender (the source's interface identifier, see capture.js)
+// and device id: motes send no DEVICE_HI, so device ids repeat across motes
+// whose addresses differ only above the last byte.
+
+const REPORT_INTERVAL_MS = 5 * 60 * 1000; // Summary period
+
+const ENERGY_FIELDS = ['cpu_ms', 'lpm_ms', 'tx_ms', 'listen_ms'];
+
+const totals = new Map(); // "<sender>/<device_id>" -> { sender, device_id, records, cpu_ms, lpm_ms, tx_ms, listen_ms }
+
+// ------------------------------------------------------------
+// Function: Record One Energy Reading
+// ------------------------------------------------------------
+function recordEnergy(reading, sender) {
+  const key = `${sender}/${reading.device_id}`;
+  if (!totals.has(key)) {
+    totals.set(key, { sender, device_id: reading.device_id, records: 0, cpu_ms: 0, lpm_ms: 0, tx_ms: 0, listen_ms: 0 });
+  }
+  const entry = totals.get(key);
+  entry.records++;
+  for (const field of ENERGY_FIELDS) {
+    entry[field] += reading[field] || 0;
+  }
+}
+
+// ------------------------------------------------------------
+// Function: Summarise Energy per Mote
+// ------------------------------------------------------------
+// Duty cycles are shares of the CPU + LPM time, i.e. of the observed interval.
+function energySummary() {
+  const rows = [];
+  for (const entry of totals.values()) {
+    const observed = entry.cpu_ms + entry.lpm_ms;
+    const share = (value) => (observed ? Number(((100 * value) / observed).toFixed(2)) : 0);
+    rows.push({
+      sender: entry.sender,
+      device_id: entry.device_id,
+      records: entry.records,
+      observed_s: Math.round(observed / 1000),
+      cpu_pct: share(entry.cpu_ms),
+      tx_pct: share(entry.tx_ms),
+      listen_pct: share(entry.listen_ms),
+    });
+  }
+  return rows;
+}
+
+// ------------------------------------------------------------
+// Function: Report Energy Periodically
+// ------------------------------------------------------------
+function startEnergyReport(log, intervalMs = REPORT_INTERVAL_MS) {
+  const timer = setInterval(() => {
+    for (const row of energySummary()) {
+      log(`Energy ${JSON.stringify(row)}`);
+    }
+  }, intervalMs);
+  timer.unref();
+  return timer;
+}
+
+module.exports = {
+  recordEnergy,
+  energySummary,
+  startEnergyReport,
+};
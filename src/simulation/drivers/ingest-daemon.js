@@ -0,0 +1,367 @@
+'use strict';
+
+const dgram = require('dgram'); // UDP module for IPv6 communication
+const http = require('http');
+const os = require('os');
+const path = require('path');
+const { Worker } = require('worker_threads');
+const { isTelemetryFrame } = require('./telemetry'); // Binary frame decoder
+const { schemaByPort, parseDatagram } = require('./ingest-parser'); // Schema-driven parsing
+const { recordEnergy, startEnergyReport } = require('./energy'); // Per-mote energy totals
+const { SubmitQueue } = require('./submit-queue'); // Batched, bounded Hyperledger submissions
+const { SegmentStore, createProofServer } = require('./segment-store'); // Off-chain segments, anchored roots
+const { DuplicateFilter } = require('./dedupe'); // Drops samples delivered by more than one root
+const { CaptureWriter, interfaceId } = require('./capture'); // Records datagrams for tools/replay.c; sender IIDs
+const { LatencyHistograms, ClockOffsets, stampReading } = require('./latency'); // Per-stage latency
+const { isAuthFrame, ReplayGuard } = require('./auth'); // Frame counter checks for authenticated frames
+const { startSerialSources } = require('./serial-bridge'); // Datagrams forwarded on border router uplinks
+const { ReplaySource } = require('./replay-source'); // Captured datagrams fed back in from their senders
+
+// ------------------------------------------------------------
+// Configuration and Constants
+// ------------------------------------------------------------
+// One process binds every collector port listed in sensor-schemas.json.
+// Datagrams are parsed and validated on worker threads; the readings come
+// back to this thread, which owns the energy totals and the submit queue.
+// With several border routers, INGEST_HOST lists one address per tunnel
+// ("aaaa::1,aaab::1") and the streams are merged and deduplicated here.
+// Datagrams sent to a border router's collector ports never cross the
+// tunnel; INGEST_SERIAL lists the uplinks whose I lines carry them
+// (serial-bridge.js). INGEST_REPLAY feeds a capture back in from its
+// recorded senders (replay-source.js). With either and no INGEST_HOST, no
+// UDP port is bound.
+const SERIAL_SOURCES = process.env.INGEST_SERIAL || '';
+const REPLAY_FILE = process.env.INGEST_REPLAY || null;
+const REPLAY_SPEED = process.env.INGEST_REPLAY_SPEED !== undefined ? Number(process.env.INGEST_REPLAY_SPEED) : 1; // 0 = as fast as possible
+const REPLAY_LOOPS = Number(process.env.INGEST_REPLAY_LOOPS) || 1;
+const IPV6_HOSTS = (process.env.INGEST_HOST || (SERIAL_SOURCES || REPLAY_FILE ? '' : 'aaaa::1'))
+    .split(',').map((host) => host.trim()).filter(Boolean);
+const WORKER_COUNT = process.env.INGEST_WORKERS !== undefined
+  ? Number(process.env.INGEST_WORKERS) // 0 parses on the main thread
+  : Math.max(1, os.cpus().length - 1);
+const LOG_READINGS = process.env.INGEST_LOG_READINGS === '1'; // Log every datagram and reading
+const MAX_DATAGRAMS_PER_JOB = 256; // Datagrams handed to a worker in one message
+const STATS_INTERVAL_MS = 30000;
+const ANCHOR_MODE = process.env.INGEST_ANCHOR === '1'; // Keep readings off-chain, anchor Merkle roots
+const ANCHOR_API_PORT = Number(process.env.ANCHOR_API_PORT) || 8850; // Proof server in anchoring mode
+const CAPTURE_FILE = process.env.INGEST_CAPTURE_FILE || null; // Record every datagram to this capture
+const METRICS_PORT = Number(process.env.INGEST_METRICS_PORT) || 0; // GET /metrics with counters and histograms
+const DEDUPE_WINDOW_MS = (Number(process.env.INGEST_DEDUPE_WINDOW_S) || 120) * 1000; // How long a seq is remembered
+
+// Hyperledger API Configuration
+const HYPERLEDGER_API_KEY = process.env.HYPERLEDGER_API_KEY || '8554358f-2152-42c2-a892-f48a85608504'; // Replace with your actual API key
+
+const latency = new LatencyHistograms();
+const clockOffsets = new ClockOffsets();
+
+// Readings are either queued and submitted in batches (submit-queue.js) or,
+// in anchoring mode, appended to per-window segments (segment-store.js)
+const submitQueue = ANCHOR_MODE ? null : new SubmitQueue({ apiKey: HYPERLEDGER_API_KEY, log, latency });
+const segmentStore = ANCHOR_MODE ? new SegmentStore({ apiKey: HYPERLEDGER_API_KEY, log }) : null;
+
+const duplicateFilter = new DuplicateFilter({ windowMs: DEDUPE_WINDOW_MS });
+const replayGuard = new ReplayGuard();
+if (CAPTURE_FILE && REPLAY_FILE && path.resolve(CAPTURE_FILE) === path.resolve(REPLAY_FILE)) {
+  console.error('INGEST_CAPTURE_FILE would overwrite the INGEST_REPLAY capture before it is read');
+  process.exit(1);
+}
+const capture = CAPTURE_FILE ? new CaptureWriter(CAPTURE_FILE) : null;
+
+const portStats = new Map(); // port -> { datagrams, readings, invalid, errors, duplicates, authenticated, replayed }
+const workers = []; // { worker, pending: [datagram], jobs: Map(id -> [meta]) }
+let nextWorker = 0;
+let nextJobId = 0;
+let flushScheduled = false;
+
+// ------------------------------------------------------------
+// Logging Utility
+// ------------------------------------------------------------
+function log(message, isError = false) {
+  const timestamp = new Date().toISOString();
+  const logMessage = `[${timestamp}] ${message}`;
+  isError ? console.error(logMessage) : console.log(logMessage);
+}
+
+// Binary frames are logged as hex, legacy ASCII payloads as text
+function describeMessage(message) {
+  return isTelemetryFrame(message) || isAuthFrame(message) ? `<${message.toString('hex')}>` : message.toString();
+}
+
+// ------------------------------------------------------------
+// Function: Start the Worker Pool
+// ------------------------------------------------------------
+function startWorker(slot) {
+  const worker = new Worker(path.join(__dirname, 'ingest-worker.js'));
+  const entry = { worker, pending: [], jobs: new Map() };
+
+  worker.on('message', ({ id, results }) => {
+    const metas = entry.jobs.get(id);
+    entry.jobs.delete(id);
+    results.forEach((result, i) => handleParsed(metas[i], result));
+  });
+  worker.on('error', (error) => log(`Ingest worker ${slot} failed: ${error.message}`, true));
+  worker.on('exit', (code) => {
+    // Datagrams the worker had not answered are lost; count them as errors
+    for (const metas of entry.jobs.values()) {
+      metas.forEach((meta) => portStats.get(meta.port).errors++);
+    }
+    log(`Ingest worker ${slot} exited with code ${code}, restarting`, true);
+    startWorker(slot);
+  });
+
+  workers[slot] = entry;
+}
+
+// Hand the datagrams collected during this event-loop turn to the workers
+function flushPending() {
+  flushScheduled = false;
+  for (const entry of workers) {
+    while (entry.pending.length > 0) {
+      const datagrams = entry.pending.splice(0, MAX_DATAGRAMS_PER_JOB);
+      const id = nextJobId++;
+      entry.jobs.set(id, datagrams.map(({ data, ...meta }) => meta));
+      entry.worker.postMessage({ id, datagrams: datagrams.map(({ data, port, source }) => ({ data, port, source })) });
+    }
+  }
+}
+
+// ------------------------------------------------------------
+// Function: Bind Every Collector Port
+// ------------------------------------------------------------
+// Each port is bound once per host address; all sockets of a port share its
+// counters, so the streams from different border routers are merged.
+function startCollectors() {
+  for (const [port, schema] of schemaByPort) {
+    portStats.set(port, {
+      datagrams: 0, readings: 0, invalid: 0, errors: 0, duplicates: 0, authenticated: 0, replayed: 0,
+    });
+
+    for (const host of IPV6_HOSTS) {
+      const udpServer = dgram.createSocket('udp6');
+      udpServer.on('listening', () => {
+        const address = udpServer.address();
+        log(`[UDP - IPv6] ${schema.label} collector listening at ${address.address}:${address.port}`);
+      });
+      udpServer.on('message', (message, remote) => handleIncomingMessage(message, remote, port));
+      udpServer.on('error', (error) => log(`[UDP - IPv6] Port ${port} on ${host}: ${error.message}`, true));
+      udpServer.bind(port, host);
+    }
+  }
+}
+
+// ------------------------------------------------------------
+// Function: Read the Border Router Uplinks
+// ------------------------------------------------------------
+// Each I line goes down the same path as a UDP datagram from the sender.
+// Each uplink is one border router, so one network clock domain.
+function startSerialBridge() {
+  const unknownPorts = new Set();
+  startSerialSources(SERIAL_SOURCES, (message, remote, port, source) => {
+    if (!portStats.has(port)) {
+      if (!unknownPorts.has(port)) {
+        unknownPorts.add(port);
+        log(`[Serial] ${source} forwarded a datagram for port ${port}, which no schema owns`, true);
+      }
+      return;
+    }
+    handleIncomingMessage(message, remote, port, `serial:${source}`);
+  }, log);
+}
+
+// ------------------------------------------------------------
+// Function: Replay a Capture
+// ------------------------------------------------------------
+// Replayed datagrams take the same path as live ones, tagged with their run.
+function startReplay() {
+  const unknownPorts = new Set();
+  new ReplaySource(REPLAY_FILE, (message, remote, port, run) => {
+    if (!portStats.has(port)) {
+      if (!unknownPorts.has(port)) {
+        unknownPorts.add(port);
+        log(`[Replay] ${REPLAY_FILE} holds datagrams for port ${port}, which no schema owns`, true);
+      }
+      return;
+    }
+    handleIncomingMessage(message, remote, port, `replay:${REPLAY_FILE}`, run);
+  }, log, { speed: REPLAY_SPEED, loops: REPLAY_LOOPS }).start();
+}
+
+// ------------------------------------------------------------
+// Function: Handle Incoming UDP Messages
+// ------------------------------------------------------------
+// run numbers the pass of a replayed datagram over its capture; live
+// datagrams have none.
+function handleIncomingMessage(message, remote, port, network, run = 0) {
+  portStats.get(port).datagrams++;
+  if (capture) {
+    capture.record(message, remote, port);
+  }
+  if (LOG_READINGS) {
+    log(`[UDP - IPv6] Received on ${port} from ${remote.address}:${remote.port} - ${describeMessage(message)}`);
+  }
+
+  const meta = { port, remote: `${remote.address}:${remote.port}`, source: remote.address, network, run, receivedMs: Date.now() };
+  if (workers.length === 0) {
+    let result;
+    try {
+      result = parseDatagram(message, port, meta.source);
+    } catch (error) {
+      result = { readings: [], invalid: 0, error: error.message };
+    }
+    handleParsed(meta, result);
+    return;
+  }
+
+  workers[nextWorker].pending.push({ data: message, ...meta });
+  nextWorker = (nextWorker + 1) % workers.length;
+  if (!flushScheduled) {
+    flushScheduled = true;
+    setImmediate(flushPending);
+  }
+}
+
+// ------------------------------------------------------------
+// Function: Handle Parsed Readings
+// ------------------------------------------------------------
+function handleParsed(meta, { readings, invalid, error, auth }) {
+  const stats = portStats.get(meta.port);
+
+  if (error) {
+    stats.errors++;
+    log(`Error processing message from ${meta.remote} on ${meta.port}: ${error}`, true);
+    return;
+  }
+
+  // The sender is the source's interface identifier; each replay run is a sender of its own
+  const sender = meta.run ? `${interfaceId(meta.source)}#${meta.run}` : interfaceId(meta.source);
+
+  // Frame counters of authenticated frames only ever move forward, per sender
+  if (auth) {
+    const verdict = replayGuard.check(`${sender}/${auth.device}`, auth.counter);
+    if (verdict === 'duplicate') {
+      stats.duplicates += readings.length;
+      return;
+    }
+    if (verdict === 'replay') {
+      stats.replayed++;
+      log(`Replayed frame ${auth.counter} from device ${auth.device} via ${meta.remote} dropped`, true);
+      return;
+    }
+    stats.authenticated++;
+  }
+  stats.invalid += invalid;
+  if (invalid > 0 && LOG_READINGS) {
+    log(`Validation failed for ${invalid} data block(s) from ${meta.remote} on ${meta.port}.`, true);
+  }
+
+  for (const dataBlock of readings) {
+    // A sample forwarded by two border routers is only kept once
+    if (!duplicateFilter.accept(dataBlock, sender)) {
+      stats.duplicates++;
+      continue;
+    }
+
+    // Energy records are aggregated locally, not stored on the ledger
+    if (dataBlock.sensor === 'energy') {
+      recordEnergy(dataBlock, sender);
+      continue;
+    }
+
+    stampReading(dataBlock, {
+      receivedMs: meta.receivedMs, source: meta.source, network: meta.network, offsets: clockOffsets, histograms: latency,
+    });
+    latency.record('parse', Date.now() - meta.receivedMs);
+
+    if (LOG_READINGS) {
+      log(`Parsed Data Block: ${JSON.stringify(dataBlock)}`);
+    }
+    stats.readings++;
+
+    if (segmentStore) {
+      segmentStore.append(schemaByPort.get(meta.port).name, dataBlock);
+    } else {
+      // Queue for batched submission; a full queue sheds and counts the reading
+      submitQueue.push(dataBlock);
+    }
+  }
+}
+
+// ------------------------------------------------------------
+// Function: Report Ingest Counters
+// ------------------------------------------------------------
+function logPortStats() {
+  for (const [port, stats] of portStats) {
+    log(`Port ${port} (${schemaByPort.get(port).name}): ${stats.datagrams} datagrams, ` +
+      `${stats.readings} readings, ${stats.invalid} invalid, ${stats.errors} errors, ${stats.duplicates} duplicates, ` +
+      `${stats.authenticated} authenticated, ${stats.replayed} replayed`);
+  }
+  if (segmentStore) {
+    log(`Segment store: ${JSON.stringify(segmentStore.stats())}`);
+  }
+  if (latency.stages.size > 0) {
+    log(`Latency p50/p95/p99: ${latency.summary()}`);
+  }
+}
+
+// ------------------------------------------------------------
+// Function: Serve Ingest Metrics
+// ------------------------------------------------------------
+// GET /metrics returns the per-port counters and the latency histograms.
+function startMetricsServer() {
+  const server = http.createServer((req, res) => {
+    if (req.method !== 'GET' || req.url !== '/metrics') {
+      res.writeHead(404).end();
+      return;
+    }
+    res.writeHead(200, { 'Content-Type': 'application/json' });
+    res.end(JSON.stringify({
+      ports: Object.fromEntries(portStats),
+      latency: latency.snapshot(),
+      submitQueue: submitQueue ? submitQueue.stats() : undefined,
+    }));
+  });
+  server.listen(METRICS_PORT, () => log(`Ingest metrics at http://localhost:${METRICS_PORT}/metrics`));
+  server.unref();
+}
+
+// ------------------------------------------------------------
+// Function: Start Anchoring Mode
+// ------------------------------------------------------------
+function startAnchoring() {
+  segmentStore.start();
+  createProofServer(segmentStore).listen(ANCHOR_API_PORT, () =>
+    log(`Anchoring mode: proof server listening on port ${ANCHOR_API_PORT}`));
+
+  const closeSegments = (signal) => {
+    log(`${signal} received, flushing open segments...`);
+    segmentStore.shutdown().then(() => process.exit(0));
+  };
+  process.once('SIGINT', closeSegments);
+  process.once('SIGTERM', closeSegments);
+}
+
+// ------------------------------------------------------------
+// Main: Start Workers, Collectors and Reports
+// ------------------------------------------------------------
+for (let i = 0; i < WORKER_COUNT; i++) {
+  startWorker(i);
+}
+if (segmentStore) {
+  startAnchoring();
+}
+startCollectors();
+if (SERIAL_SOURCES) {
+  startSerialBridge();
+}
+if (REPLAY_FILE) {
+  startReplay();
+}
+startEnergyReport(log);
+if (METRICS_PORT) {
+  startMetricsServer();
+}
+setInterval(logPortStats, STATS_INTERVAL_MS).unref();
+log(`Ingest daemon started with ${WORKER_COUNT} parser worker(s) on ${schemaByPort.size} port(s)`);
+if (capture) {
+  log(`Capturing datagrams to ${CAPTURE_FILE}`);
+}
@@ -0,0 +1,118 @@
+'use strict';
+
+const { FIELDS, SENSOR_TYPES, isTelemetryFrame, telemetryToDataBlocks } = require('./telemetry'); // Binary frame decoder
+const { AUTH_REQUIRED, isAuthFrame, openAuthFrame } = require('./auth'); // Frame MIC verification
+const SCHEMAS = require('./sensor-schemas.json');
+
+// ------------------------------------------------------------
+// Per-Sensor Payload Schemas
+// ------------------------------------------------------------
+// sensor-schemas.json declares, for every collector, the UDP ports it owns,
+// the legacy ASCII fields kept as strings, what happens to other fields that
+// are not numbers ("zero" or "keep") and the fields a reading must carry.
+// The datagram's port selects the schema, as each port used to select a
+// driver process. Schemas follow the firmware's provider table
+// (devices/sensor-providers.c): each is named after a telemetry sensor type
+// and may only require device_id and telemetry fields, so a schema cannot
+// ask for something the motes never send.
+
+const TELEMETRY_SENSORS = new Set(Object.values(SENSOR_TYPES));
+const TELEMETRY_FIELDS = new Set(['device_id', ...Object.values(FIELDS)]);
+
+const schemaByPort = new Map();
+for (const [name, schema] of Object.entries(SCHEMAS)) {
+  if (!TELEMETRY_SENSORS.has(name)) {
+    throw new Error(`Sensor schema ${name} is not a telemetry sensor type`);
+  }
+  const unknown = schema.requiredFields.filter((field) => !TELEMETRY_FIELDS.has(field));
+  if (unknown.length > 0) {
+    throw new Error(`Sensor schema ${name} requires field(s) no firmware sends: ${unknown.join(', ')}`);
+  }
+  for (const port of schema.ports) {
+    schemaByPort.set(port, { name, ...schema });
+  }
+}
+
+// ------------------------------------------------------------
+// Function: Parse a Legacy ASCII Payload
+// ------------------------------------------------------------
+// "key:value,key:value" pairs; numbers are stored as absolute values. The
+// sensor is the schema's, as a binary frame names its own.
+function parseAsciiPayload(text, schema) {
+  const dataBlock = {
+    rid: Date.now().toString(), // Unique Request ID (timestamp-based)
+    sensor: schema.name,
+  };
+
+  for (const pair of text.split(',')) {
+    const [key, value] = pair.split(':');
+    if (schema.stringFields.includes(key)) {
+      dataBlock[key] = value;
+      continue;
+    }
+
+    const intValue = parseInt(value, 10);
+    if (!isNaN(intValue)) {
+      dataBlock[key] = Math.abs(intValue);
+    } else {
+      dataBlock[key] = schema.nonNumeric === 'keep' ? value : 0;
+    }
+  }
+
+  return dataBlock;
+}
+
+// ------------------------------------------------------------
+// Function: Validate a Data Block
+// ------------------------------------------------------------
+function validateDataBlock(dataBlock, schema) {
+  return schema.requiredFields.every((field) => field in dataBlock);
+}
+
+// ------------------------------------------------------------
+// Function: Parse One Datagram
+// ------------------------------------------------------------
+// Returns the readings that passed validation and how many did not. Energy
+// records skip validation; the caller aggregates them instead of storing them.
+// Authenticated frames are verified first, with the key of the sender
+// address (source), and also return their device id and frame counter
+// (auth) for the caller's replay check.
+function parseDatagram(message, port, source) {
+  const schema = schemaByPort.get(port);
+  if (!schema) {
+    throw new Error(`No sensor schema for port ${port}`);
+  }
+
+  let auth = null;
+  if (isAuthFrame(message)) {
+    const { frame, device, counter } = openAuthFrame(message, source);
+    message = frame;
+    auth = { device, counter };
+  } else if (AUTH_REQUIRED) {
+    throw new Error('Unauthenticated payload rejected (INGEST_AUTH_REQUIRED)');
+  }
+
+  const dataBlocks = isTelemetryFrame(message)
+    ? telemetryToDataBlocks(message)
+    : [parseAsciiPayload(message.toString(), schema)];
+
+  const readings = [];
+  let invalid = 0;
+  for (const dataBlock of dataBlocks) {
+    if (dataBlock.sensor === 'energy' || validateDataBlock(dataBlock, schema)) {
+      readings.push(dataBlock);
+    } else {
+      invalid++;
+    }
+  }
+
+  return { readings, invalid, auth };
+}
+
+module.exports = {
+  SCHEMAS,
+  schemaByPort,
+  parseAsciiPayload,
+  validateDataBlock,
+  parseDatagram,
+};
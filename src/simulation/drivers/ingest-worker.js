@@ -0,0 +1,20 @@
+'use strict';
+
+const { parentPort } = require('worker_threads');
+const { parseDatagram } = require('./ingest-parser');
+
+// ------------------------------------------------------------
+// Ingest Worker Thread
+// ------------------------------------------------------------
+// Receives batches of raw datagrams from ingest-daemon.js and answers each
+// batch with the parsed readings, in order, plus per-datagram errors.
+parentPort.on('message', ({ id, datagrams }) => {
+  const results = datagrams.map(({ data, port, source }) => {
+    try {
+      return parseDatagram(Buffer.from(data.buffer, data.byteOffset, data.byteLength), port, source);
+    } catch (error) {
+      return { readings: [], invalid: 0, error: error.message };
+    }
+  });
+  parentPort.postMessage({ id, results });
+});
@@ -0,0 +1,145 @@
+'use strict';
+
+const { addressBytes, interfaceId } = require('./capture'); // Source address as bytes, for its prefix and IID
+
+// ------------------------------------------------------------
+// End-to-End Latency Stages
+// ------------------------------------------------------------
+// Sensors stamp each sample with the time it was taken. In TSCH builds the
+// stamp uses the network clock that the whole mesh shares (net_time_ms). In
+// CSMA builds it uses the node's own uptime (node_time_ms). Border routers
+// add the time they received the frame, on the network clock (hop_time_ms).
+// None of these clocks is wall time, so each clock domain is mapped to host
+// time with the smallest (arrival - stamp) seen recently. A stage measured
+// this way is the delay above the fastest delivery; batching and queueing
+// show up in full. Every stage is kept as a log2-bucketed histogram:
+//   mesh              sample -> border router (network clock, TSCH only)
+//   uplink            border router -> driver
+//   sensor_to_driver  sample -> driver
+//   parse             driver receive -> handed to the submit queue
+//   driver            driver receive -> POST to the gateway
+//   post              POST -> gateway response
+// The gateway adds its own stages up to the commit event (jobs.ts).
+
+const HISTOGRAM_BUCKETS_MS = Array.from({ length: 18 }, (_, i) => 2 ** i); // 1 ms .. ~131 s, as the gateway
+const OFFSET_WINDOW_MS = 10 * 60 * 1000; // Minimum kept over one to two windows, so drift is followed
+const CLOCK_FIELDS = ['net_time_ms', 'node_time_ms', 'hop_time_ms'];
+
+// ------------------------------------------------------------
+// Class: Latency Histograms
+// ------------------------------------------------------------
+// counts[i] is the number of readings at or below bucketsMs[i]; the last
+// count is everything slower.
+class LatencyHistograms {
+  constructor() {
+    this.stages = new Map(); // stage -> counts
+  }
+
+  record(stage, ms) {
+    if (!Number.isFinite(ms)) {
+      return;
+    }
+    if (!this.stages.has(stage)) {
+      this.stages.set(stage, new Array(HISTOGRAM_BUCKETS_MS.length + 1).fill(0));
+    }
+    const bucket = HISTOGRAM_BUCKETS_MS.findIndex((bound) => ms <= bound);
+    this.stages.get(stage)[bucket === -1 ? HISTOGRAM_BUCKETS_MS.length : bucket]++;
+  }
+
+  // Upper bound of the bucket holding the given percentile, Infinity past the last
+  percentile(stage, p) {
+    const counts = this.stages.get(stage) || [];
+    const total = counts.reduce((a, b) => a + b, 0);
+    let seen = 0;
+    for (let i = 0; i < counts.length; i++) {
+      seen += counts[i];
+      if (total > 0 && seen >= (p / 100) * total) {
+        return i < HISTOGRAM_BUCKETS_MS.length ? HISTOGRAM_BUCKETS_MS[i] : Infinity;
+      }
+    }
+    return 0;
+  }
+
+  snapshot() {
+    return { bucketsMs: HISTOGRAM_BUCKETS_MS, stages: Object.fromEntries(this.stages) };
+  }
+
+  // One line per report: "stage p50/p95/p99 ms (count)"
+  summary() {
+    return [...this.stages.entries()].map(([stage, counts]) =>
+      `${stage} ${[50, 95, 99].map((p) => this.percentile(stage, p)).join('/')} ms ` +
+      `(${counts.reduce((a, b) => a + b, 0)})`).join(', ');
+  }
+}
+
+// ------------------------------------------------------------
+// Class: Clock Offsets
+// ------------------------------------------------------------
+// Host time minus mote time per clock domain, from the fastest deliveries.
+class ClockOffsets {
+  constructor(windowMs = OFFSET_WINDOW_MS) {
+    this.windowMs = windowMs;
+    this.domains = new Map(); // domain -> { current, previous, rotateAt }
+  }
+
+  offset(domain, clockMs, wallMs) {
+    let entry = this.domains.get(domain);
+    if (!entry || wallMs >= entry.rotateAt + this.windowMs) {
+      entry = { current: Infinity, previous: Infinity, rotateAt: wallMs + this.windowMs };
+      this.domains.set(domain, entry);
+    } else if (wallMs >= entry.rotateAt) {
+      entry.previous = entry.current;
+      entry.current = Infinity;
+      entry.rotateAt += this.windowMs;
+    }
+    entry.current = Math.min(entry.current, wallMs - clockMs);
+    return Math.min(entry.current, entry.previous);
+  }
+}
+
+// The /64 prefix of the sending address tells border routers (and so TSCH
+// networks) apart when several run at once. Datagrams from a serial uplink
+// all carry a link-local address; the daemon names their network instead.
+function sourcePrefix(address) {
+  return addressBytes(address).toString('hex', 0, 8);
+}
+
+// ------------------------------------------------------------
+// Function: Stamp a Reading with Host Times
+// ------------------------------------------------------------
+// Replaces the mote clock fields with wall-clock sampled_ms and received_ms,
+// records the mesh, uplink and sensor_to_driver stages and makes the request
+// ID the sampling time when it is known. network is the clock domain of the
+// network clock, by default the source's /64 prefix. A node's own uptime is
+// keyed on its interface identifier, as device ids are only one byte.
+function stampReading(reading, { receivedMs, source, network = sourcePrefix(source), offsets, histograms }) {
+  let sampledMs;
+
+  if (reading.net_time_ms !== undefined && reading.hop_time_ms !== undefined) {
+    // One network clock from sensor to border router: the mesh stage is exact
+    const offset = offsets.offset(`net/${network}`, reading.hop_time_ms, receivedMs);
+    histograms.record('mesh', reading.hop_time_ms - reading.net_time_ms);
+    histograms.record('uplink', receivedMs - (reading.hop_time_ms + offset));
+    sampledMs = reading.net_time_ms + offset;
+  } else if (reading.net_time_ms !== undefined) {
+    sampledMs = reading.net_time_ms + offsets.offset(`net/${network}`, reading.net_time_ms, receivedMs);
+  } else if (reading.node_time_ms !== undefined) {
+    sampledMs = reading.node_time_ms + offsets.offset(`node/${interfaceId(source)}`, reading.node_time_ms, receivedMs);
+  }
+
+  CLOCK_FIELDS.forEach((field) => delete reading[field]);
+  reading.received_ms = receivedMs;
+  if (sampledMs !== undefined) {
+    histograms.record('sensor_to_driver', receivedMs - sampledMs);
+    reading.sampled_ms = Math.round(sampledMs);
+    reading.rid = String(reading.sampled_ms);
+  }
+  return reading;
+}
+
+module.exports = {
+  HISTOGRAM_BUCKETS_MS,
+  LatencyHistograms,
+  ClockOffsets,
+  stampReading,
+};
@@ -0,0 +1,87 @@
+'use strict';
+
+const crypto = require('crypto');
+
+// ------------------------------------------------------------
+// Merkle Trees over Segment Readings
+// ------------------------------------------------------------
+// Leaves are SHA-256 over 0x00 and the reading's JSON line exactly as stored
+// in the segment; inner nodes hash 0x01 and both children, so a leaf can
+// never pass for an inner node. A level with an odd node count promotes its
+// last node unchanged instead of duplicating it. The chaincodes' anchors.js
+// verifies proofs with the same rules.
+
+const LEAF_PREFIX = Buffer.from([0x00]);
+const NODE_PREFIX = Buffer.from([0x01]);
+
+function sha256(...parts) {
+  const hash = crypto.createHash('sha256');
+  parts.forEach((part) => hash.update(part));
+  return hash.digest();
+}
+
+function leafHash(line) {
+  return sha256(LEAF_PREFIX, Buffer.from(line, 'utf8'));
+}
+
+function nodeHash(left, right) {
+  return sha256(NODE_PREFIX, left, right);
+}
+
+// Next level up; an odd last node is carried over as is
+function parentLevel(level) {
+  const parents = [];
+  for (let i = 0; i < level.length; i += 2) {
+    parents.push(i + 1 < level.length ? nodeHash(level[i], level[i + 1]) : level[i]);
+  }
+  return parents;
+}
+
+// ------------------------------------------------------------
+// Function: Root of a List of Leaf Hashes
+// ------------------------------------------------------------
+function merkleRoot(leaves) {
+  if (leaves.length === 0) {
+    throw new Error('Cannot build a Merkle tree without leaves');
+  }
+  let level = leaves;
+  while (level.length > 1) {
+    level = parentLevel(level);
+  }
+  return level[0].toString('hex');
+}
+
+// ------------------------------------------------------------
+// Function: Inclusion Proof for One Leaf
+// ------------------------------------------------------------
+// Sibling hashes from the leaf up, each with the side it sits on.
+function merkleProof(leaves, index) {
+  if (index < 0 || index >= leaves.length) {
+    throw new Error(`Leaf ${index} is outside a tree of ${leaves.length}`);
+  }
+  const proof = [];
+  let level = leaves;
+  while (level.length > 1) {
+    const sibling = index % 2 === 0 ? index + 1 : index - 1;
+    if (sibling < level.length) {
+      proof.push({ position: index % 2 === 0 ? 'right' : 'left', hash: level[sibling].toString('hex') });
+    }
+    level = parentLevel(level);
+    index = Math.floor(index / 2);
+  }
+  return proof;
+}
+
+// ------------------------------------------------------------
+// Function: Verify a Reading against a Root
+// ------------------------------------------------------------
+function verifyProof(line, proof, root) {
+  let hash = leafHash(line);
+  for (const step of proof) {
+    const sibling = Buffer.from(step.hash, 'hex');
+    hash = step.position === 'left' ? nodeHash(sibling, hash) : nodeHash(hash, sibling);
+  }
+  return hash.toString('hex') === root;
+}
+
+module.exports = { leafHash, merkleRoot, merkleProof, verifyProof };
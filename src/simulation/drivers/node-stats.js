@@ -0,0 +1,88 @@
+'use strict';
+
+const dgram = require('dgram'); // UDP module for IPv6 communication
+
+// ------------------------------------------------------------
+// Configuration and Constants
+// ------------------------------------------------------------
+const NODE_STATS_PORT = 5688; // Border router port answering table queries (NODE_STATS_PORT)
+const BORDER_ROUTER_HOST = process.env.BORDER_ROUTER_HOST || 'aaaa::212:7401:1:101'; // Border router address
+const QUERY_TIMEOUT_MS = 2000; // Give up on a reply after this long
+const ENTRY_LEN = 16; // Encoded bytes per node entry
+
+// ------------------------------------------------------------
+// Function: Decode One Query Reply
+// ------------------------------------------------------------
+// Reply layout: next slot to query, table size, then entries of
+// iid(2) packets(4) bytes(4) jitter_ms(2) seq_gaps(2) age_s(2), big-endian.
+function decodeNodeStatsReply(reply) {
+  if (reply.length < 2 || (reply.length - 2) % ENTRY_LEN !== 0) {
+    throw new Error(`Malformed node stats reply (${reply.length} bytes)`);
+  }
+
+  const nodes = [];
+  for (let offset = 2; offset < reply.length; offset += ENTRY_LEN) {
+    nodes.push({
+      node: reply.toString('hex', offset, offset + 2),
+      packets: reply.readUInt32BE(offset + 2),
+      bytes: reply.readUInt32BE(offset + 6),
+      jitter_ms: reply.readUInt16BE(offset + 10),
+      seq_gaps: reply.readUInt16BE(offset + 12),
+      last_seen_s: reply.readUInt16BE(offset + 14),
+    });
+  }
+
+  return { next: reply[0], tableSize: reply[1], nodes };
+}
+
+// ------------------------------------------------------------
+// Function: Query the Full Node Table
+// ------------------------------------------------------------
+// Pages through the table one reply at a time and resolves with all entries.
+function queryNodeStats(host = BORDER_ROUTER_HOST, port = NODE_STATS_PORT) {
+  const socket = dgram.createSocket('udp6');
+
+  const requestPage = (start) => new Promise((resolve, reject) => {
+    const timer = setTimeout(() => reject(new Error('Node stats query timed out')), QUERY_TIMEOUT_MS);
+    socket.once('message', (reply) => {
+      clearTimeout(timer);
+      try {
+        resolve(decodeNodeStatsReply(reply));
+      } catch (error) {
+        reject(error);
+      }
+    });
+    socket.send(Buffer.from([start]), port, host);
+  });
+
+  const collect = async () => {
+    const nodes = [];
+    let start = 0;
+    let tableSize = 1;
+
+    while (start < tableSize) {
+      const page = await requestPage(start);
+      nodes.push(...page.nodes);
+      tableSize = page.tableSize;
+      start = page.next;
+    }
+    return nodes;
+  };
+
+  return collect().finally(() => socket.close());
+}
+
+module.exports = {
+  decodeNodeStatsReply,
+  queryNodeStats,
+};
+
+// Print the table when run directly: node node-stats.js [border-router-address]
+if (require.main === module) {
+  queryNodeStats(process.argv[2] || BORDER_ROUTER_HOST)
+      .then((nodes) => console.table(nodes))
+      .catch((error) => {
+        console.error(`Failed to query node stats: ${error.message}`);
+        process.exit(1);
+      });
+}
@@ -0,0 +1,86 @@
+'use strict';
+
+const fs = require('fs');
+const { performance } = require('perf_hooks');
+const { readCapture } = require('./capture');
+
+// ------------------------------------------------------------
+// Capture Replay Input
+// ------------------------------------------------------------
+// Feeds a capture (INGEST_CAPTURE_FILE of an earlier run) to the daemon as
+// if each datagram had arrived again from its recorded source and source
+// port. The sender identity is kept, so authenticated frames pass their MIC
+// check and samples are deduplicated per sender as they were live. Each pass
+// over the capture is a numbered run, starting at 1; the daemon keeps the
+// senders of different runs apart, so the seq values and frame counters a
+// later pass repeats are not dropped as copies or replays.
+
+const YIELD_EVERY = 256; // Datagrams fed before other events get a turn
+
+// ------------------------------------------------------------
+// Class: Replay Source
+// ------------------------------------------------------------
+// Calls onDatagram(message, remote, port, run) for every record. speed 1
+// keeps the captured timing, N runs N times faster and 0 feeds the records
+// as fast as the daemon takes them.
+class ReplaySource {
+  constructor(filePath, onDatagram, log, { speed = 1, loops = 1 } = {}) {
+    this.filePath = filePath;
+    this.onDatagram = onDatagram;
+    this.log = log;
+    this.speed = speed;
+    this.loops = loops;
+    this.datagrams = 0;
+  }
+
+  start() {
+    this.records = readCapture(fs.readFileSync(this.filePath));
+    if (this.records.length === 0) {
+      this.log(`[Replay] ${this.filePath} holds no datagrams`, true);
+      return this;
+    }
+    this.firstUs = this.records[0].timeUs;
+    this.log(`[Replay] Replaying ${this.records.length} datagrams from ${this.filePath} ` +
+      `${this.speed > 0 ? `at ${this.speed}x` : 'as fast as possible'}, ${this.loops} time(s)`);
+    this.play(1);
+    return this;
+  }
+
+  play(run) {
+    this.run = run;
+    this.index = 0;
+    this.runStartMs = performance.now();
+    this.step();
+  }
+
+  // Feed every record that is due, then wait for the next one
+  step() {
+    let fed = 0;
+    while (this.index < this.records.length) {
+      const record = this.records[this.index];
+      if (this.speed > 0) {
+        const dueMs = this.runStartMs + Number(record.timeUs - this.firstUs) / 1000 / this.speed;
+        if (dueMs - performance.now() >= 1) {
+          setTimeout(() => this.step(), dueMs - performance.now());
+          return;
+        }
+      }
+      if (fed++ === YIELD_EVERY) {
+        setImmediate(() => this.step());
+        return;
+      }
+      this.index++;
+      this.datagrams++;
+      this.onDatagram(record.message, record.remote, record.port, this.run);
+    }
+
+    this.log(`[Replay] Run ${this.run} of ${this.loops} done, ${this.datagrams} datagrams fed so far`);
+    if (this.run < this.loops) {
+      this.play(this.run + 1);
+    }
+  }
+}
+
+module.exports = {
+  ReplaySource,
+};
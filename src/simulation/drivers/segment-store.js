@@ -0,0 +1,350 @@
+'use strict';
+
+const fs = require('fs');
+const http = require('http');
+const path = require('path');
+const fetch = require('node-fetch'); // HTTP client for Hyperledger API
+const { keepAliveAgent } = require('./submit-queue');
+const { leafHash, merkleRoot, merkleProof } = require('./merkle');
+
+// ------------------------------------------------------------
+// Configuration and Constants
+// ------------------------------------------------------------
+// In anchoring mode raw readings stay off-chain: each sensor type appends them
+// to one JSON-lines segment per time window, and when a window closes only
+// its Merkle root and metadata are committed, through AnchorWindow on that
+// sensor's chaincode. The proof server hands out a reading with its inclusion
+// proof so it can be checked against the anchored root later.
+const DEFAULTS = {
+  dir: process.env.ANCHOR_DIR || path.join(__dirname, 'segments'),
+  windowMs: (Number(process.env.ANCHOR_WINDOW_S) || 60) * 1000,
+  anchorEndpoint: process.env.ANCHOR_ENDPOINT || 'http://localhost:3000/api/anchors',
+  apiKey: process.env.HYPERLEDGER_API_KEY || '8554358f-2152-42c2-a892-f48a85608504',
+};
+
+const SENSOR_PATTERN = /^[a-z]+$/;
+const WINDOW_PATTERN = /^\d+$/;
+
+// ------------------------------------------------------------
+// Class: Segment Store
+// ------------------------------------------------------------
+// Files live under <dir>/<sensor>/: <windowId>.jsonl holds the readings, one
+// per line, and <windowId>.anchor.json the closed window's root, count and
+// anchoring state. The window id is the window start in epoch milliseconds.
+// Windows are aligned to windowMs, so a restart inside a window reopens its
+// segment and keeps appending.
+class SegmentStore {
+  constructor(options = {}) {
+    this.options = { ...DEFAULTS, ...options };
+    this.log = this.options.log || ((message, isError) => (isError ? console.error : console.log)(message));
+    this.open = new Map();       // sensor -> { windowId, end, stream, leaves }
+    this.unanchored = new Map(); // "sensor/windowId" -> anchor metadata
+    this.anchoring = new Set();  // Keys with a submission in flight
+    this.counters = { appended: 0, windows: 0, anchored: 0, anchorFailures: 0, anchorConflicts: 0 };
+  }
+
+  // ------------------------------------------------------------
+  // Function: Start Rotation and Recover Earlier Windows
+  // ------------------------------------------------------------
+  start() {
+    fs.mkdirSync(this.options.dir, { recursive: true });
+    this.recover();
+    this.timer = setInterval(() => this.tick(), Math.min(this.options.windowMs, 5000));
+    this.timer.unref();
+  }
+
+  // Segments of ended windows left open by a crash or shutdown are closed,
+  // and the current window's segments are reopened so tick() closes them on
+  // time. Closed but unanchored windows are queued.
+  recover() {
+    const now = Date.now();
+    for (const sensor of fs.readdirSync(this.options.dir)) {
+      const sensorDir = path.join(this.options.dir, sensor);
+      if (!SENSOR_PATTERN.test(sensor) || !fs.statSync(sensorDir).isDirectory()) {
+        continue;
+      }
+      for (const file of fs.readdirSync(sensorDir)) {
+        const windowId = file.replace(/\.jsonl$/, '');
+        const start = Number(windowId);
+        if (!file.endsWith('.jsonl')) {
+          continue;
+        }
+        if (start + this.options.windowMs > now) {
+          if (!this.open.has(sensor)) {
+            this.openWindow(sensor, now);
+          }
+          continue;
+        }
+        const metaPath = this.metaPath(sensor, windowId);
+        if (!fs.existsSync(metaPath)) {
+          this.repairTail(this.segmentPath(sensor, windowId));
+          const leaves = readLines(this.segmentPath(sensor, windowId)).map(leafHash);
+          if (leaves.length > 0) {
+            this.writeMeta(this.buildMeta(sensor, windowId, leaves));
+          }
+        }
+        if (fs.existsSync(metaPath)) {
+          const meta = JSON.parse(fs.readFileSync(metaPath, 'utf8'));
+          if (!meta.anchored) {
+            this.unanchored.set(`${sensor}/${windowId}`, meta);
+          }
+        }
+      }
+    }
+    if (this.unanchored.size > 0) {
+      this.log(`Segment store: ${this.unanchored.size} window(s) waiting to be anchored`);
+    }
+  }
+
+  // A crash can leave half a line at the end of a segment. It is cut off, so
+  // the next append starts a line of its own and every line parses.
+  repairTail(segment) {
+    if (!fs.existsSync(segment)) {
+      return;
+    }
+    const content = fs.readFileSync(segment);
+    if (content.length === 0 || content[content.length - 1] === 0x0a) {
+      return;
+    }
+    const keep = content.lastIndexOf(0x0a) + 1;
+    fs.truncateSync(segment, keep);
+    this.log(`Segment ${segment}: dropped a torn last line of ${content.length - keep} bytes`, true);
+  }
+
+  segmentPath(sensor, windowId) {
+    return path.join(this.options.dir, sensor, `${windowId}.jsonl`);
+  }
+
+  metaPath(sensor, windowId) {
+    return path.join(this.options.dir, sensor, `${windowId}.anchor.json`);
+  }
+
+  // ------------------------------------------------------------
+  // Function: Append a Reading
+  // ------------------------------------------------------------
+  append(sensor, reading) {
+    const now = Date.now();
+    let window = this.open.get(sensor);
+    if (window && now >= window.end) {
+      this.closeWindow(sensor);
+      window = null;
+    }
+    if (!window) {
+      window = this.openWindow(sensor, now);
+    }
+
+    const line = JSON.stringify(reading);
+    window.stream.write(`${line}\n`);
+    window.leaves.push(leafHash(line));
+    this.counters.appended++;
+  }
+
+  openWindow(sensor, now) {
+    const start = Math.floor(now / this.options.windowMs) * this.options.windowMs;
+    const windowId = String(start);
+    const segment = this.segmentPath(sensor, windowId);
+    fs.mkdirSync(path.dirname(segment), { recursive: true });
+    this.repairTail(segment);
+
+    const window = {
+      windowId,
+      end: start + this.options.windowMs,
+      leaves: readLines(segment).map(leafHash), // Resume a window reopened after a restart
+      stream: fs.createWriteStream(segment, { flags: 'a' }),
+    };
+    window.stream.on('error', (error) => this.log(`Segment ${segment}: ${error.message}`, true));
+    this.open.set(sensor, window);
+    return window;
+  }
+
+  // ------------------------------------------------------------
+  // Function: Close a Window and Anchor Its Root
+  // ------------------------------------------------------------
+  // Resolves once the metadata is on disk; anchoring continues in the background.
+  closeWindow(sensor) {
+    const window = this.open.get(sensor);
+    this.open.delete(sensor);
+    const meta = this.buildMeta(sensor, window.windowId, window.leaves);
+
+    // The metadata is written once the segment is flushed, so proofs never see a partial file
+    return new Promise((resolve) => window.stream.end(() => {
+      this.writeMeta(meta);
+      this.counters.windows++;
+      this.unanchored.set(`${sensor}/${window.windowId}`, meta);
+      this.anchor(meta);
+      resolve();
+    }));
+  }
+
+  buildMeta(sensor, windowId, leaves) {
+    const start = Number(windowId);
+    return {
+      sensor,
+      windowId,
+      start: new Date(start).toISOString(),
+      end: new Date(start + this.options.windowMs).toISOString(),
+      count: leaves.length,
+      root: merkleRoot(leaves),
+      segment: `${windowId}.jsonl`,
+      anchored: false,
+    };
+  }
+
+  writeMeta(meta) {
+    fs.writeFileSync(this.metaPath(meta.sensor, meta.windowId), JSON.stringify(meta, null, 2));
+  }
+
+  // Close expired windows and retry anchors that failed earlier
+  tick() {
+    const now = Date.now();
+    for (const [sensor, window] of this.open) {
+      if (now >= window.end) {
+        this.closeWindow(sensor);
+      }
+    }
+    for (const meta of this.unanchored.values()) {
+      this.anchor(meta);
+    }
+  }
+
+  async anchor(meta) {
+    const key = `${meta.sensor}/${meta.windowId}`;
+    if (this.anchoring.has(key)) {
+      return;
+    }
+    this.anchoring.add(key);
+
+    try {
+      const { sensor, windowId, root, count, start, end, segment } = meta;
+      const response = await fetch(this.options.anchorEndpoint, {
+        method: 'POST',
+        headers: { 'Content-Type': 'application/json', 'X-Api-Key': this.options.apiKey },
+        body: JSON.stringify({ sensor, windowId, root, count, start, end, segment }),
+        agent: keepAliveAgent,
+      });
+      const body = await response.text();
+      // 409: the window was anchored before, e.g. the reply to an earlier attempt was lost.
+      // That only counts if the anchored root is this one.
+      if (response.status === 409) {
+        const anchoredRoot = await this.fetchAnchoredRoot(meta);
+        if (anchoredRoot !== root) {
+          meta.conflictingRoot = anchoredRoot;
+          this.writeMeta(meta);
+          this.unanchored.delete(key);
+          this.counters.anchorConflicts++;
+          this.log(`Anchoring ${key} conflicts: the ledger holds root ${anchoredRoot}, ` +
+            `the segment ${root}; its proofs will not verify`, true);
+          return;
+        }
+      } else if (!response.ok) {
+        throw new Error(`HTTP error! Status: ${response.status} ${body}`);
+      }
+
+      meta.anchored = true;
+      meta.anchoredAt = new Date().toISOString();
+      this.writeMeta(meta);
+      this.unanchored.delete(key);
+      this.counters.anchored++;
+      this.log(`Anchored ${key}: ${meta.count} reading(s), root ${meta.root}`);
+    } catch (error) {
+      this.counters.anchorFailures++;
+      this.log(`Anchoring ${key} failed, will retry: ${error.message}`, true);
+    } finally {
+      this.anchoring.delete(key);
+    }
+  }
+
+  // Root of a window already on the ledger (GET /api/anchors/<sensor>/<windowId>)
+  async fetchAnchoredRoot({ sensor, windowId }) {
+    const response = await fetch(`${this.options.anchorEndpoint}/${sensor}/${windowId}`, {
+      headers: { 'X-Api-Key': this.options.apiKey },
+      agent: keepAliveAgent,
+    });
+    const body = await response.text();
+    if (!response.ok) {
+      throw new Error(`Reading the existing anchor failed: HTTP ${response.status} ${body}`);
+    }
+    return JSON.parse(body).data.root;
+  }
+
+  // ------------------------------------------------------------
+  // Function: Reading with Inclusion Proof
+  // ------------------------------------------------------------
+  // Only closed windows have a root, so open ones are refused.
+  readingProof(sensor, windowId, index) {
+    if (!SENSOR_PATTERN.test(sensor) || !WINDOW_PATTERN.test(windowId)) {
+      return null;
+    }
+    const metaPath = this.metaPath(sensor, windowId);
+    if (!fs.existsSync(metaPath)) {
+      return null;
+    }
+
+    const meta = JSON.parse(fs.readFileSync(metaPath, 'utf8'));
+    const lines = readLines(this.segmentPath(sensor, windowId)).slice(0, meta.count);
+    if (!(index >= 0 && index < lines.length)) {
+      return null;
+    }
+    return {
+      sensor,
+      windowId,
+      index,
+      line: lines[index], // Exact bytes that were hashed
+      reading: JSON.parse(lines[index]),
+      proof: merkleProof(lines.map(leafHash), index),
+      root: meta.root,
+      anchored: meta.anchored,
+    };
+  }
+
+  stats() {
+    return { ...this.counters, openWindows: this.open.size, unanchored: this.unanchored.size };
+  }
+
+  // Before exiting: close the windows that have ended and flush the others
+  // without closing them. A window closed early would be reopened and
+  // anchored again after a restart within it; recover() picks it up instead.
+  shutdown() {
+    clearInterval(this.timer);
+    const now = Date.now();
+    return Promise.all([...this.open].map(([sensor, window]) => {
+      if (now >= window.end) {
+        return this.closeWindow(sensor);
+      }
+      this.open.delete(sensor);
+      return new Promise((resolve) => window.stream.end(resolve));
+    }));
+  }
+}
+
+function readLines(file) {
+  if (!fs.existsSync(file)) {
+    return [];
+  }
+  return fs.readFileSync(file, 'utf8').split('\n').filter((line) => line.length > 0);
+}
+
+// ------------------------------------------------------------
+// Function: Proof Server
+// ------------------------------------------------------------
+// GET /segments/<sensor>/<windowId>/readings/<index> returns the reading, its
+// proof and the window root; POST the result to the gateway's
+// /api/anchors/<sensor>/verify to check it against the anchored root.
+function createProofServer(store) {
+  return http.createServer((req, res) => {
+    const match = /^\/segments\/([^/]+)\/([^/]+)\/readings\/(\d+)$/.exec(req.url);
+    let result;
+    try {
+      result = req.method === 'GET' && match ? store.readingProof(match[1], match[2], Number(match[3])) : null;
+    } catch (error) {
+      res.writeHead(500, { 'Content-Type': 'application/json' });
+      res.end(JSON.stringify({ error: error.message }));
+      return;
+    }
+
+    res.writeHead(result ? 200 : 404, { 'Content-Type': 'application/json' });
+    res.end(JSON.stringify(result || { error: 'No such reading in a closed window' }));
+  });
+}
+
+module.exports = { SegmentStore, createProofServer };
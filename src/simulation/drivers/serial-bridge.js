@@ -0,0 +1,125 @@
+'use strict';
+
+const fs = require('fs');
+const net = require('net');
+const readline = require('readline');
+
+// ------------------------------------------------------------
+// Border Router Serial Bridge
+// ------------------------------------------------------------
+// A border router consumes every datagram sent to its collector ports and
+// writes it to its serial uplink as one line (devices/border-router.c):
+//   I <sender iid> <collector port> <hex payload>[<hop trailer>]
+// The bridge reads those lines and hands each datagram to the daemon as if
+// it had arrived over UDP from the sender. A source is one of:
+//   tcp://host:port  a Cooja Serial Socket (server) on the border router mote
+//   -                standard input, e.g. tunslip6 output piped to the daemon
+//   <path>           a serial device or named pipe
+// Other lines on the uplink (logs, S/E/R statistics) are ignored.
+
+const INGEST_LINE = /(?:^|\s)I ([0-9a-f]{16}) (\d+) ((?:[0-9a-f]{2})+)$/;
+const SENSOR_PORT = 5555;          // INGEST_SENSOR_PORT, the port every sensor sends from
+const RECONNECT_DELAY_MS = 2000;   // Wait before reconnecting a TCP source
+
+// ------------------------------------------------------------
+// Function: Parse One Uplink Line
+// ------------------------------------------------------------
+// Returns { iid, port, payload } for an I line and null for anything else.
+// Leading text (a tunslip6 timestamp, a Cooja mote prefix) is skipped.
+function parseIngestLine(line) {
+  const match = INGEST_LINE.exec(line.trim());
+  if (!match) {
+    return null;
+  }
+  return { iid: match[1], port: Number(match[2]), payload: Buffer.from(match[3], 'hex') };
+}
+
+// The link-local address of an IID: the sender as the daemon reports,
+// captures and keys it. The /64 prefix is the border router's, which the
+// line does not carry.
+function iidAddress(iid) {
+  return `fe80::${iid.match(/.{4}/g).map((group) => group.replace(/^0+(?=.)/, '')).join(':')}`;
+}
+
+// ------------------------------------------------------------
+// Class: Serial Source
+// ------------------------------------------------------------
+// Calls onDatagram(payload, remote, port, source) for every I line. TCP
+// sources reconnect after the simulation restarts; stdin and files end with
+// their stream.
+class SerialSource {
+  constructor(spec, onDatagram, log) {
+    this.spec = spec;
+    this.onDatagram = onDatagram;
+    this.log = log;
+    this.lines = 0;
+    this.datagrams = 0;
+    this.closed = false;
+  }
+
+  start() {
+    const tcp = /^tcp:\/\/(.+):(\d+)$/.exec(this.spec);
+    if (tcp) {
+      this.connect(tcp[1].replace(/^\[(.*)\]$/, '$1'), Number(tcp[2]));
+    } else if (this.spec === '-') {
+      this.read(process.stdin);
+    } else {
+      const stream = fs.createReadStream(this.spec);
+      stream.on('error', (error) => this.log(`[Serial] ${this.spec}: ${error.message}`, true));
+      this.read(stream);
+    }
+    return this;
+  }
+
+  connect(host, port) {
+    const socket = net.connect({ host, port });
+    this.socket = socket;
+    socket.on('connect', () => this.log(`[Serial] Reading border router uplink at ${this.spec}`));
+    socket.on('error', (error) => this.log(`[Serial] ${this.spec}: ${error.message}`, true));
+    socket.on('close', () => {
+      if (!this.closed) {
+        this.reconnectTimer = setTimeout(() => this.connect(host, port), RECONNECT_DELAY_MS);
+      }
+    });
+    this.read(socket);
+  }
+
+  read(stream) {
+    readline.createInterface({ input: stream, crlfDelay: Infinity }).on('line', (line) => this.handleLine(line));
+  }
+
+  handleLine(line) {
+    this.lines++;
+    const parsed = parseIngestLine(line);
+    if (!parsed) {
+      return;
+    }
+    this.datagrams++;
+    this.onDatagram(parsed.payload, { address: iidAddress(parsed.iid), port: SENSOR_PORT }, parsed.port, this.spec);
+  }
+
+  close() {
+    this.closed = true;
+    clearTimeout(this.reconnectTimer);
+    if (this.socket) {
+      this.socket.destroy();
+    }
+  }
+}
+
+// ------------------------------------------------------------
+// Function: Open Every Configured Source
+// ------------------------------------------------------------
+// specs is the comma-separated INGEST_SERIAL value.
+function startSerialSources(specs, onDatagram, log) {
+  return specs.split(',').map((spec) => spec.trim()).filter(Boolean)
+      .map((spec) => new SerialSource(spec, onDatagram, log).start());
+}
+
+module.exports = {
+  SENSOR_PORT,
+  parseIngestLine,
+  iidAddress,
+  SerialSource,
+  startSerialSources,
+};
@@ -0,0 +1,259 @@
+'use strict';
+
+const http = require('http');
+const fs = require('fs');
+const fetch = require('node-fetch'); // HTTP client for Hyperledger API
+
+// ------------------------------------------------------------
+// Configuration and Constants
+// ------------------------------------------------------------
+// Every setting can be overridden per driver or through the environment.
+const DEFAULTS = {
+  endpoint: process.env.HYPERLEDGER_ENDPOINT || 'http://localhost:3000/api/assets',
+  // The gateway's PutReadingsBatch route; set HYPERLEDGER_BATCH_ENDPOINT empty for one POST per reading
+  batchEndpoint: process.env.HYPERLEDGER_BATCH_ENDPOINT === undefined
+    ? 'http://localhost:3000/api/readings/batch' : process.env.HYPERLEDGER_BATCH_ENDPOINT || null,
+  apiKey: process.env.HYPERLEDGER_API_KEY || '8554358f-2152-42c2-a892-f48a85608504',
+  maxQueue: Number(process.env.SUBMIT_MAX_QUEUE) || 10000,        // Readings held before shedding
+  batchSize: Number(process.env.SUBMIT_BATCH_SIZE) || 50,         // Readings per submission
+  batchWindowMs: Number(process.env.SUBMIT_BATCH_WINDOW_MS) || 200, // Longest wait for a full batch
+  maxInFlight: Number(process.env.SUBMIT_MAX_IN_FLIGHT) || 4,     // Concurrent HTTP requests
+  maxAttempts: Number(process.env.SUBMIT_MAX_ATTEMPTS) || 6,      // Tries per batch, including the first
+  backoffBaseMs: 250,
+  backoffMaxMs: 15000,
+  statsIntervalMs: 30000,
+  deadLetterFile: process.env.SUBMIT_DEAD_LETTER_FILE || null,    // JSON lines of readings given up on
+};
+
+// One keep-alive pool per process instead of a TCP handshake per reading
+const keepAliveAgent = new http.Agent({ keepAlive: true, maxSockets: 16 });
+
+// Queues drained before the process exits on SIGINT or SIGTERM
+const liveQueues = new Set();
+
+function drainOnExit(signal) {
+  console.log(`${signal} received, draining ${liveQueues.size} submit queue(s)...`);
+  Promise.all([...liveQueues].map((queue) => queue.drain().then(() => queue.logStats())))
+      .then(() => process.exit(0));
+}
+
+// Full jitter: a random delay up to the exponential cap, so retries spread out
+function backoffDelay(attempt, baseMs, maxMs) {
+  return Math.random() * Math.min(maxMs, baseMs * 2 ** (attempt - 1));
+}
+
+// ------------------------------------------------------------
+// Class: Submit Queue
+// ------------------------------------------------------------
+// Bounded in-memory queue between the UDP handlers and the REST gateway.
+// Readings are coalesced into batches, at most maxInFlight requests run at
+// once and failed batches are retried with backoff. Nothing is dropped
+// without being counted: a full queue sheds the incoming reading, and a batch
+// that exhausts its attempts is counted as failed and written to the
+// dead-letter file when one is configured. With a latency option (a
+// LatencyHistograms from latency.js), readings are stamped with submitted_ms
+// and the driver and post stages are recorded.
+class SubmitQueue {
+  constructor(options = {}) {
+    this.options = { ...DEFAULTS, ...options };
+    this.log = this.options.log || ((message, isError) => (isError ? console.error : console.log)(message));
+    this.headers = {
+      'Content-Type': 'application/json',
+      'X-Api-Key': this.options.apiKey,
+    };
+    this.pending = [];      // Readings waiting for a batch
+    this.retries = 0;       // Batches waiting for a backoff timer
+    this.inFlight = 0;
+    this.flushTimer = null;
+    this.batchSupported = Boolean(this.options.batchEndpoint);
+    this.counters = { enqueued: 0, submitted: 0, batches: 0, retried: 0, shed: 0, failed: 0 };
+
+    if (this.options.statsIntervalMs > 0) {
+      this.statsTimer = setInterval(() => this.logStats(), this.options.statsIntervalMs);
+      this.statsTimer.unref();
+    }
+
+    if (liveQueues.size === 0) {
+      process.once('SIGINT', drainOnExit);
+      process.once('SIGTERM', drainOnExit);
+    }
+    liveQueues.add(this);
+  }
+
+  // ------------------------------------------------------------
+  // Function: Push a Reading
+  // ------------------------------------------------------------
+  // Returns false when the reading was shed because the queue is full.
+  push(dataBlock) {
+    if (this.depth() >= this.options.maxQueue) {
+      this.counters.shed++;
+      if (this.counters.shed === 1 || this.counters.shed % 1000 === 0) {
+        this.log(`Submit queue full (${this.options.maxQueue}), ${this.counters.shed} reading(s) shed so far`, true);
+      }
+      return false;
+    }
+
+    this.pending.push(dataBlock);
+    this.counters.enqueued++;
+    this.schedule();
+    return true;
+  }
+
+  // Readings held in memory, including batches waiting to be retried
+  depth() {
+    return this.pending.length + this.retries * this.options.batchSize;
+  }
+
+  stats() {
+    return { ...this.counters, queued: this.pending.length, inFlight: this.inFlight, retrying: this.retries };
+  }
+
+  logStats() {
+    const s = this.stats();
+    this.log(`Submit queue: ${s.submitted}/${s.enqueued} submitted in ${s.batches} batch(es), ` +
+      `${s.queued} queued, ${s.inFlight} in flight, ${s.retried} retried, ${s.shed} shed, ${s.failed} failed`);
+  }
+
+  // ------------------------------------------------------------
+  // Function: Schedule Batches
+  // ------------------------------------------------------------
+  // A full batch goes out at once; a partial one waits for the window.
+  schedule() {
+    while (this.inFlight < this.options.maxInFlight && this.pending.length >= this.options.batchSize) {
+      this.dispatch(this.pending.splice(0, this.options.batchSize), 1);
+    }
+
+    if (this.pending.length > 0 && !this.flushTimer) {
+      this.flushTimer = setTimeout(() => {
+        this.flushTimer = null;
+        if (this.inFlight < this.options.maxInFlight && this.pending.length > 0) {
+          this.dispatch(this.pending.splice(0, this.options.batchSize), 1);
+        }
+        this.schedule();
+      }, this.options.batchWindowMs);
+    }
+  }
+
+  async dispatch(batch, attempt) {
+    this.inFlight++;
+    try {
+      await this.submit(batch);
+      this.counters.submitted += batch.length;
+      this.counters.batches++;
+    } catch (error) {
+      this.retry(batch, attempt, error);
+    } finally {
+      this.inFlight--;
+      this.schedule();
+    }
+  }
+
+  retry(batch, attempt, error) {
+    if (attempt >= this.options.maxAttempts) {
+      this.counters.failed += batch.length;
+      this.log(`Giving up on ${batch.length} reading(s) after ${attempt} attempts: ${error.message}`, true);
+      this.deadLetter(batch);
+      return;
+    }
+
+    const delay = backoffDelay(attempt, this.options.backoffBaseMs, this.options.backoffMaxMs);
+    this.counters.retried++;
+    this.retries++;
+    this.log(`Submission failed (${error.message}), retry ${attempt}/${this.options.maxAttempts - 1} ` +
+      `in ${Math.round(delay)} ms`, true);
+    setTimeout(() => {
+      this.retries--;
+      this.dispatch(batch, attempt + 1);
+    }, delay);
+  }
+
+  deadLetter(batch) {
+    if (!this.options.deadLetterFile) {
+      return;
+    }
+    const lines = batch.map((dataBlock) => `${JSON.stringify(dataBlock)}\n`).join('');
+    fs.appendFile(this.options.deadLetterFile, lines, (error) => {
+      if (error) {
+        this.log(`Cannot write dead-letter file: ${error.message}`, true);
+      }
+    });
+  }
+
+  // ------------------------------------------------------------
+  // Function: Submit One Batch to the Gateway
+  // ------------------------------------------------------------
+  // Uses the batch endpoint when one is configured and while the gateway
+  // offers it; a 404 or 405 switches this queue to one POST per reading for
+  // the rest of the run.
+  async submit(batch) {
+    if (this.batchSupported) {
+      const submittedMs = this.stampSubmitted(batch);
+      const response = await this.post(this.options.batchEndpoint, { readings: batch });
+      if (response.status !== 404 && response.status !== 405) {
+        await checkResponse(response);
+        return this.recordPosted(batch, submittedMs);
+      }
+      this.batchSupported = false;
+      this.log(`No batch endpoint at ${this.options.batchEndpoint}, submitting readings one by one`);
+    }
+
+    // Per-reading fallback: retry only what has not been accepted yet
+    while (batch.length > 0) {
+      const submittedMs = this.stampSubmitted(batch.slice(0, 1));
+      await checkResponse(await this.post(this.options.endpoint, batch[0]));
+      this.recordPosted(batch.slice(0, 1), submittedMs);
+      batch.shift();
+      this.counters.submitted++;
+    }
+  }
+
+  // Stamp readings as they leave for the gateway; time spent in the driver ends here
+  stampSubmitted(readings) {
+    const submittedMs = Date.now();
+    for (const dataBlock of readings) {
+      dataBlock.submitted_ms = submittedMs;
+      if (this.options.latency && dataBlock.received_ms !== undefined) {
+        this.options.latency.record('driver', submittedMs - dataBlock.received_ms);
+      }
+    }
+    return submittedMs;
+  }
+
+  recordPosted(readings, submittedMs) {
+    if (this.options.latency) {
+      const postMs = Date.now() - submittedMs;
+      readings.forEach(() => this.options.latency.record('post', postMs));
+    }
+  }
+
+  post(url, body) {
+    return fetch(url, {
+      method: 'POST',
+      headers: this.headers,
+      body: JSON.stringify(body),
+      agent: keepAliveAgent,
+    });
+  }
+
+  // ------------------------------------------------------------
+  // Function: Drain
+  // ------------------------------------------------------------
+  // Resolves once every queued reading has been submitted, shed or failed.
+  async drain() {
+    while (this.pending.length > 0 || this.inFlight > 0 || this.retries > 0) {
+      while (this.inFlight < this.options.maxInFlight && this.pending.length > 0) {
+        this.dispatch(this.pending.splice(0, this.options.batchSize), 1);
+      }
+      await new Promise((resolve) => setTimeout(resolve, 50));
+    }
+  }
+}
+
+async function checkResponse(response) {
+  if (!response.ok) {
+    throw new Error(`HTTP error! Status: ${response.status}`);
+  }
+  await response.text(); // Release the socket back to the keep-alive pool
+}
+
+module.exports = { SubmitQueue, backoffDelay, keepAliveAgent };
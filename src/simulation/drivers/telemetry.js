@@ -0,0 +1,191 @@
+'use strict';
+
+// ------------------------------------------------------------
+// Binary Telemetry Frame Decoder
+// ------------------------------------------------------------
+// Mirrors devices/telemetry.h. A frame is a 3-byte header
+// (magic|version, sensor type, device id) followed by fields made of one tag
+// byte (field id << 3 | value length) and 0-4 big-endian value bytes.
+// Decoded frames use the same keys as the legacy ASCII payloads so the rest
+// of each driver does not care which format the mote was built with.
+// Batch frames (TELEMETRY_FLAG_BATCH in the sensor byte) carry a sample count
+// followed by length-prefixed samples, each with its age in seconds.
+// Frames forwarded by a border router end with a hop trailer (its receive
+// time); in a batch frame the trailer follows the last sample and is copied
+// into every reading.
+
+const TELEMETRY_MAGIC = 0xb0;
+const TELEMETRY_VERSION = 1;
+const TELEMETRY_HEADER_LEN = 3;
+const TELEMETRY_MAX_VALUE_LEN = 4;
+const TELEMETRY_SENSOR_MASK = 0x7f;
+const TELEMETRY_FLAG_BATCH = 0x80;
+
+const SENSOR_TYPES = {
+  1: 'integrity',
+  2: 'monitor',
+  3: 'availability',
+  4: 'network',
+  5: 'security',
+  6: 'energy',
+  7: 'control',
+};
+
+const FIELDS = {
+  1: 'breach_flag',
+  2: 'integrity_flag',
+  3: 'availability',
+  4: 'latency',
+  5: 'packet_loss',
+  6: 'log_id',
+  7: 'status',
+  8: 'age_s',
+  9: 'seq',
+  10: 'cpu_ms',
+  11: 'lpm_ms',
+  12: 'tx_ms',
+  13: 'listen_ms',
+  14: 'slowdown',
+  15: 'hold_s',
+  16: 'device_hi',
+  17: 'net_time_ms',
+  18: 'node_time_ms',
+  19: 'hop_time_ms',
+};
+
+const STATUS_MESSAGES = {
+  0: 'Monitor_OK',
+};
+
+// ------------------------------------------------------------
+// Function: Detect Binary Frames
+// ------------------------------------------------------------
+function isTelemetryFrame(message) {
+  return message.length >= TELEMETRY_HEADER_LEN &&
+    message[0] === (TELEMETRY_MAGIC | TELEMETRY_VERSION);
+}
+
+// ------------------------------------------------------------
+// Function: Decode Fields Starting at an Offset
+// ------------------------------------------------------------
+function decodeFields(message, offset, end, fields) {
+  while (offset < end) {
+    const tag = message[offset++];
+    const fieldId = tag >> 3;
+    const valueLen = tag & 0x07;
+
+    if (valueLen > TELEMETRY_MAX_VALUE_LEN || offset + valueLen > end) {
+      throw new Error(`Malformed telemetry field ${fieldId} at byte ${offset - 1}`);
+    }
+
+    let value = 0;
+    for (let i = 0; i < valueLen; i++) {
+      value = value * 256 + message[offset++];
+    }
+
+    const key = FIELDS[fieldId] || `field_${fieldId}`;
+    fields[key] = value;
+  }
+
+  if (fields.status !== undefined && STATUS_MESSAGES[fields.status]) {
+    fields.message = STATUS_MESSAGES[fields.status];
+  }
+
+  return fields;
+}
+
+// Fold the optional high device id bits into device_id (4+ hex digits)
+function withWideDeviceId(reading) {
+  if (reading.device_hi !== undefined) {
+    const low = parseInt(reading.device_id, 16);
+    reading.device_id = (reading.device_hi * 256 + low).toString(16).toUpperCase().padStart(4, '0');
+    delete reading.device_hi;
+  }
+  return reading;
+}
+
+// DEVICE_HI of a frame's first sample, 0 without one. Native builds send it
+// in every sample; the receiver needs it to pick an authenticated frame's key.
+function frameDeviceHi(message) {
+  let offset = TELEMETRY_HEADER_LEN;
+  let end = message.length;
+  if (message[1] & TELEMETRY_FLAG_BATCH) {
+    offset += 2; // Sample count, first sample length
+    if (offset > end) {
+      return 0;
+    }
+    end = Math.min(end, offset + message[offset - 1]);
+  }
+  return decodeFields(message, offset, end, {}).device_hi || 0;
+}
+
+// ------------------------------------------------------------
+// Function: Decode a Binary Frame into Readings
+// ------------------------------------------------------------
+// Returns one reading for a plain frame and one per sample for a batch.
+function decodeTelemetryFrame(message) {
+  if (!isTelemetryFrame(message)) {
+    throw new Error('Not a binary telemetry frame');
+  }
+
+  const sensorType = message[1] & TELEMETRY_SENSOR_MASK;
+  const header = {
+    sensor: SENSOR_TYPES[sensorType] || `sensor_${sensorType}`,
+    device_id: message[2].toString(16).toUpperCase().padStart(2, '0'),
+  };
+
+  if (!(message[1] & TELEMETRY_FLAG_BATCH)) {
+    return [withWideDeviceId(decodeFields(message, TELEMETRY_HEADER_LEN, message.length, { ...header }))];
+  }
+
+  if (message.length < TELEMETRY_HEADER_LEN + 1) {
+    throw new Error('Truncated telemetry batch header');
+  }
+
+  const count = message[TELEMETRY_HEADER_LEN];
+  const readings = [];
+  let offset = TELEMETRY_HEADER_LEN + 1;
+
+  for (let i = 0; i < count; i++) {
+    if (offset >= message.length) {
+      throw new Error(`Telemetry batch truncated after ${i} of ${count} samples`);
+    }
+
+    const sampleLen = message[offset++];
+    const end = offset + sampleLen;
+    if (end > message.length) {
+      throw new Error(`Telemetry sample ${i} overruns the frame`);
+    }
+
+    readings.push(withWideDeviceId(decodeFields(message, offset, end, { ...header })));
+    offset = end;
+  }
+
+  if (offset < message.length) {
+    const trailer = decodeFields(message, offset, message.length, {});
+    readings.forEach((reading) => Object.assign(reading, trailer));
+  }
+
+  return readings;
+}
+
+// ------------------------------------------------------------
+// Function: Convert a Frame into Driver Data Blocks
+// ------------------------------------------------------------
+// The request ID is the sampling time, rebuilt from each sample's age.
+function telemetryToDataBlocks(message) {
+  const receivedAt = Date.now();
+  return decodeTelemetryFrame(message).map((reading) => ({
+    rid: (receivedAt - (reading.age_s || 0) * 1000).toString(),
+    ...reading,
+  }));
+}
+
+module.exports = {
+  FIELDS,
+  SENSOR_TYPES,
+  isTelemetryFrame,
+  frameDeviceHi,
+  decodeTelemetryFrame,
+  telemetryToDataBlocks,
+};
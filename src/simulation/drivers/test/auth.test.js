@@ -0,0 +1,86 @@
+'use strict';
+
+const assert = require('node:assert');
+const crypto = require('node:crypto');
+const test = require('node:test');
+const { openAuthFrame, ReplayGuard } = require('../auth');
+const { parseDatagram } = require('../ingest-parser');
+
+// Two motes whose addresses differ above the device byte (07), so they share it
+const NODE_A = 'fd00::207:7:7:707';
+const NODE_A_IID = '0207000700070707';
+const NODE_B = 'fd00::212:7412:12:1207';
+
+// Seal a version 1 frame as devices/telemetry-auth.c does with the default
+// master key: the key is bound to the sender's interface identifier and DEVICE_HI
+function seal(frameHex, iid, deviceHi, counter) {
+  const frame = Buffer.from(frameHex, 'hex');
+  const block = Buffer.alloc(16);
+  block.write('IBKD', 0, 'ascii');
+  block[6] = deviceHi;
+  block[7] = frame[2];
+  Buffer.from(iid, 'hex').copy(block, 8);
+  const derive = crypto.createCipheriv('aes-128-ecb', Buffer.from('IoT-Blockchain01'), null);
+  derive.setAutoPadding(false);
+  const key = Buffer.concat([derive.update(block), derive.final()]);
+
+  const counterBytes = Buffer.alloc(4);
+  counterBytes.writeUInt32BE(counter);
+  const sealed = Buffer.concat([Buffer.from([0xb2, frame[1], frame[2], frame.length - 3]), frame.subarray(3), counterBytes]);
+  const nonce = Buffer.alloc(13);
+  nonce[0] = frame[2];
+  counterBytes.copy(nonce, 1);
+  nonce[5] = deviceHi;
+  const cipher = crypto.createCipheriv('aes-128-ccm', key, nonce, { authTagLength: 4 });
+  cipher.setAAD(sealed, { plaintextLength: 0 });
+  cipher.update(Buffer.alloc(0));
+  cipher.final();
+  return Buffer.concat([sealed, cipher.getAuthTag()]);
+}
+
+const INTEGRITY = 'b10107' + '1101' + '4a002a'; // integrity_flag 1, seq 42
+
+test('opens a frame with the key of its sender only', () => {
+  const message = Buffer.concat([seal(INTEGRITY, NODE_A_IID, 0, 5), Buffer.from('9c000003e8', 'hex')]);
+
+  const { frame, device, counter } = openAuthFrame(message, NODE_A);
+  assert.strictEqual(frame.toString('hex'), `${INTEGRITY}9c000003e8`);
+  assert.strictEqual(device, '07');
+  assert.strictEqual(counter, 5);
+
+  assert.throws(() => openAuthFrame(message, NODE_B), /MIC check failed for device 07/);
+});
+
+test('binds native instances that share an address to their DEVICE_HI', () => {
+  const native = 'b10107' + '8112' + '1101' + '4a002a'; // DEVICE_HI 12
+  const { readings, auth } = parseDatagram(seal(native, NODE_A_IID, 0x12, 1), 8843, NODE_A);
+  assert.strictEqual(auth.device, '1207');
+  assert.strictEqual(readings[0].device_id, '1207');
+
+  const claimed = 'b10107' + '8113' + '1101' + '4a002a'; // Another instance's DEVICE_HI
+  assert.throws(() => parseDatagram(seal(claimed, NODE_A_IID, 0x12, 1), 8843, NODE_A), /MIC check failed/);
+});
+
+test('keeps a replay window per sender', () => {
+  const guard = new ReplayGuard();
+  assert.strictEqual(guard.check(`${NODE_A_IID}/07`, 5, 1000), 'fresh');
+  assert.strictEqual(guard.check('0212741200121207/07', 5, 1000), 'fresh');
+  assert.strictEqual(guard.check(`${NODE_A_IID}/07`, 5, 1000), 'duplicate');
+  assert.strictEqual(guard.check(`${NODE_A_IID}/07`, 40, 1000), 'fresh');
+  assert.strictEqual(guard.check(`${NODE_A_IID}/07`, 5, 2000), 'replay');
+});
+
+test('rejects old frames replayed after a steady node\'s longest silence', () => {
+  const guard = new ReplayGuard({ rebootMs: 2 * 1340 * 1000 });
+  const sender = `${NODE_A_IID}/07`;
+  assert.strictEqual(guard.check(sender, 500, 0), 'fresh');
+
+  // A steady node under congestion sends every 1340 s at most
+  assert.strictEqual(guard.check(sender, 200, 1340 * 1000), 'replay');
+  assert.strictEqual(guard.check(sender, 501, 1340 * 1000), 'fresh');
+
+  // After a longer silence only a restarted counter is taken for a reboot
+  assert.strictEqual(guard.check(sender, 200, 5000 * 1000), 'replay');
+  assert.strictEqual(guard.check(sender, 0, 5000 * 1000), 'fresh');
+  assert.strictEqual(guard.check(sender, 1, 5000 * 1000), 'fresh');
+});
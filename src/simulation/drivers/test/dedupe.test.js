@@ -0,0 +1,39 @@
+'use strict';
+
+const assert = require('node:assert');
+const test = require('node:test');
+const { DuplicateFilter } = require('../dedupe');
+const { interfaceId } = require('../capture');
+
+// Two nodes whose addresses differ only above the last byte share device id
+// 07 (devices/telemetry.h). Node A reaches the host through two roots, each
+// with its own /64 prefix; the daemon keys senders by interface identifier.
+const NODE_A_ROOT_1 = interfaceId('fd00:1::207:7:7:707');
+const NODE_A_ROOT_2 = interfaceId('fd00:2::207:7:7:707');
+const NODE_B = interfaceId('fd00:1::212:7412:12:1207');
+
+const sample = (seq) => ({ sensor: 'integrity', device_id: '07', seq, integrity_flag: 0 });
+
+test('drops a copy forwarded by another root', () => {
+  const filter = new DuplicateFilter();
+  assert.strictEqual(filter.accept(sample(42), NODE_A_ROOT_1, 1000), true);
+  assert.strictEqual(filter.accept(sample(42), NODE_A_ROOT_2, 1500), false);
+  assert.strictEqual(filter.duplicates, 1);
+});
+
+test('keeps samples of nodes that share a device id', () => {
+  const filter = new DuplicateFilter();
+  assert.strictEqual(filter.accept(sample(42), NODE_A_ROOT_1, 1000), true);
+  assert.strictEqual(filter.accept(sample(42), NODE_B, 1000), true);
+  assert.strictEqual(filter.duplicates, 0);
+});
+
+test('forgets samples after the window and passes readings without a seq', () => {
+  const filter = new DuplicateFilter({ windowMs: 1000 });
+  assert.strictEqual(filter.accept(sample(42), NODE_A_ROOT_1, 1000), true);
+  assert.strictEqual(filter.accept(sample(42), NODE_A_ROOT_1, 2000), true);
+
+  const legacy = { sensor: 'integrity', device_id: '07', integrity_flag: 0 };
+  assert.strictEqual(filter.accept(legacy, NODE_A_ROOT_1, 2000), true);
+  assert.strictEqual(filter.accept(legacy, NODE_A_ROOT_1, 2000), true);
+});
@@ -0,0 +1,94 @@
+'use strict';
+
+const assert = require('node:assert');
+const fs = require('node:fs');
+const path = require('node:path');
+const test = require('node:test');
+const { FIELDS } = require('../telemetry');
+const { SCHEMAS, schemaByPort, parseDatagram } = require('../ingest-parser');
+
+const DEVICES = path.join(__dirname, '..', '..', 'devices');
+
+// ------------------------------------------------------------
+// Firmware Provider Table
+// ------------------------------------------------------------
+// Read from devices/sensor-providers.c and telemetry.h, so the schemas are
+// checked against what the motes actually send.
+function firmwareProviders() {
+  const header = fs.readFileSync(path.join(DEVICES, 'telemetry.h'), 'utf8');
+  const source = fs.readFileSync(path.join(DEVICES, 'sensor-providers.c'), 'utf8');
+  const define = (name) => Number(new RegExp(`#define ${name}\\s+(\\d+)`).exec(header)[1]);
+
+  return [...source.matchAll(/const struct sensor_provider (\w+)_provider = \{([^}]*)\}/g)].map(([, role, body]) => {
+    const encode = new RegExp(`${role}_encode\\([^)]*\\) \\{([^}]*)\\}`).exec(source)[1];
+    const format = new RegExp(`${role}_format\\([^)]*\\) \\{[^"]*"([^"]*)"`).exec(source);
+    return {
+      name: /\.name = "(\w+)"/.exec(body)[1],
+      sensorType: define(/\.sensor_type = (\w+)/.exec(body)[1]),
+      port: Number(/\.port = (\d+)/.exec(body)[1]),
+      fields: [...encode.matchAll(/telemetry_put\(sample, (\w+)/g)].map(([, field]) => FIELDS[define(field)]),
+      format: format ? format[1] : null,
+    };
+  });
+}
+
+// A plain frame as the firmware encodes it: every field 1, seq 7 and the
+// sampling time on the node clock
+function firmwareFrame(provider, device = 0x2a) {
+  const fieldIds = provider.fields.map((name) => Number(Object.keys(FIELDS).find((id) => FIELDS[id] === name)));
+  return Buffer.from([
+    0xb1, provider.sensorType, device,
+    ...fieldIds.flatMap((id) => [(id << 3) | 1, 1]),
+    (9 << 3) | 2, 0, 7,
+    (18 << 3) | 4, 0, 0, 0x30, 0x39,
+  ]);
+}
+
+const PROVIDERS = firmwareProviders();
+
+test('every firmware provider has a schema on its port', () => {
+  assert.strictEqual(PROVIDERS.length, Object.keys(SCHEMAS).length);
+  for (const provider of PROVIDERS) {
+    const schema = schemaByPort.get(provider.port);
+    assert.ok(schema, `no schema for port ${provider.port}`);
+    assert.strictEqual(schema.name, provider.name);
+    for (const field of schema.requiredFields.filter((f) => f !== 'device_id')) {
+      assert.ok(provider.fields.includes(field), `${provider.name} firmware never sends ${field}`);
+    }
+  }
+});
+
+test('binary firmware frames pass validation on their port', () => {
+  for (const provider of PROVIDERS) {
+    const { readings, invalid } = parseDatagram(firmwareFrame(provider), provider.port);
+    assert.strictEqual(invalid, 0, provider.name);
+    assert.strictEqual(readings[0].sensor, provider.name);
+    assert.strictEqual(readings[0].device_id, '2A');
+    assert.strictEqual(readings[0].seq, 7);
+  }
+});
+
+test('legacy ASCII payloads pass validation on their port', () => {
+  for (const provider of PROVIDERS.filter(({ format }) => format)) {
+    const text = provider.format.replace('%s', '2A').replace(/%d/g, '1').replace('%%', '%');
+    const { readings, invalid } = parseDatagram(Buffer.from(text), provider.port);
+    assert.strictEqual(invalid, 0, `${provider.name}: ${text}`);
+    assert.strictEqual(readings[0].sensor, provider.name);
+    for (const field of provider.fields.filter((f) => f !== 'status')) {
+      assert.strictEqual(readings[0][field], 1, `${provider.name}.${field}`);
+    }
+  }
+});
+
+test('decodes a security batch frame with a hop trailer', () => {
+  // Two samples from device 07, breach_flag 1 then 0, seq 5 and 6, ages 10 and 0 s
+  const frame = Buffer.from('b18507' + '02' + '07' + '0901' + '4a0005' + '410a' + '07' + '0900' + '4a0006' + '4100' +
+    '9c000003e8', 'hex');
+  const { readings, invalid } = parseDatagram(frame, 8847);
+  assert.strictEqual(invalid, 0);
+  assert.deepStrictEqual(readings.map(({ sensor, device_id, breach_flag, seq, age_s, hop_time_ms }) =>
+    ({ sensor, device_id, breach_flag, seq, age_s, hop_time_ms })), [
+    { sensor: 'security', device_id: '07', breach_flag: 1, seq: 5, age_s: 10, hop_time_ms: 1000 },
+    { sensor: 'security', device_id: '07', breach_flag: 0, seq: 6, age_s: 0, hop_time_ms: 1000 },
+  ]);
+});
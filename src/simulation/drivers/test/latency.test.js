@@ -0,0 +1,39 @@
+'use strict';
+
+const assert = require('node:assert');
+const test = require('node:test');
+const { LatencyHistograms, ClockOffsets, stampReading } = require('../latency');
+const { parseIngestLine, iidAddress } = require('../serial-bridge');
+const { parseDatagram } = require('../ingest-parser');
+
+// A TSCH integrity sample from device 07 taken at network time 900 ms, as a
+// border router uplink prints it with its hop trailer (received at 1000 ms)
+const LINE = 'I 0207000700070707 8843 b10107' + '1101' + '4a002a' + '8c00000384' + '9c000003e8';
+
+test('fills the mesh and uplink stages from a serial uplink', () => {
+  const { iid, port, payload } = parseIngestLine(LINE);
+  const [reading] = parseDatagram(payload, port).readings;
+  const histograms = new LatencyHistograms();
+
+  stampReading(reading, {
+    receivedMs: 50000, source: iidAddress(iid), network: 'serial:tcp://localhost:60001',
+    offsets: new ClockOffsets(), histograms,
+  });
+
+  assert.strictEqual(reading.sampled_ms, 49900);
+  assert.strictEqual(reading.hop_time_ms, undefined);
+  const counted = (stage) => histograms.stages.get(stage).reduce((a, b) => a + b, 0);
+  assert.strictEqual(counted('mesh'), 1);
+  assert.strictEqual(histograms.percentile('mesh', 50), 128); // 100 ms
+  assert.strictEqual(counted('uplink'), 1);
+});
+
+test('keeps the uptime clocks of nodes that share a device id apart', () => {
+  const offsets = new ClockOffsets();
+  const histograms = new LatencyHistograms();
+  const stamp = (source, nodeTimeMs) => stampReading({ device_id: '07', node_time_ms: nodeTimeMs },
+      { receivedMs: 10000, source, offsets, histograms }).sampled_ms;
+
+  assert.strictEqual(stamp('fd00::207:7:7:707', 5000), 10000);
+  assert.strictEqual(stamp('fd00::212:7412:12:1207', 1000), 10000);
+});
@@ -0,0 +1,36 @@
+'use strict';
+
+const assert = require('node:assert');
+const crypto = require('node:crypto');
+const test = require('node:test');
+const { leafHash, merkleRoot, merkleProof, verifyProof } = require('../merkle');
+const { rootFromProof } = require('../../../hyperledger/smart_contracts/common/lib/anchors');
+
+const lines = (count) => Array.from({ length: count }, (_, i) => JSON.stringify({ device_id: '0A', seq: i }));
+const sha256 = (...parts) => crypto.createHash('sha256').update(Buffer.concat(parts)).digest();
+
+test('promotes the odd last node instead of duplicating it', () => {
+  const leaves = lines(3).map(leafHash);
+  const left = sha256(Buffer.from([1]), leaves[0], leaves[1]);
+
+  assert.strictEqual(merkleRoot(leaves.slice(0, 1)), leaves[0].toString('hex'));
+  assert.strictEqual(merkleRoot(leaves), sha256(Buffer.from([1]), left, leaves[2]).toString('hex'));
+  assert.deepStrictEqual(merkleProof(leaves, 2), [{ position: 'left', hash: left.toString('hex') }]);
+  assert.throws(() => merkleRoot([]), /without leaves/);
+  assert.throws(() => merkleProof(leaves, 3), /outside a tree of 3/);
+});
+
+test('proves every leaf of odd and even trees, as the chaincodes check them', () => {
+  for (const count of [1, 2, 3, 5, 6, 7, 11]) {
+    const segment = lines(count);
+    const leaves = segment.map(leafHash);
+    const root = merkleRoot(leaves);
+
+    segment.forEach((line, index) => {
+      const proof = merkleProof(leaves, index);
+      assert.ok(verifyProof(line, proof, root), `leaf ${index} of ${count}`);
+      assert.strictEqual(rootFromProof(line, proof), root, `chaincode root for leaf ${index} of ${count}`);
+    });
+    assert.strictEqual(verifyProof(`${segment[0]} `, merkleProof(leaves, 0), root), false);
+  }
+});
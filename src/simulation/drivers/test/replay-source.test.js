@@ -0,0 +1,39 @@
+'use strict';
+
+const assert = require('node:assert');
+const fs = require('node:fs');
+const os = require('node:os');
+const path = require('node:path');
+const test = require('node:test');
+const { CaptureWriter, interfaceId } = require('../capture');
+const { ReplaySource } = require('../replay-source');
+
+const NODE_A = 'fd00::207:7:7:707';
+const NODE_B = 'fd00::212:7412:12:1207';
+const FRAME = Buffer.from('b10107' + '1101' + '4a002a', 'hex'); // integrity_flag 1, seq 42
+
+test('feeds every run of a capture from its recorded senders', async () => {
+  const file = path.join(fs.mkdtempSync(path.join(os.tmpdir(), 'replay-')), 'run.cap');
+  const writer = new CaptureWriter(file);
+  writer.record(FRAME, { address: NODE_A, port: 5555 }, 8843);
+  writer.record(FRAME, { address: NODE_B, port: 5555 }, 8843);
+  writer.close();
+
+  const fed = [];
+  await new Promise((resolve) => {
+    new ReplaySource(file, (message, remote, port, run) => {
+      fed.push({ message, remote, port, run });
+      if (fed.length === 4) {
+        resolve();
+      }
+    }, () => {}, { speed: 0, loops: 2 }).start();
+  });
+
+  assert.deepStrictEqual(fed.map(({ remote, run }) => [interfaceId(remote.address), remote.port, run]), [
+    [interfaceId(NODE_A), 5555, 1],
+    [interfaceId(NODE_B), 5555, 1],
+    [interfaceId(NODE_A), 5555, 2],
+    [interfaceId(NODE_B), 5555, 2],
+  ]);
+  assert.ok(fed.every(({ message, port }) => message.equals(FRAME) && port === 8843));
+});
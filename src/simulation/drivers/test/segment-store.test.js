@@ -0,0 +1,80 @@
+'use strict';
+
+const assert = require('node:assert');
+const fs = require('node:fs');
+const http = require('node:http');
+const os = require('node:os');
+const path = require('node:path');
+const test = require('node:test');
+const { SegmentStore } = require('../segment-store');
+const { leafHash, merkleRoot } = require('../merkle');
+
+const WINDOW_MS = 60000;
+const line = (seq) => JSON.stringify({ device_id: '0A', seq });
+
+// A gateway stand-in: POST /api/anchors answers with postStatus, GET returns anchoredRoot
+async function startGateway(postStatus, anchoredRoot) {
+  const posted = [];
+  const server = http.createServer((req, res) => {
+    let body = '';
+    req.on('data', (chunk) => (body += chunk));
+    req.on('end', () => {
+      if (req.method === 'POST') {
+        posted.push(JSON.parse(body));
+        res.writeHead(postStatus).end('{}');
+      } else {
+        res.writeHead(200).end(JSON.stringify({ data: { root: anchoredRoot } }));
+      }
+    });
+  });
+  await new Promise((resolve) => server.listen(0, '127.0.0.1', resolve));
+  return { server, posted, endpoint: `http://127.0.0.1:${server.address().port}/api/anchors` };
+}
+
+function createStore(endpoint) {
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'segments-'));
+  fs.mkdirSync(path.join(dir, 'integrity'));
+  const store = new SegmentStore({ dir, windowMs: WINDOW_MS, anchorEndpoint: endpoint, log: () => {} });
+  return { dir, store };
+}
+
+test('recovers torn segments: closes ended windows and reopens the current one', async () => {
+  const gateway = await startGateway(201);
+  const { dir, store } = createStore(gateway.endpoint);
+  const current = Math.floor(Date.now() / WINDOW_MS) * WINDOW_MS;
+  const ended = String(current - WINDOW_MS);
+  fs.writeFileSync(path.join(dir, 'integrity', `${ended}.jsonl`), `${line(1)}\n${line(2)}\n{"device_id":"0A","se`);
+  fs.writeFileSync(path.join(dir, 'integrity', `${current}.jsonl`), `${line(3)}\n{"dev`);
+
+  store.start();
+  const meta = JSON.parse(fs.readFileSync(path.join(dir, 'integrity', `${ended}.anchor.json`), 'utf8'));
+  assert.strictEqual(meta.count, 2);
+  assert.strictEqual(meta.root, merkleRoot([line(1), line(2)].map(leafHash)));
+  assert.strictEqual(store.readingProof('integrity', ended, 1).reading.seq, 2);
+
+  // The current window keeps appending after its last whole line, and shutdown does not close it
+  store.append('integrity', { device_id: '0A', seq: 4 });
+  await store.shutdown();
+  assert.strictEqual(fs.readFileSync(path.join(dir, 'integrity', `${current}.jsonl`), 'utf8'), `${line(3)}\n${line(4)}\n`);
+  assert.strictEqual(fs.existsSync(path.join(dir, 'integrity', `${current}.anchor.json`)), false);
+
+  await store.anchor(meta);
+  assert.deepStrictEqual(gateway.posted.map((anchor) => anchor.windowId), [ended]);
+  assert.strictEqual(store.stats().anchored, 1);
+  gateway.server.close();
+});
+
+test('takes a 409 as anchored only when the ledger holds the same root', async () => {
+  const leaves = [line(1)].map(leafHash);
+  for (const [anchoredRoot, anchored, conflicts] of [[merkleRoot(leaves), true, 0], ['ab'.repeat(32), false, 1]]) {
+    const gateway = await startGateway(409, anchoredRoot);
+    const { store } = createStore(gateway.endpoint);
+    const meta = store.buildMeta('integrity', '1700000000000', leaves);
+
+    await store.anchor(meta);
+    assert.strictEqual(meta.anchored, anchored);
+    assert.strictEqual(meta.conflictingRoot, anchored ? undefined : anchoredRoot);
+    assert.strictEqual(store.stats().anchorConflicts, conflicts);
+    gateway.server.close();
+  }
+});
@@ -0,0 +1,56 @@
+'use strict';
+
+const assert = require('node:assert');
+const net = require('node:net');
+const test = require('node:test');
+const { parseIngestLine, iidAddress, startSerialSources } = require('../serial-bridge');
+const { parseDatagram } = require('../ingest-parser');
+
+// An integrity reading as devices/border-router.c prints it: sensor 1 from
+// device 07, integrity_flag 1, seq 42, then the hop trailer (hop_time_ms 1000)
+const IID = '0207000700070707';
+const FRAME = 'b10107' + '1101' + '4a002a';
+const LINE = `I ${IID} 8843 ${FRAME}9c000003e8`;
+
+test('parses I lines and skips other uplink output', () => {
+  const parsed = parseIngestLine(`12:00:01.250 ${LINE}`);
+  assert.strictEqual(parsed.iid, IID);
+  assert.strictEqual(parsed.port, 8843);
+  assert.strictEqual(parsed.payload.toString('hex'), `${FRAME}9c000003e8`);
+
+  assert.strictEqual(parseIngestLine('S 0707 12 240 3 0 5'), null);
+  assert.strictEqual(parseIngestLine('[INFO: BR        ] Waiting for prefix'), null);
+});
+
+test('reports the sender by its link-local address', () => {
+  assert.strictEqual(iidAddress(IID), 'fe80::207:7:7:707');
+});
+
+test('delivers datagrams from a TCP uplink to the parser with the hop time', async () => {
+  const server = net.createServer((socket) => {
+    socket.end(`[INFO: BR        ] RPL Network formed successfully.\n${LINE}\nR 3\n`);
+  });
+  await new Promise((resolve) => server.listen(0, '127.0.0.1', resolve));
+
+  const received = [];
+  let sources;
+  await new Promise((resolve) => {
+    sources = startSerialSources(`tcp://127.0.0.1:${server.address().port}`, (message, remote, port, source) => {
+      received.push({ message, remote, port, source });
+      resolve();
+    }, () => {});
+  });
+  sources.forEach((source) => source.close());
+  server.close();
+
+  assert.strictEqual(received.length, 1);
+  assert.deepStrictEqual(received[0].remote, { address: 'fe80::207:7:7:707', port: 5555 });
+
+  const { readings, invalid } = parseDatagram(received[0].message, received[0].port);
+  assert.strictEqual(invalid, 0);
+  assert.strictEqual(readings.length, 1);
+  assert.strictEqual(readings[0].sensor, 'integrity');
+  assert.strictEqual(readings[0].integrity_flag, 1);
+  assert.strictEqual(readings[0].seq, 42);
+  assert.strictEqual(readings[0].hop_time_ms, 1000);
+});
@@ -0,0 +1,82 @@
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+/*
+ * Ingest capture file format, written by drivers/capture.js and read by
+ * tools/replay.c. Keep the two in sync.
+ *
+ * File header (16 bytes):
+ *   magic "IBCP", uint16 version, uint16 record header size, uint64 start (us)
+ * Each record (32-byte header, then the datagram):
+ *   uint64 time (us since the epoch), source address (16 bytes, IPv6 or
+ *   IPv4-mapped), uint16 source port, uint16 collector port, uint16 length,
+ *   uint16 reserved (0)
+ *
+ * All integers are little-endian. Records are appended in arrival order.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#define CAPTURE_MAGIC "IBCP"
+#define CAPTURE_VERSION 1
+#define CAPTURE_FILE_HEADER_LEN 16
+#define CAPTURE_RECORD_HEADER_LEN 32
+
+struct capture_record {
+    uint64_t time_us;
+    uint8_t src_addr[16];
+    uint16_t src_port;
+    uint16_t dst_port;
+    uint16_t len;
+    const uint8_t *data;        // Points into the mapped file
+};
+
+static inline uint16_t capture_get16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint64_t capture_get64(const uint8_t *p) {
+    uint64_t value = 0;
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+/* Check the file header. Returns 0 if buf does not start a version 1 capture. */
+static inline int capture_check_header(const uint8_t *buf, size_t size) {
+    return size >= CAPTURE_FILE_HEADER_LEN &&
+           memcmp(buf, CAPTURE_MAGIC, 4) == 0 &&
+           capture_get16(buf + 4) == CAPTURE_VERSION &&
+           capture_get16(buf + 6) == CAPTURE_RECORD_HEADER_LEN;
+}
+
+/*
+ * Decode the record at *offset and advance past it. Returns 0 at the end of
+ * the file or on a truncated record, e.g. the tail of a capture still being
+ * written.
+ */
+static inline int capture_next(const uint8_t *buf, size_t size, size_t *offset,
+                               struct capture_record *record) {
+    const uint8_t *p = buf + *offset;
+
+    if (*offset + CAPTURE_RECORD_HEADER_LEN > size) {
+        return 0;
+    }
+    record->time_us = capture_get64(p);
+    memcpy(record->src_addr, p + 8, 16);
+    record->src_port = capture_get16(p + 24);
+    record->dst_port = capture_get16(p + 26);
+    record->len = capture_get16(p + 28);
+    if (*offset + CAPTURE_RECORD_HEADER_LEN + record->len > size) {
+        return 0;
+    }
+    record->data = p + CAPTURE_RECORD_HEADER_LEN;
+    *offset += CAPTURE_RECORD_HEADER_LEN + record->len;
+    return 1;
+}
+
+#endif /* CAPTURE_H_ */
@@ -0,0 +1,252 @@
+/*
+ * UDP load generator for the ingest daemon (drivers/ingest-daemon.js).
+ *
+ * Sends the same payloads the sensor firmware does (binary telemetry frames,
+ * optionally batched, or the legacy ASCII text) to the collector ports
+ * 8843-8847 at a fixed total rate, spread over many virtual device IDs.
+ * Device IDs above 255 carry their high bits in TELEMETRY_FIELD_DEVICE_HI.
+ *
+ * Build:  cc -O2 -Wall -I../devices -o loadgen loadgen.c
+ * Usage:  ./loadgen [-h host] [-r packets/s] [-d seconds] [-n devices]
+ *                   [-b samples per frame] [-p port] [-a]
+ *
+ * Every virtual device keeps one role (device % 5) and its own sequence
+ * number, so drivers see the same mix a real deployment produces.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "telemetry.h"
+
+#define COLLECTOR_PORT_FIRST 8843
+#define ROLE_COUNT 5
+#define MAX_DEVICES 65536
+#define MAX_BATCH 8
+#define TICK_NS 1000000L            // Pacing granularity: 1 ms
+
+struct role {
+    const char *name;
+    uint8_t sensor_type;
+    uint16_t port;
+};
+
+/* Same ports as devices/sensor-providers.c */
+static const struct role roles[ROLE_COUNT] = {
+    { "integrity",    TELEMETRY_SENSOR_INTEGRITY,    8843 },
+    { "monitor",      TELEMETRY_SENSOR_MONITOR,      8844 },
+    { "availability", TELEMETRY_SENSOR_AVAILABILITY, 8845 },
+    { "network",      TELEMETRY_SENSOR_NETWORK,      8846 },
+    { "security",     TELEMETRY_SENSOR_SECURITY,     8847 },
+};
+
+struct options {
+    const char *host;
+    double rate;
+    double duration;
+    uint32_t devices;
+    uint8_t batch;
+    uint16_t port;                  // 0 sends each role to its own port
+    int ascii;
+};
+
+static uint16_t sequence[MAX_DEVICES];
+
+/*---------------------------------------------------------------------------*/
+/* Encode one reading of a role's fields, matching the firmware providers */
+static void put_reading(struct telemetry_frame *frame, const struct role *role, uint16_t seq) {
+    switch (role->sensor_type) {
+    case TELEMETRY_SENSOR_INTEGRITY:
+        telemetry_put(frame, TELEMETRY_FIELD_INTEGRITY_FLAG, rand() % 2);
+        break;
+    case TELEMETRY_SENSOR_MONITOR:
+        telemetry_put(frame, TELEMETRY_FIELD_LOG_ID, rand() % 100);
+        telemetry_put(frame, TELEMETRY_FIELD_STATUS, TELEMETRY_STATUS_OK);
+        break;
+    case TELEMETRY_SENSOR_AVAILABILITY:
+        telemetry_put(frame, TELEMETRY_FIELD_AVAILABILITY, rand() % 2);
+        break;
+    case TELEMETRY_SENSOR_NETWORK:
+        telemetry_put(frame, TELEMETRY_FIELD_LATENCY_MS, rand() % 100 + 10);
+        telemetry_put(frame, TELEMETRY_FIELD_PACKET_LOSS, rand() % 10);
+        break;
+    default:
+        telemetry_put(frame, TELEMETRY_FIELD_BREACH_FLAG, rand() % 2);
+        break;
+    }
+    telemetry_put(frame, TELEMETRY_FIELD_SEQ, seq);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Build one datagram for a device. Returns its length. */
+static size_t build_payload(uint8_t *buf, size_t size, uint32_t device, const struct options *opt) {
+    const struct role *role = &roles[device % ROLE_COUNT];
+    struct telemetry_frame frame, sample;
+    uint8_t i, *len_byte;
+
+    if (opt->ascii) {
+        char id[8];
+        snprintf(id, sizeof(id), device > 0xFF ? "%04X" : "%02X", device);
+        switch (role->sensor_type) {
+        case TELEMETRY_SENSOR_INTEGRITY:
+            return snprintf((char *)buf, size, "device_id:%s,integrity_flag:%d", id, rand() % 2);
+        case TELEMETRY_SENSOR_MONITOR:
+            return snprintf((char *)buf, size, "device_id:%s,log_id:%d,message:Monitor_OK", id, rand() % 100);
+        case TELEMETRY_SENSOR_AVAILABILITY:
+            return snprintf((char *)buf, size, "device_id:%s,availability:%d", id, rand() % 2);
+        case TELEMETRY_SENSOR_NETWORK:
+            return snprintf((char *)buf, size, "device_id:%s,latency:%dms,packet_loss:%d%%",
+                            id, rand() % 100 + 10, rand() % 10);
+        default:
+            return snprintf((char *)buf, size, "device_id:%s,breach_flag:%d", id, rand() % 2);
+        }
+    }
+
+    if (opt->batch <= 1) {
+        telemetry_begin(&frame, buf, size, role->sensor_type, device & 0xFF);
+        put_reading(&frame, role, sequence[device]++);
+        if (device > 0xFF) {
+            telemetry_put(&frame, TELEMETRY_FIELD_DEVICE_HI, device >> 8);
+        }
+        return frame.len;
+    }
+
+    /* Batch frame: count byte, then length-prefixed samples with their age */
+    telemetry_begin(&frame, buf, size, role->sensor_type | TELEMETRY_FLAG_BATCH, device & 0xFF);
+    buf[frame.len++] = opt->batch;
+    for (i = 0; i < opt->batch; i++) {
+        len_byte = &buf[frame.len++];
+        telemetry_begin_fields(&sample, &buf[frame.len], size - frame.len);
+        put_reading(&sample, role, sequence[device]++);
+        telemetry_put(&sample, TELEMETRY_FIELD_AGE_S, (opt->batch - 1 - i) * 10);
+        if (device > 0xFF) {
+            telemetry_put(&sample, TELEMETRY_FIELD_DEVICE_HI, device >> 8);
+        }
+        *len_byte = sample.len;
+        frame.len += sample.len;
+    }
+    return frame.len;
+}
+
+/*---------------------------------------------------------------------------*/
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "Usage: %s [-h host] [-r packets/s] [-d seconds] [-n devices] "
+                    "[-b samples per frame] [-p port] [-a]\n", argv0);
+    exit(2);
+}
+
+static void parse_options(int argc, char **argv, struct options *opt) {
+    int c;
+
+    opt->host = "aaaa::1";
+    opt->rate = 1000;
+    opt->duration = 10;
+    opt->devices = 1000;
+    opt->batch = 1;
+    opt->port = 0;
+    opt->ascii = 0;
+
+    while ((c = getopt(argc, argv, "h:r:d:n:b:p:a")) != -1) {
+        switch (c) {
+        case 'h': opt->host = optarg; break;
+        case 'r': opt->rate = atof(optarg); break;
+        case 'd': opt->duration = atof(optarg); break;
+        case 'n': opt->devices = (uint32_t)atol(optarg); break;
+        case 'b': opt->batch = (uint8_t)atoi(optarg); break;
+        case 'p': opt->port = (uint16_t)atoi(optarg); break;
+        case 'a': opt->ascii = 1; break;
+        default: usage(argv[0]);
+        }
+    }
+    if (opt->rate <= 0 || opt->duration <= 0 || opt->devices == 0 || opt->devices > MAX_DEVICES ||
+        opt->batch > MAX_BATCH) {
+        usage(argv[0]);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+int main(int argc, char **argv) {
+    struct options opt;
+    struct addrinfo hints, *targets[ROLE_COUNT];
+    uint8_t payload[TELEMETRY_MAX_FRAME * 2];
+    unsigned long sent = 0, failed = 0, bytes = 0;
+    double start, elapsed, next_report = 1;
+    uint32_t device = 0;
+    struct timespec tick = { 0, TICK_NS };
+    char port[8];
+    int sock, i, err;
+
+    parse_options(argc, argv, &opt);
+    srand(1);
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    for (i = 0; i < ROLE_COUNT; i++) {
+        snprintf(port, sizeof(port), "%u", opt.port ? opt.port : roles[i].port);
+        if ((err = getaddrinfo(opt.host, port, &hints, &targets[i])) != 0) {
+            fprintf(stderr, "Cannot resolve %s: %s\n", opt.host, gai_strerror(err));
+            return 1;
+        }
+    }
+    sock = socket(targets[0]->ai_family, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        perror("socket");
+        return 1;
+    }
+
+    printf("Sending %.0f pkt/s for %.0f s to %s from %u devices (%s, %u sample(s) per frame)\n",
+           opt.rate, opt.duration, opt.host, opt.devices, opt.ascii ? "ascii" : "binary",
+           opt.batch ? opt.batch : 1);
+
+    start = now_s();
+    while ((elapsed = now_s() - start) < opt.duration) {
+        /* Catch up to the schedule, then sleep one tick */
+        while (sent + failed < (unsigned long)(elapsed * opt.rate)) {
+            const struct addrinfo *to = targets[device % ROLE_COUNT];
+            size_t len = build_payload(payload, sizeof(payload), device, &opt);
+
+            if (sendto(sock, payload, len, 0, to->ai_addr, to->ai_addrlen) < 0) {
+                if (errno != ENOBUFS && errno != EAGAIN) {
+                    perror("sendto");
+                    return 1;
+                }
+                failed++;
+            } else {
+                sent++;
+                bytes += len;
+            }
+            device = (device + 1) % opt.devices;
+        }
+
+        if (elapsed >= next_report) {
+            printf("%6.1f s  sent %lu  (%.0f pkt/s)  send failures %lu\n",
+                   elapsed, sent, sent / elapsed, failed);
+            next_report += 1;
+        }
+        nanosleep(&tick, NULL);
+    }
+
+    elapsed = now_s() - start;
+    printf("Done: %lu datagrams, %lu bytes in %.2f s (%.0f pkt/s), %lu send failures\n",
+           sent, bytes, elapsed, sent / elapsed, failed);
+
+    for (i = 0; i < ROLE_COUNT; i++) {
+        freeaddrinfo(targets[i]);
+    }
+    close(sock);
+    return 0;
+}
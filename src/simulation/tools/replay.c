@@ -0,0 +1,243 @@
+/*
+ * Replays an ingest capture (drivers/capture.js, INGEST_CAPTURE_FILE) into
+ * the ingest daemon, so a load scenario recorded once from Cooja can be rerun
+ * against the drivers and the Fabric path without the simulator.
+ *
+ * The capture is memory-mapped and read in place. Each datagram is sent to
+ * the collector port it was captured on, either keeping the original timing
+ * scaled by -s (1 = real time, 10 = ten times faster) or, with -s 0, as fast
+ * as the socket accepts.
+ *
+ * Datagrams come from this host, not the captured source addresses. The
+ * drivers key senders by the source's interface identifier, so authenticated
+ * frames fail their MIC check, and a capture is sent only once: a second pass
+ * would repeat its seq values and be dropped as copies. To replay from the
+ * recorded senders, or several times over, use the daemon's INGEST_REPLAY
+ * input (drivers/replay-source.js); this tool exercises the UDP path.
+ *
+ * Build:  cc -O2 -Wall -I../devices -o replay replay.c
+ * Usage:  ./replay [-h host] [-s speed] [-p port] [-i] capture.bin
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "capture.h"
+
+#define MIN_SLEEP_NS 200000L        // Gaps shorter than this are sent back to back
+#define PORT_SLOTS 65536
+
+struct options {
+    const char *host;
+    const char *path;
+    double speed;                   // 0 sends as fast as possible
+    uint16_t port;                  // 0 keeps each record's collector port
+    int info;
+};
+
+/*---------------------------------------------------------------------------*/
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Sleep until a point on the monotonic clock, given in seconds */
+static void sleep_until(double when) {
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)when;
+    ts.tv_nsec = (long)((when - ts.tv_sec) * 1e9);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+static void set_port(struct sockaddr_storage *addr, uint16_t port) {
+    if (addr->ss_family == AF_INET6) {
+        ((struct sockaddr_in6 *)addr)->sin6_port = htons(port);
+    } else {
+        ((struct sockaddr_in *)addr)->sin_port = htons(port);
+    }
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "Usage: %s [-h host] [-s speed, 0 = as fast as possible] [-p port] "
+                    "[-i] capture.bin\n", argv0);
+    exit(2);
+}
+
+static void parse_options(int argc, char **argv, struct options *opt) {
+    int c;
+
+    opt->host = "aaaa::1";
+    opt->speed = 1;
+    opt->port = 0;
+    opt->info = 0;
+
+    while ((c = getopt(argc, argv, "h:s:p:i")) != -1) {
+        switch (c) {
+        case 'h': opt->host = optarg; break;
+        case 's': opt->speed = atof(optarg); break;
+        case 'p': opt->port = (uint16_t)atoi(optarg); break;
+        case 'i': opt->info = 1; break;
+        default: usage(argv[0]);
+        }
+    }
+    if (optind != argc - 1 || opt->speed < 0) {
+        usage(argv[0]);
+    }
+    opt->path = argv[optind];
+}
+
+/*---------------------------------------------------------------------------*/
+/* Print what a capture holds: records, bytes, time span and per-port counts */
+static int print_info(const uint8_t *buf, size_t size) {
+    static unsigned long per_port[PORT_SLOTS];
+    struct capture_record record;
+    size_t offset = CAPTURE_FILE_HEADER_LEN;
+    unsigned long records = 0, bytes = 0;
+    uint64_t first = 0, last = 0;
+    unsigned port;
+
+    while (capture_next(buf, size, &offset, &record)) {
+        if (records++ == 0) {
+            first = record.time_us;
+        }
+        last = record.time_us;
+        bytes += record.len;
+        per_port[record.dst_port]++;
+    }
+
+    printf("%lu datagrams, %lu payload bytes over %.3f s", records, bytes, (last - first) / 1e6);
+    if (offset < size) {
+        printf(", %zu trailing bytes ignored", size - offset);
+    }
+    printf("\n");
+    for (port = 0; port < PORT_SLOTS; port++) {
+        if (per_port[port] > 0) {
+            printf("  port %u: %lu\n", port, per_port[port]);
+        }
+    }
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+int main(int argc, char **argv) {
+    struct options opt;
+    struct addrinfo hints, *target;
+    struct sockaddr_storage to;
+    socklen_t to_len;
+    struct capture_record record;
+    struct stat st;
+    const uint8_t *buf;
+    unsigned long sent = 0, failed = 0, bytes = 0;
+    double start, elapsed, next_report = 1;
+    uint64_t first_us = 0;
+    size_t offset;
+    int fd, sock, err;
+
+    parse_options(argc, argv, &opt);
+
+    fd = open(opt.path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        perror(opt.path);
+        return 1;
+    }
+    if (st.st_size == 0) {
+        fprintf(stderr, "%s is empty\n", opt.path);
+        return 1;
+    }
+    buf = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (buf == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    madvise((void *)buf, st.st_size, MADV_SEQUENTIAL);
+
+    if (!capture_check_header(buf, st.st_size)) {
+        fprintf(stderr, "%s is not a version %d ingest capture\n", opt.path, CAPTURE_VERSION);
+        return 1;
+    }
+    if (opt.info) {
+        return print_info(buf, st.st_size);
+    }
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    if ((err = getaddrinfo(opt.host, NULL, &hints, &target)) != 0) {
+        fprintf(stderr, "Cannot resolve %s: %s\n", opt.host, gai_strerror(err));
+        return 1;
+    }
+    memcpy(&to, target->ai_addr, target->ai_addrlen);
+    to_len = target->ai_addrlen;
+    sock = socket(target->ai_family, SOCK_DGRAM, 0);
+    freeaddrinfo(target);
+    if (sock < 0) {
+        perror("socket");
+        return 1;
+    }
+
+    if (opt.speed > 0) {
+        printf("Replaying %s to %s at %gx\n", opt.path, opt.host, opt.speed);
+    } else {
+        printf("Replaying %s to %s as fast as possible\n", opt.path, opt.host);
+    }
+
+    /* Replay times are relative to the first record */
+    offset = CAPTURE_FILE_HEADER_LEN;
+    if (capture_next(buf, st.st_size, &offset, &record)) {
+        first_us = record.time_us;
+    }
+
+    start = now_s();
+    offset = CAPTURE_FILE_HEADER_LEN;
+    while (capture_next(buf, st.st_size, &offset, &record)) {
+        /* Keep the captured spacing, scaled; short gaps are not slept */
+        if (opt.speed > 0) {
+            double due = start + (record.time_us - first_us) / 1e6 / opt.speed;
+            if (due - now_s() > MIN_SLEEP_NS / 1e9) {
+                sleep_until(due);
+            }
+        }
+
+        set_port(&to, opt.port ? opt.port : record.dst_port);
+        if (sendto(sock, record.data, record.len, 0, (struct sockaddr *)&to, to_len) < 0) {
+            if (errno != ENOBUFS && errno != EAGAIN) {
+                perror("sendto");
+                return 1;
+            }
+            failed++;
+        } else {
+            sent++;
+            bytes += record.len;
+        }
+
+        if ((elapsed = now_s() - start) >= next_report) {
+            printf("%6.1f s  sent %lu  (%.0f pkt/s)  send failures %lu\n",
+                   elapsed, sent, sent / elapsed, failed);
+            next_report = elapsed + 1;
+        }
+    }
+
+    elapsed = now_s() - start;
+    printf("Done: %lu datagrams, %lu bytes in %.2f s (%.0f pkt/s), %lu send failures\n",
+           sent, bytes, elapsed, elapsed > 0 ? sent / elapsed : 0, failed);
+
+    munmap((void *)buf, st.st_size);
+    close(fd);
+    close(sock);
+    return 0;
+}